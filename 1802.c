@@ -2,6 +2,7 @@
  *	1802 CPU emulation. Loosely based upon 1802UNO
  */
 
+#include <limits.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -159,11 +160,13 @@ static void counter_cycle(struct cp1802 *cpu)
 			return;
 		}
 		/* High to low - so we count */
+		cpu->oldef = d;
 		break;
 	case 3:	/* STM */
 		cpu->ct_step++;
 		if (cpu->ct_step != 32)
 			return;
+		cpu->ct_step = 0;
 	}
 	if (cpu->ct_stop)
 		return;
@@ -171,13 +174,68 @@ static void counter_cycle(struct cp1802 *cpu)
 	counter_decrement(cpu);
 }
 
-static void execute_1805(struct cp1802 *cpu)
+/*
+ *	How many machine cycles until the counter next reaches zero. The
+ *	EF driven modes have to look at the flags every cycle.
+ */
+static unsigned int counter_due(struct cp1802 *cpu)
+{
+	unsigned int val = cpu->ct_val ? cpu->ct_val : 256;
+
+	if (cpu->ct_stop)
+		return UINT_MAX;
+	switch(cpu->ct_mode) {
+	case 0:
+		return val;
+	case 3:
+		return 32 - cpu->ct_step + (val - 1) * 32;
+	}
+	return 1;
+}
+
+/* Run n cycles that we know do not reach zero */
+static void counter_skip(struct cp1802 *cpu, unsigned int n)
+{
+	if (cpu->ct_stop)
+		return;
+	if (cpu->ct_mode == 3) {
+		n += cpu->ct_step;
+		cpu->ct_step = n % 32;
+		n /= 32;
+	}
+	cpu->ct_val -= n;
+}
+
+/* Run the counter for n machine cycles */
+static void counter_run(struct cp1802 *cpu, unsigned int n)
+{
+	unsigned int d;
+
+	while (n) {
+		d = counter_due(cpu);
+		if (d > n) {
+			counter_skip(cpu, n);
+			return;
+		}
+		counter_skip(cpu, d - 1);
+		counter_cycle(cpu);
+		n -= d;
+	}
+}
+
+/* The 1804 has the 1802 instructions and adds an extended set of
+   instructions prefixed with 68. These fix some of the big gaps in the
+   1802 for register loading/saving, call/return etc and also add some
+   directly instruction interfaced counter controls. The 1805 counter
+   instructions behave slightly differently */
+static void execute_ext(struct cp1802 *cpu)
 {
 	uint8_t opcode = cp1802_read(cpu, cpu->r[cpu->p]++);
 	uint8_t reg = opcode & 0x0F;
+	unsigned int is1805 = cpu->type >= 1805;
 	uint16_t tmp;
 
-	cpu->mcycles ++;
+	cpu->mcycles++;
 
 	switch(opcode & 0xF0) {
 	case 0:		/* Counter */
@@ -185,11 +243,15 @@ static void execute_1805(struct cp1802 *cpu)
 		case 0:	/* STPC */
 			cpu->ct_mode = 0;
 			cpu->ct_stop = 1;
-			cpu->ct_step = 0;
+			if (is1805)
+				cpu->ct_step = 0;
 			cpu->ct_etq = 0;
 			break;
 		case 1:	/* DTC */
-			counter_decrement(cpu);
+			if (is1805)
+				counter_decrement(cpu);
+			else
+				counter_cycle(cpu);
 			break;
 		case 2:	/* SPM2 */
 		case 3:	/* SCM2 */
@@ -200,12 +262,22 @@ static void execute_1805(struct cp1802 *cpu)
 			cpu->ct_stop = 0;
 			break;
 		case 6:	/* LDC */
-			cpu->ct_count = cpu->d;
+			if (is1805) {
+				cpu->ct_count = cpu->d;
+				if (cpu->ct_stop) {
+					cpu->ct_val = cpu->d;
+					cpu->ct_int = 0;
+					cpu->ct_etq = 0;
+				}
+				break;
+			}
+			/* Double check what happens if running when we do this ? */
 			if (cpu->ct_stop) {
+				cpu->ct_count = cpu->d;
 				cpu->ct_val = cpu->d;
-				cpu->ct_int = 0;
-				cpu->ct_etq = 0;
 			}
+			cpu->ct_int = 0;
+			cpu->ct_mode = 0;
 			break;
 		case 7:	/* STM */
 			cpu->ct_mode = 3;
@@ -228,6 +300,8 @@ static void execute_1805(struct cp1802 *cpu)
 		}
 		break;
 	case 0x20: 	/* DBNZ */
+		if (!is1805)
+			break;
 		tmp = cp1802_read16(cpu, cpu->r[cpu->p]);
 		if (--cpu->r[reg])
 			cpu->r[cpu->p] += 2;
@@ -263,6 +337,8 @@ static void execute_1805(struct cp1802 *cpu)
 		cpu->mcycles += 2;
 		break;
 	case 0x70:	/* Decimal arithmetic with carry */
+		if (!is1805)
+			break;
 		cpu->mcycles++;
 		switch(reg) {
 		case 4:	/* DADC */
@@ -316,9 +392,11 @@ static void execute_1805(struct cp1802 *cpu)
 		tmp = cp1802_read16(cpu, cpu->r[cpu->p]);
 		cpu->r[cpu->p] += 2;
 		cpu->r[reg] = tmp;
-		cpu->mcycles += 2;
+		cpu->mcycles += 1 + is1805;
 		break;
 	case 0xF0:	/* Decimal arithmetic without carry */
+		if (!is1805)
+			break;
 		cpu->mcycles++;
 		switch(reg) {
 		case 4:	/* DADD */
@@ -342,129 +420,8 @@ static void execute_1805(struct cp1802 *cpu)
 	}
 }
 
-
-/* The 1804 has the 1802 instructions and adds an extended set of
-   instructions prefixed with 68. These fix some of the big gaps in the
-   1802 for register loading/saving, call/return etc and also add some
-   directly instruction interfaced counter controls */
-static void execute_1804(struct cp1802 *cpu)
-{
-	uint8_t opcode = cp1802_read(cpu, cpu->r[cpu->p]++);
-	uint8_t reg = opcode & 0x0F;
-	uint16_t tmp;
-
-
-	cpu->mcycles++;
-
-	switch(opcode & 0xF0) {
-	case 0:		/* Counter */
-		switch(reg) {
-		case 0:	/* STPC */
-			cpu->ct_mode = 0;
-			cpu->ct_stop = 1;
-			cpu->ct_etq = 0;
-			break;
-		case 1:	/* DTC */
-			counter_cycle(cpu);
-			break;
-		case 2:	/* SPM2 */
-		case 3:	/* SCM2 */
-		case 4: /* SPM1 */
-		case 5:	/* SCM1 */
-			cpu->ct_mode = 1 + (reg & 1);
-			cpu->ct_ef = (reg & 2) >> 1;
-			cpu->ct_stop = 0;
-			break;
-		case 6:	/* LDC */
-			/* Double check what happens if running when we do this ? */
-			if (cpu->ct_stop) {
-				cpu->ct_count = cpu->d;
-				cpu->ct_val = cpu->d;
-			}
-			cpu->ct_int = 0;
-			cpu->ct_mode = 0;
-			break;
-		case 7:	/* STM */
-			cpu->ct_mode = 3;
-			cpu->ct_stop = 0;
-			break;
-		case 8: /* GEC */
-			cpu->d = cpu->ct_val;
-			break;
-		case 9:	/* ETQ */
-			cpu->ct_etq = 1;
-			break;
-		case 10: /* XIE */
-		case 11: /* XID */
-			cpu->xie = !(reg & 1);
-			break;
-		case 12: /* CIE */
-		case 13: /* CID */
-			cpu->cie = !(reg & 1);
-			break;
-		}
-		break;
-	case 0x30:	/* BCI and BXI */
-		tmp = cp1802_read(cpu, cpu->r[cpu->p]);
-		switch(reg) {
-		case 14: /* BCI */
-			if (cpu->ct_int) {
-				cpu->r[cpu->p] &= 0xFF00;
-				cpu->r[cpu->p] |= tmp;
-				cpu->ct_int = 0;
-				cpu->ct_etq = 0;
-			} else {
-				cpu->r[cpu->p]++;
-			}
-			break;
-		case 15: /* BXI */
-			if (cpu->ipend) {
-				cpu->r[cpu->p] &= 0xFF00;
-				cpu->r[cpu->p] |= tmp;
-			} else {
-				cpu->r[cpu->p]++;
-			}
-			break;
-		}
-		break;
-	case 0x60:	/* RLXA */
-		cpu->r[reg] = cp1802_read16(cpu, cpu->r[cpu->x]);
-		cpu->r[cpu->x] += 2;
-		cpu->mcycles += 2;
-		break;
-	case 0x80:	/* SCAL */
-		cp1802_write16(cpu, cpu->r[cpu->x], cpu->r[reg]);
-		cpu->r[reg] = cpu->r[cpu->p];
-		cpu->r[cpu->p] = cp1802_read16(cpu, cpu->r[cpu->p]);
-		cpu->mcycles += 7;
-		/* FIXME: what does T end up holding */
-		break;
-	case 0x90:	/* SRET */
-		cpu->r[cpu->p] = cpu->r[reg];
-		cpu->r[cpu->x] += 2;
-		tmp = cp1802_read16(cpu, cpu->r[cpu->x]);
-		cpu->r[reg] = tmp;
-		cpu->mcycles += 5;
-		break;
-	case 0xA0:	/* RSXD */
-		cp1802_write16(cpu, cpu->r[cpu->x], cpu->r[reg]);
-		cpu->r[cpu->x] += 2;
-		cpu->mcycles += 2;
-		break;
-	case 0xB0:	/* RNX */
-		cpu->r[cpu->x] = cpu->r[reg];
-		cpu->mcycles++;
-		break;
-	case 0xC0:	/* RLDI */
-		tmp = cp1802_read16(cpu, cpu->r[cpu->p]);
-		cpu->r[cpu->p] += 2;
-		cpu->r[reg] = tmp;
-		cpu->mcycles++;
-		break;
-	}
-}
-
-static void execute_op(struct cp1802 *cpu)
+/* Returns 1 if we are sat in IDL waiting for something to happen */
+static int execute_op(struct cp1802 *cpu)
 {
 	uint8_t opcode = cp1802_read(cpu, cpu->r[cpu->p]++);
 	uint8_t reg = opcode & 0x0F;
@@ -479,8 +436,10 @@ static void execute_op(struct cp1802 *cpu)
 			cpu->d = cp1802_read(cpu, cpu->r[reg]);
 		else {
 			/* idle until interrupt or dma */
-			if (!cpu->event)
+			if (!cpu->event) {
 				cpu->r[cpu->p]--;
+				return 1;
+			}
 			cpu->event = 0;
 		}
 		break;
@@ -509,15 +468,9 @@ static void execute_op(struct cp1802 *cpu)
 		break;
 	case 6:	/* INP/OUP/IRX */
 		/* 68 is a prefix on later processors for extended instructions */
-		if (reg == 8) {
-			if (cpu->type == 1804) {
-				execute_1804(cpu);
-				return;
-			}
-			if (cpu->type >= 1805) {
-				execute_1805(cpu);
-				return;
-			}
+		if (reg == 8 && cpu->type >= 1804) {
+			execute_ext(cpu);
+			return 0;
 		}
 		/* I/O is a bit weird */
 		if (reg < 8)
@@ -706,6 +659,7 @@ static void execute_op(struct cp1802 *cpu)
 			break;
 		}
 	}
+	return 0;
 }
 
 /* FIXME: need to account this in clocks we return used */
@@ -737,28 +691,63 @@ void cp1802_interrupt(struct cp1802 *cpu, int irq)
 	cpu->ipend = irq;
 }
 
-/* Run an instruction */
-int cp1802_run(struct cp1802 *cpu)
+/* Take an interrupt if one is pending. Counter first */
+static void check_interrupt(struct cp1802 *cpu)
 {
-	unsigned int elapsed = cpu->mcycles;
 	if (cpu->ie && cpu->cie && cpu->ct_int)
 		interrupt(cpu);
 	else if (cpu->ie && cpu->xie && cpu->ipend)
 		interrupt(cpu);
+}
+
+/* Run an instruction */
+int cp1802_run(struct cp1802 *cpu)
+{
+	unsigned int elapsed = cpu->mcycles;
+	check_interrupt(cpu);
 	execute_op(cpu);
 	/* Simulate the counter on the 1804/5/6 */
-	if (cpu->type >= 1804) {
-		elapsed = cpu->mcycles - elapsed;
-		while(elapsed--) {
-			counter_cycle(cpu);
+	if (cpu->type >= 1804)
+		counter_run(cpu, cpu->mcycles - elapsed);
+	return cpu->mcycles;
+}
+
+/*
+ *	Run instructions until at least budget machine cycles have passed
+ *	and return how many we used. The counter is only stepped by hand
+ *	when it is about to reach zero. An IDL with nothing that can wake it
+ *	skips straight to the end of the budget or the counter reaching zero.
+ */
+unsigned int cp1802_execute(struct cp1802 *cpu, unsigned int budget)
+{
+	unsigned int start = cpu->mcycles;
+	unsigned int elapsed;
+	unsigned int n, d;
+
+	while (cpu->mcycles - start < budget) {
+		elapsed = cpu->mcycles;
+		check_interrupt(cpu);
+		if (execute_op(cpu)) {
+			/* Each pass round IDL is two cycles */
+			n = budget - (elapsed - start);
+			if (cpu->type >= 1804) {
+				d = counter_due(cpu);
+				if (d < n)
+					n = d;
+			}
+			cpu->mcycles = elapsed + ((n + 1) & ~1U);
 		}
+		if (cpu->type >= 1804)
+			counter_run(cpu, cpu->mcycles - elapsed);
 	}
-	return cpu->mcycles;
+	return cpu->mcycles - start;
 }
 
 void cp1802_reset(struct cp1802 *cpu)
 {
+	uint16_t type = cpu->type;
 	memset(cpu, 0, sizeof(*cpu));
+	cpu->type = type;
 	cpu->t = (cpu->x <<4) | (cpu->p);
 	cpu->x = 0;
 	cpu->p = 0;
@@ -3627,27 +3627,32 @@ void m6800_raise_interrupt(struct m6800 *cpu, int irq)
 }
 
 /*
- *	Execute a machine cycle and return how many clocks
- *	we took doing it.
+ *	Run one instruction (or one cycle of waiting) with interrupt
+ *	processing but no timer work.
  */
-int m6800_execute(struct m6800 *cpu)
+static inline int m6800_step(struct m6800 *cpu)
 {
-	int cycles;
-	uint32_t n;
+	int cycles = 0;
 	/* Interrupts ? */
-	cycles = m6800_pre_execute(cpu);
+	if (cpu->irq)
+		cycles = m6800_pre_execute(cpu);
 	/* A cycle passes but we are waiting */
 	if (cpu->wait)
-		cycles = 1;
-	else
-		cycles += m6800_execute_one(cpu);
+		return 1;
+	return cycles + m6800_execute_one(cpu);
+}
 
-	/* FIXME: skip the unneeded stuff on 6800/6808 */
+/*
+ *	The 6803 free running counter. Work out if we passed the output
+ *	compare or wrapped, and how many clocks we can then run before
+ *	either can happen again.
+ */
+static void m6800_counter(struct m6800 *cpu, unsigned int cycles)
+{
+	uint32_t n = cpu->counter + cycles;
 
-	/* See if we passed the output compare, and as we don't check every
-	   cycle deal with wraps */
-	n = cpu->counter + cycles;
-	if (cpu->oc_hold == 0 && cpu->counter >= cpu->ocr && cpu->counter < n) {
+	/* As we don't check every cycle deal with wraps */
+	if (cpu->oc_hold == 0 && (uint16_t)(cpu->ocr - cpu->counter) < cycles) {
 		cpu->tcsr |= TCSR_OCF;	/* OCF */
 		if (cpu->tcsr & TCSR_EOCI)
 			m6800_raise_interrupt(cpu, IRQ_OCF);
@@ -3660,6 +3665,55 @@ int m6800_execute(struct m6800 *cpu)
 			m6800_raise_interrupt(cpu, IRQ_TOF);
 	}
 	cpu->counter = (uint16_t)n;
+
+	cpu->timer_left = (uint16_t)(cpu->ocr - cpu->counter);
+	if (cpu->timer_left > 0xFFFFU - cpu->counter)
+		cpu->timer_left = 0xFFFFU - cpu->counter;
+}
+
+static inline void m6800_timer(struct m6800 *cpu, unsigned int cycles)
+{
+	if (cycles > cpu->timer_left)
+		m6800_counter(cpu, cycles);
+	else {
+		cpu->timer_left -= cycles;
+		cpu->counter += cycles;
+	}
+}
+
+/*
+ *	Execute a machine cycle and return how many clocks
+ *	we took doing it.
+ */
+int m6800_execute(struct m6800 *cpu)
+{
+	int cycles = m6800_step(cpu);
+	/* Only the 6801/6803/6303 have the timer */
+	if (cpu->intio == INTIO_6803)
+		m6800_timer(cpu, cycles);
+	return cycles;
+}
+
+/*
+ *	Execute instructions until at least budget clocks have passed and
+ *	return how many we took. The timer is only looked at properly when
+ *	the output compare or overflow is due.
+ */
+int m6800_run(struct m6800 *cpu, int budget)
+{
+	int cycles = 0;
+	int n;
+
+	if (cpu->intio != INTIO_6803) {
+		while (cycles < budget)
+			cycles += m6800_step(cpu);
+		return cycles;
+	}
+	while (cycles < budget) {
+		n = m6800_step(cpu);
+		m6800_timer(cpu, n);
+		cycles += n;
+	}
 	return cycles;
 }
 
@@ -3701,6 +3755,63 @@ static int prescaler(struct prescaler *p)
 	return 0;
 }
 
+/*
+ *	Turn the timer flags into IRQ bits. This is done whenever the flags
+ *	or masks change.
+ */
+static void m68hc11_timer_ints(struct m6800 *cpu)
+{
+	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x80)
+		m6800_raise_interrupt(cpu, IRQ_OC1);
+	else
+		m6800_clear_interrupt(cpu, IRQ_OC1);
+	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x40)
+		m6800_raise_interrupt(cpu, IRQ_OC2);
+	else
+		m6800_clear_interrupt(cpu, IRQ_OC2);
+	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x20)
+		m6800_raise_interrupt(cpu, IRQ_OC3);
+	else
+		m6800_clear_interrupt(cpu, IRQ_OC3);
+	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x10)
+		m6800_raise_interrupt(cpu, IRQ_OC4);
+	else
+		m6800_clear_interrupt(cpu, IRQ_OC4);
+	/* This one is special - its OC5 or IC4  */
+	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x08)
+		m6800_raise_interrupt(cpu, IRQ_IC4OC5);
+	else
+		m6800_clear_interrupt(cpu, IRQ_IC4OC5);
+	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x04)
+		m6800_raise_interrupt(cpu, IRQ_IC1);
+	else
+		m6800_clear_interrupt(cpu, IRQ_IC1);
+	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x02)
+		m6800_raise_interrupt(cpu, IRQ_IC2);
+	else
+		m6800_clear_interrupt(cpu, IRQ_IC2);
+	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x01)
+		m6800_raise_interrupt(cpu, IRQ_IC3);
+	else
+		m6800_clear_interrupt(cpu, IRQ_IC3);
+	if ((cpu->io.tflg2 & cpu->io.tmsk2) & 0x80)
+		m6800_raise_interrupt(cpu, IRQ_TOF);
+	else
+		m6800_clear_interrupt(cpu, IRQ_TOF);
+	if ((cpu->io.tflg2 & cpu->io.tmsk2) & 0x40)
+		m6800_raise_interrupt(cpu, IRQ_RTI);
+	else
+		m6800_clear_interrupt(cpu, IRQ_RTI);
+	if ((cpu->io.tflg2 & cpu->io.tmsk2) & 0x20)
+		m6800_raise_interrupt(cpu, IRQ_PAOV);
+	else
+		m6800_clear_interrupt(cpu, IRQ_PAOV);
+	if ((cpu->io.tflg2 & cpu->io.tmsk2) & 0x10)
+		m6800_raise_interrupt(cpu, IRQ_PAI);
+	else
+		m6800_clear_interrupt(cpu, IRQ_PAI);
+}
+
 static void m68hc11_e_clock(struct m6800 *cpu)
 {
 	/* Our emulation timer for an SPI transfer. This counts down E clocks
@@ -3725,6 +3836,7 @@ static void m68hc11_e_clock(struct m6800 *cpu)
 		/* 1 2 4 or 8 fom RTR[1:0] */
 		if (prescaler(&cpu->io.rti)) {
 			cpu->io.tflg2 |= TF2_RTIF;
+			m68hc11_timer_ints(cpu);
 		}
 		/* Always by 4 then by 1/4/16/64 ccording to CR[1:0] */
 		if (prescaler(&cpu->io.cop)) {
@@ -3758,69 +3870,115 @@ static void m68hc11_e_clock(struct m6800 *cpu)
 	   here */
 
 	/* Turn compare flags into IRQ bits */
-	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x80)
-		m6800_raise_interrupt(cpu, IRQ_OC1);
-	else
-		m6800_clear_interrupt(cpu, IRQ_OC1);
-	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x40)
-		m6800_raise_interrupt(cpu, IRQ_OC2);
-	else
-		m6800_clear_interrupt(cpu, IRQ_OC2);
-	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x20)
-		m6800_raise_interrupt(cpu, IRQ_OC3);
-	else
-		m6800_clear_interrupt(cpu, IRQ_OC3);
-	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x10)
-		m6800_raise_interrupt(cpu, IRQ_OC4);
-	else
-		m6800_clear_interrupt(cpu, IRQ_OC4);
-	/* This one is special - its OC5 or IC4  */
-	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x08)
-		m6800_raise_interrupt(cpu, IRQ_IC4OC5);
-	else
-		m6800_clear_interrupt(cpu, IRQ_IC4OC5);
-	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x04)
-		m6800_raise_interrupt(cpu, IRQ_IC1);
-	else
-		m6800_clear_interrupt(cpu, IRQ_IC1);
-	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x02)
-		m6800_raise_interrupt(cpu, IRQ_IC2);
-	else
-		m6800_clear_interrupt(cpu, IRQ_IC2);
-	if ((cpu->io.tflg1 & cpu->io.tmsk1) & 0x01)
-		m6800_raise_interrupt(cpu, IRQ_IC3);
-	else
-		m6800_clear_interrupt(cpu, IRQ_IC3);
-	if ((cpu->io.tflg2 & cpu->io.tmsk2) & 0x80)
-		m6800_raise_interrupt(cpu, IRQ_TOF);
-	else
-		m6800_clear_interrupt(cpu, IRQ_TOF);
-	if ((cpu->io.tflg2 & cpu->io.tmsk2) & 0x40)
-		m6800_raise_interrupt(cpu, IRQ_RTI);
-	else
-		m6800_clear_interrupt(cpu, IRQ_RTI);
-	if ((cpu->io.tflg2 & cpu->io.tmsk2) & 0x20)
-		m6800_raise_interrupt(cpu, IRQ_PAOV);
-	else
-		m6800_clear_interrupt(cpu, IRQ_PAOV);
-	if ((cpu->io.tflg2 & cpu->io.tmsk2) & 0x10)
-		m6800_raise_interrupt(cpu, IRQ_PAI);
-	else
-		m6800_clear_interrupt(cpu, IRQ_PAI);
+	m68hc11_timer_ints(cpu);
 }
 
+/*
+ *	Most E clocks just count. Work out how many clocks until one that
+ *	does something more interesting: an SPI transfer completes, the
+ *	2^13 divider rolls over or tcnt reaches an output compare or wraps.
+ */
+
+static unsigned int prescaler_due(struct prescaler *p)
+{
+	if (p->count >= p->limit)
+		return 1;
+	return p->limit - p->count + 1;
+}
+
+static unsigned int tcnt_match(uint16_t tcnt, uint16_t toc)
+{
+	uint16_t n = toc - tcnt;
+	return n ? n : 0x10000;
+}
+
+static unsigned int m68hc11_e_due(struct m6800 *cpu)
+{
+	struct m68hc11 *io = &cpu->io;
+	unsigned int d, n;
+
+	/* tcnt steps until something matches */
+	n = tcnt_match(io->tcnt, 0);
+	d = tcnt_match(io->tcnt, io->toc1);
+	if (d < n)
+		n = d;
+	d = tcnt_match(io->tcnt, io->toc2);
+	if (d < n)
+		n = d;
+	d = tcnt_match(io->tcnt, io->toc3);
+	if (d < n)
+		n = d;
+	d = tcnt_match(io->tcnt, io->toc4);
+	if (d < n)
+		n = d;
+	d = tcnt_match(io->tcnt, io->toc5);
+	if (d < n)
+		n = d;
+	/* and in E clocks */
+	d = prescaler_due(&io->pr_tcnt) + (n - 1) * (io->pr_tcnt.limit + 1);
+
+	n = prescaler_due(&io->e13);
+	if (n < d)
+		d = n;
+	if (io->spi_ticks && io->spi_ticks < d)
+		d = io->spi_ticks;
+	return d;
+}
+
+/* Run n clocks that we know are not interesting */
+static void m68hc11_e_skip(struct m6800 *cpu, unsigned int n)
+{
+	struct m68hc11 *io = &cpu->io;
+	unsigned int f = prescaler_due(&io->pr_tcnt);
+
+	if (io->spi_ticks)
+		io->spi_ticks -= n;
+	if (io->lock)
+		io->lock = io->lock > n ? io->lock - n : 0;
+	io->e13.count += n;
+	if (n < f) {
+		io->pr_tcnt.count += n;
+		return;
+	}
+	n -= f;
+	io->tcnt += 1 + n / (io->pr_tcnt.limit + 1);
+	io->pr_tcnt.count = n % (io->pr_tcnt.limit + 1);
+}
+
+static void m68hc11_e_clocks(struct m6800 *cpu, unsigned int n)
+{
+	unsigned int d;
+
+	while (n) {
+		d = m68hc11_e_due(cpu);
+		if (n < d) {
+			m68hc11_e_skip(cpu, n);
+			return;
+		}
+		m68hc11_e_skip(cpu, d - 1);
+		m68hc11_e_clock(cpu);
+		n -= d;
+	}
+}
 
 /*
- *	Execute a machine cycle and return how many clocks
- *	we took doing it.
+ *	Catch the timers up before the CPU touches the I/O space. The
+ *	access may change what happens next so look again afterwards.
  */
+static void m68hc11_timer_sync(struct m6800 *cpu)
+{
+	m68hc11_e_clocks(cpu, cpu->timer_pending);
+	cpu->timer_pending = 0;
+	cpu->timer_left = 0;
+}
 
-int m68hc11_execute(struct m6800 *cpu)
+static inline int m68hc11_step(struct m6800 *cpu)
 {
-	int cycles, i;
+	int cycles = 0;
 
 	/* Interrupts ? */
-	cycles = m68hc11_pre_execute(cpu);
+	if (cpu->irq)
+		cycles = m68hc11_pre_execute(cpu);
 	/* A cycle passes but we are waiting */
 	if (cpu->wait)
 		cycles = 1;
@@ -3832,10 +3990,36 @@ int m68hc11_execute(struct m6800 *cpu)
 	if (cpu->wait && (cpu->p & P_I))
 		return cycles;
 
-	/* Run the timers for these E cycles */
-	for (i = 0; i < cycles; i++)
-		m68hc11_e_clock(cpu);
+	/* Run the timers for these E cycles once something is due */
+	cpu->timer_pending += cycles;
+	if (cpu->timer_pending >= cpu->timer_left) {
+		m68hc11_e_clocks(cpu, cpu->timer_pending);
+		cpu->timer_pending = 0;
+		cpu->timer_left = m68hc11_e_due(cpu);
+	}
+	return cycles;
+}
+
+/*
+ *	Execute a machine cycle and return how many clocks
+ *	we took doing it.
+ */
 
+int m68hc11_execute(struct m6800 *cpu)
+{
+	return m68hc11_step(cpu);
+}
+
+/*
+ *	Execute instructions until at least budget clocks have passed and
+ *	return how many we took.
+ */
+int m68hc11_run(struct m6800 *cpu, int budget)
+{
+	int cycles = 0;
+
+	while (cycles < budget)
+		cycles += m68hc11_step(cpu);
 	return cycles;
 }
 
@@ -4205,6 +4389,7 @@ void m6800_write_io(struct m6800 *cpu, uint8_t addr, uint8_t val)
 			a single causes the FFF8 effect as on 6803 */
 		case 0x09:	/* Timer - test function set to FFF8 */
 			cpu->counter = 0xFFF8;
+			cpu->timer_left = 0;
 			break;
 		case 0x0A:	/* Timer - no effect */
 			break;
@@ -4214,11 +4399,13 @@ void m6800_write_io(struct m6800 *cpu, uint8_t addr, uint8_t val)
 			cpu->tcsr &= ~0x40;	/* Clear OCF */
 			/* Review : 1 insn or one clock ? */
 			cpu->oc_hold = 1;
+			cpu->timer_left = 0;
 			break;
 		case 0x0C:	/* Output compare low */
 			cpu->ocr &= 0xFF00;
 			cpu->ocr |= val;
 			cpu->tcsr &= ~0x40;	/* Clear OCF */
+			cpu->timer_left = 0;
 			break;
 		case 0x0D:	/* Input capture (not emulated) */
 		case 0x0E:
@@ -4307,6 +4494,8 @@ static uint8_t m68hc11_read_io(struct m6800 *cpu, uint8_t addr)
 	uint8_t val;
 	uint8_t mask;
 
+	m68hc11_timer_sync(cpu);
+
 	switch(addr) {
 		case 0x00:	/* Port A */
 			/* Port A bits 2, 1, 0 */
@@ -4460,6 +4649,9 @@ static uint8_t m68hc11_read_io(struct m6800 *cpu, uint8_t addr)
 static void m68hc11_write_io(struct m6800 *cpu, uint8_t addr, uint8_t val)
 {
 	static const unsigned int cop_limit[4] = { 1, 4, 16, 64 };
+
+	m68hc11_timer_sync(cpu);
+
 	switch(addr) {
 		case 0x00:
 			cpu->io.padr = val;
@@ -4562,10 +4754,12 @@ static void m68hc11_write_io(struct m6800 *cpu, uint8_t addr, uint8_t val)
 			break;
 		case 0x22:
 			cpu->io.tmsk1 = val;
+			m68hc11_timer_ints(cpu);
 			break;
 		case 0x23:
 			/* Clear flags by writing a 1 bit to the bits to clear */
 			cpu->io.tflg1 &= ~val;
+			m68hc11_timer_ints(cpu);
 			break;
 		case 0x24:
 			if (!cpu->io.lock && !(cpu->io.hprio & HPRIO_SMOD)) {
@@ -4588,10 +4782,12 @@ static void m68hc11_write_io(struct m6800 *cpu, uint8_t addr, uint8_t val)
 				cpu->io.pr_tcnt.limit = 16;
 				break;
 			}
+			m68hc11_timer_ints(cpu);
 			break;
 		case 0x25:
 			/* Clear flags by writing a 1 bit into the bit position */
 			cpu->io.tflg2 &= ~(val & 0xF0);
+			m68hc11_timer_ints(cpu);
 			break;
 		case 0x26:
 			cpu->io.pactl = val;
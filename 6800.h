@@ -186,6 +186,10 @@ struct m6800 {
 	/* Internal state */
 	int wait;
 	int oc_hold;
+	/* Clocks before the on chip timer next needs looking at, and clocks
+	   run since then that the HC11 timer chain has not yet seen */
+	unsigned int timer_left;
+	unsigned int timer_pending;
 	int type;
 #define CPU_6800	0
 #define CPU_6803	1
@@ -295,6 +299,8 @@ extern void m68hc11a_reset(struct m6800 *cpu, int variant, uint8_t cfg, const ui
 extern void m68hc11e_reset(struct m6800 *cpu, int variant, uint8_t cfg, const uint8_t *rom, uint8_t *eerom);
 extern int m6800_execute(struct m6800 *cpu);
 extern int m68hc11_execute(struct m6800 *cpu);
+extern int m6800_run(struct m6800 *cpu, int budget);
+extern int m68hc11_run(struct m6800 *cpu, int budget);
 extern void m6800_clear_interrupt(struct m6800 *cpu, int irq);
 extern void m6800_raise_interrupt(struct m6800 *cpu, int irq);
 extern void m6800_rx_byte(struct m6800 *cpu, uint8_t byte);
@@ -6,6 +6,12 @@
  *	model for video fetching.
  *
  *	TODO: add a border and border colours
+ *
+ *	Rendering is by scan line and lazy. The machine tells us before it
+ *	changes video memory or the mode and we catch up to the beam with
+ *	the old state, so mid frame changes show where they happened. Lines
+ *	that have not been changed since they were last drawn are left as
+ *	they are, so a static screen costs nothing to keep up.
  */
 
 #include <stdio.h>
@@ -22,8 +28,19 @@ struct m6847 {
 	uint32_t foreground;
 	uint32_t *colourmap;
 	uint32_t rasterbuffer[256 * 192];
+	/* Lazy rendering. Each change to what is displayed bumps gen and
+	   a line is drawn again only if it was drawn under an older gen */
+	unsigned int gen;
+	unsigned int linegen[192];
+	unsigned int done;		/* Lines drawn so far this frame */
 };
 
+/* NTSC: 262 lines of which the last 192 are video, 128 clocks of each
+   line are the 256 pixels */
+#define M6847_TOP	70
+#define M6847_LEFT	71
+#define M6847_RIGHT	199
+
 /* Pixels per rendered pixel */
 static uint8_t xpandtab[8] = {
 	4, 2, 1, 2, 1, 2, 1, 1
@@ -37,34 +54,29 @@ static uint8_t ypandtab[8] = {
 #define m6847_mode(x)		(config & (M6847_GM0|M6847_GM1|M6847_GM2))
 
 /* One bit per pixel magnified according to mode */
-static void m6847_rg_raster(struct m6847 *vdg, uint8_t config)
+static void m6847_rg_raster(struct m6847 *vdg, uint8_t config, unsigned int y)
 {
-	uint32_t *p = vdg->rasterbuffer;
-	uint16_t base = 0, oldbase;
+	uint32_t *p = vdg->rasterbuffer + 256 * y;
 //	unsigned int rg = config & M6847_GM0;
 	unsigned int xpand = xpandtab[m6847_mode(config) & 0x07];
 	unsigned int ypand = ypandtab[m6847_mode(config) & 0x07];
-	unsigned int i, j, x, y = 0;
-
-	while(y < 192) {
-		oldbase = base;
-		x = 0;
-		while(x < 256) {
-			uint8_t data = m6847_video_read(vdg, base++, NULL);
-			for (i = 0; i < 8; i++) {
-				for (j = 0; j < xpand; j++) {
-					if (data & 0x80)
-						*p++ = vdg->foreground;
-					else
-						*p++ = vdg->background;
-					x++;
-				}
-				data <<= 1;
+	/* Each byte is 8 * xpand pixels wide */
+	uint16_t base = (y / ypand) * (32 / xpand);
+	unsigned int i, j, x;
+
+	x = 0;
+	while(x < 256) {
+		uint8_t data = m6847_video_read(vdg, base++, NULL);
+		for (i = 0; i < 8; i++) {
+			for (j = 0; j < xpand; j++) {
+				if (data & 0x80)
+					*p++ = vdg->foreground;
+				else
+					*p++ = vdg->background;
+				x++;
 			}
+			data <<= 1;
 		}
-		y++;
-		if (y % ypand)
-			base = oldbase;
 	}
 }
 
@@ -72,37 +84,32 @@ static void m6847_rg_raster(struct m6847 *vdg, uint8_t config)
    input pixel producing one output pixel in fg/bg it produces two output
    pixels both in one of 4 colours */
 
-static void m6847_cg_raster(struct m6847 *vdg, uint8_t config)
+static void m6847_cg_raster(struct m6847 *vdg, uint8_t config, unsigned int y)
 {
-	uint32_t *p = vdg->rasterbuffer;
-	uint16_t base = 0, oldbase;
+	uint32_t *p = vdg->rasterbuffer + 256 * y;
 //	unsigned int rg = config & M6847_GM0;
 	unsigned int xpand = xpandtab[m6847_mode(config) & 0x07];
 	unsigned int ypand = ypandtab[m6847_mode(config) & 0x07];
-	unsigned int i, j, x, y = 0;
+	/* Each byte is 4 * 2 * xpand pixels wide */
+	uint16_t base = (y / ypand) * (32 / xpand);
+	unsigned int i, j, x;
 	uint32_t colour;
 
-	while(y < 192) {
-		oldbase = base;
-		x = 0;
-		while(x < 256) {
-			uint8_t data = m6847_video_read(vdg, base++, NULL);
-			for (i = 0; i <= 3; i++) {
-				for (j = 0; j < xpand; j++) {
-					if (config & M6847_CSS)
-						colour = vdg->colourmap[((data & 0xC0) >> 6) + 4];
-					else
-						colour = vdg->colourmap[(data & 0xC0) >> 6];
-					*p++ = colour;
-					*p++ = colour;
-					x+= 2;
-				}
-				data <<= 2;
+	x = 0;
+	while(x < 256) {
+		uint8_t data = m6847_video_read(vdg, base++, NULL);
+		for (i = 0; i <= 3; i++) {
+			for (j = 0; j < xpand; j++) {
+				if (config & M6847_CSS)
+					colour = vdg->colourmap[((data & 0xC0) >> 6) + 4];
+				else
+					colour = vdg->colourmap[(data & 0xC0) >> 6];
+				*p++ = colour;
+				*p++ = colour;
+				x+= 2;
 			}
+			data <<= 2;
 		}
-		y++;
-		if (y % ypand)
-			base = oldbase;
 	}
 }
 
@@ -130,54 +137,48 @@ static uint8_t m6847_semigraphics6(uint8_t sym, unsigned int slice)
 }
 
 /*
- *	Written this way so that if we ever need to we can switch to
- *	progressive scan line rendering.
+ *	Each character row is scanned 12 times
  */
-static void m6847_text_raster(struct m6847 *vdg, uint8_t config)
+static void m6847_text_raster(struct m6847 *vdg, uint8_t config, unsigned int y)
 {
-	uint32_t *p = vdg->rasterbuffer;
-	uint16_t base = 0;
+	uint32_t *p = vdg->rasterbuffer + 256 * y;
+	uint16_t base = (y / 12) * 32;
 	uint32_t textfg = vdg->foreground;
 	uint32_t background = vdg->background;
 	uint32_t foreground;
-	unsigned int y, x, i;
-
-	for (y = 0; y < 192; y++) {
-		unsigned int row = y % 12;
-		for (x = 0; x < 32; x++) {
-			uint8_t sym = m6847_video_read(vdg, base++, &config);
-			uint8_t data;
-			if (config & M6847_AS) {
-				if (config & M6847_INTEXT) {
-					foreground = vdg->colourmap[sym >> 6];
-					data = m6847_semigraphics6(sym, row);
-				} else {
-					if (config & M6847_CSS)
-						foreground = vdg->colourmap[4 + ((sym >> 4) & 0x07)];
-					else
-						foreground = vdg->colourmap[(sym >> 4) & 0x07];
-					data = m6847_semigraphics4(sym, row);
-				}
+	unsigned int row = y % 12;
+	unsigned int x, i;
+
+	for (x = 0; x < 32; x++) {
+		uint8_t sym = m6847_video_read(vdg, base++, &config);
+		uint8_t data;
+		if (config & M6847_AS) {
+			if (config & M6847_INTEXT) {
+				foreground = vdg->colourmap[sym >> 6];
+				data = m6847_semigraphics6(sym, row);
 			} else {
-				foreground = textfg;
-				if (config & M6847_INTEXT)
-					data = m6847_font_rom(vdg, sym, row);
-				else
-					data = font[sym & 0x3F][row];
-				if (config & M6847_INV)
-					data ^= 0xFF;
-			}
-			for (i = 0; i < 8; i++) {
-				if (data & 0x80)
-					*p++ = foreground;
+				if (config & M6847_CSS)
+					foreground = vdg->colourmap[4 + ((sym >> 4) & 0x07)];
 				else
-					*p++ = background;
-				data <<= 1;
+					foreground = vdg->colourmap[(sym >> 4) & 0x07];
+				data = m6847_semigraphics4(sym, row);
 			}
+		} else {
+			foreground = textfg;
+			if (config & M6847_INTEXT)
+				data = m6847_font_rom(vdg, sym, row);
+			else
+				data = font[sym & 0x3F][row];
+			if (config & M6847_INV)
+				data ^= 0xFF;
+		}
+		for (i = 0; i < 8; i++) {
+			if (data & 0x80)
+				*p++ = foreground;
+			else
+				*p++ = background;
+			data <<= 1;
 		}
-		/* Scan each row 12 times */
-		if (row != 11)
-			base -= 32;
 	}
 }
 
@@ -207,18 +208,71 @@ static void m6847_calc_colours(struct m6847 *vdg, uint8_t config)
 #endif
 }
 
-void m6847_rasterize(struct m6847 *vdg)
+static void m6847_raster_line(struct m6847 *vdg, unsigned int y)
 {
 	uint8_t config = m6847_get_config(vdg);
 
 	m6847_calc_colours(vdg, config);
 	if (config & M6847_AG) {
 		if (config & M6847_GM0)
-			m6847_rg_raster(vdg, config);
+			m6847_rg_raster(vdg, config, y);
 		else
-			m6847_cg_raster(vdg, config);
+			m6847_cg_raster(vdg, config, y);
 	} else
-		m6847_text_raster(vdg, config);
+		m6847_text_raster(vdg, config, y);
+	vdg->linegen[y] = vdg->gen;
+}
+
+/* Draw any lines up to the given one that have changed */
+static void m6847_raster_to(struct m6847 *vdg, unsigned int lines)
+{
+	unsigned int y;
+
+	for (y = vdg->done; y < lines; y++)
+		if (vdg->linegen[y] != vdg->gen)
+			m6847_raster_line(vdg, y);
+	if (lines > vdg->done)
+		vdg->done = lines;
+}
+
+/* Number of video lines the beam has finished at this point */
+static unsigned int m6847_beam(unsigned int line, unsigned int point)
+{
+	/* TODO: PAL - PAL has extra blanking lines */
+	if (line < M6847_TOP)
+		return 0;
+	line -= M6847_TOP;
+	if (point > M6847_RIGHT)
+		line++;
+	if (line > 192)
+		line = 192;
+	return line;
+}
+
+/*
+ *	Called before the machine changes video memory or the mode. Lines
+ *	the beam has passed are drawn as they were, everything after is
+ *	stale.
+ */
+void m6847_write(struct m6847 *vdg, unsigned line, unsigned point)
+{
+	m6847_raster_to(vdg, m6847_beam(line, point));
+	vdg->gen++;
+}
+
+/* Draw the rest of the frame and start the next one */
+void m6847_frame(struct m6847 *vdg)
+{
+	m6847_raster_to(vdg, 192);
+	vdg->done = 0;
+}
+
+/* Draw the whole frame as it is now */
+void m6847_rasterize(struct m6847 *vdg)
+{
+	vdg->gen++;
+	vdg->done = 0;
+	m6847_frame(vdg);
 }
 
 /* Mash the 8 pixel set that roughly correspond to this fetch. This is not
@@ -229,14 +283,18 @@ void m6847_sparkle(struct m6847 *vdg, unsigned line, unsigned point)
 	unsigned i;
 	/* In the blanking zone */
 	/* TODO: PAL - PAL has extra blanking lines */
-	if (line < 70)
+	if (line < M6847_TOP)
 		return;
 	/* 262 lines of which 192 are video */
-	line -= 70;
+	line -= M6847_TOP;
 	/* In hsync space */
-	if (point < 71 || point > 199)
+	if (point < M6847_LEFT || point > M6847_RIGHT)
 		return;
-	point -= 71;
+	point -= M6847_LEFT;
+	/* Draw the line as it should be then mark it so it is drawn clean
+	   next frame */
+	m6847_raster_to(vdg, line + 1);
+	vdg->linegen[line] = vdg->gen - 1;
 	/* The remaining 128 tstates are the 256 pixels */
 	point <<= 1;
 	/* point is now in pixels */
@@ -255,6 +313,7 @@ struct m6847 *m6847_create(unsigned int type)
 		exit(1);
 	}
 	memset(vdg, 0, sizeof(struct m6847));
+	vdg->gen = 1;
 	return vdg;
 }
 
@@ -271,6 +330,7 @@ void m6847_trace(struct m6847 *vdg, int onoff)
 void m6847_set_colourmap(struct m6847 *vdg, uint32_t *colourmap)
 {
 	vdg->colourmap = colourmap;
+	vdg->gen++;
 }
 
 uint32_t *m6847_get_raster(struct m6847 *vdg)
@@ -280,4 +340,5 @@ uint32_t *m6847_get_raster(struct m6847 *vdg)
 
 void m6847_reset(struct m6847 *vdg)
 {
+	vdg->gen++;
 }
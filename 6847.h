@@ -23,6 +23,10 @@ extern void m6847_trace(struct m6847 *cdg, int onoff);
 extern uint32_t *m6847_get_raster(struct m6847 *vdg);
 extern void m6847_set_colourmap(struct m6847 *vdg, uint32_t *cmap);
 extern void m6847_sparkle(struct m6847 *vdg, unsigned line, unsigned pos);
+/* Beam synchronized rendering: call m6847_write before changing video
+   memory or mode and m6847_frame at the end of each frame */
+extern void m6847_write(struct m6847 *vdg, unsigned line, unsigned pos);
+extern void m6847_frame(struct m6847 *vdg);
 
 /* User supplied */
 extern uint8_t m6847_get_config(struct m6847 *vdg);
@@ -129,6 +129,19 @@ int cpu_irq_ack(int level)
 	return M68K_INT_ACK_AUTOVECTOR;
 }
 
+/* RAM and ROM are plain memory so the CPU can fetch instructions from
+   them directly. Only the first copy of each is registered, the mirrors
+   go through cpu_read_*() as before. */
+static void fetch_regions(void)
+{
+	if (trace & TRACE_MEM)
+		return;
+	m68k_set_fetch_region(0, 0x000000, sizeof(rom), rom);
+	m68k_set_fetch_region(1, 0x200000, sizeof(rom), rom);
+	m68k_set_fetch_region(2, 0xC00000, sizeof(ram), ram);
+	m68k_set_fetch_region(3, 0xE00000, sizeof(ram), ram);
+}
+
 /* Read data from RAM, ROM, or a device */
 unsigned int do_cpu_read_byte(unsigned int address, unsigned int trap)
 {
@@ -277,6 +290,7 @@ static void device_init(void)
 	ide_reset_begin(ide);
 	uart16x50_reset(uart);
 	uart16x50_attach(uart, &console);
+	fetch_regions();
 }
 
 static struct termios saved_term, term;
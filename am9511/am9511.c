@@ -37,6 +37,8 @@
 struct am_context {
     unsigned char stack[16];
     int sp;
+    float fval[16];
+    unsigned char fstate[16];
     void *fptmp;
     unsigned char status;
     unsigned char op_latch;
@@ -69,10 +71,104 @@ struct am_context {
 #define dec_sp(n) ctx->sp = sp_add(-(n))
 
 
+/* Float cache
+ *
+ * Floating point values are also held in host format. fval[n] shadows
+ * the four stack bytes starting at n. A CLEAN entry agrees with the
+ * bytes, a DIRTY entry is newer than the bytes, which are only
+ * generated when something looks at them (a pop, an integer or stack
+ * op). Chains of float operations then never convert their results
+ * back to AM9511 format.
+ */
+#define FC_NONE  0
+#define FC_CLEAN 1
+#define FC_DIRTY 2
+
+
+/* Write the bytes for cache entry s
+ */
+static void fc_write(struct am_context *ctx, int s) {
+    unsigned char v[4];
+    int i;
+
+    na_fp(&ctx->fval[s], ctx->fptmp);
+    fp_am(ctx->fptmp, v);
+    for (i = 0; i < 4; ++i)
+	ctx->stack[(s + i) & 0xf] = v[i];
+    ctx->fstate[s] = FC_CLEAN;
+}
+
+
+/* Bring len bytes from stack position pos up to date. If inval is set
+ * the bytes are about to be changed so drop any entry covering them.
+ */
+static void fc_sync(struct am_context *ctx, int pos, int len, int inval) {
+    int i, s;
+
+    while (len--) {
+	for (i = 0; i < 4; ++i) {
+	    s = (pos - i) & 0xf;
+	    if (ctx->fstate[s] == FC_DIRTY)
+		fc_write(ctx, s);
+	    if (inval)
+		ctx->fstate[s] = FC_NONE;
+	}
+	pos++;
+    }
+}
+
+
+/* Sync bytes relative to the stack pointer
+ */
+#define fc_bytes(off, len, inval) fc_sync(ctx, sp_add(off), len, inval)
+
+
+/* Get the float at stack offset off
+ */
+static float fc_load(struct am_context *ctx, int off) {
+    unsigned char v[4];
+    int s = sp_add(off);
+    int i;
+
+    if (ctx->fstate[s] == FC_NONE) {
+	fc_sync(ctx, s, 4, 0);
+	for (i = 0; i < 4; ++i)
+	    v[i] = ctx->stack[(s + i) & 0xf];
+	am_fp(v, ctx->fptmp);
+	fp_na(ctx->fptmp, &ctx->fval[s]);
+	ctx->fstate[s] = FC_CLEAN;
+    }
+    return ctx->fval[s];
+}
+
+
+/* Store a float at stack offset off. The bytes are written later.
+ * Values the AM9511 format cannot hold convert to zero bytes, so keep
+ * zero in the cache for those, as that is what would be read back.
+ */
+static void fc_store(struct am_context *ctx, int off, float x) {
+    int s = sp_add(off);
+    int e;
+
+    if (x == 0.0 || !isfinite(x))
+	x = 0.0;
+    else {
+	frexp(x, &e);
+	if (e < -63 || e > 64)
+	    x = 0.0;
+    }
+    ctx->fstate[s] = FC_NONE;
+    fc_sync(ctx, s, 4, 1);
+    ctx->fval[s] = x;
+    ctx->fstate[s] = FC_DIRTY;
+}
+
+
 /* Push byte to am9511 stack
  */
 void am_push(void *amp, unsigned char v) {
     struct am_context *ctx = (struct am_context *)amp;
+    fc_bytes(0, 1, 1);
     *stpos(0) = v;
     inc_sp(1);
 }
@@ -83,6 +179,7 @@ void am_push(void *amp, unsigned char v) {
 unsigned char am_pop(void *amp) {
     struct am_context *ctx = (struct am_context *)amp;
     dec_sp(1);
+    fc_bytes(0, 1, 0);
     return *stpos(0);
 }
 
@@ -105,8 +202,20 @@ unsigned char am_status(void *amp) {
  * Zero detect for float is testing bit 23 for 0.
  * The sign bit for all types is the top-most bit. If 1 then
  * negative.
+ * A float result still in the cache is tested directly.
  */
 static void sz(struct am_context *ctx) {
+    float x;
+
+    if (!IS_FIXED && ctx->fstate[sp_add(-4)] == FC_DIRTY) {
+	x = ctx->fval[sp_add(-4)];
+	if (x == 0.0)
+	    ctx->status |= AM_ZERO;
+	else if (x < 0.0)
+	    ctx->status |= AM_SIGN;
+	return;
+    }
+    fc_bytes(-4, 4, 0);
     if (IS_SINGLE) {
 	if ((*stpos(-1) | *stpos(-2)) == 0)
 	    ctx->status |= AM_ZERO;
@@ -140,6 +249,7 @@ static void pupi(struct am_context *ctx) {
 static void pto(struct am_context *ctx) {
     unsigned char *s; 
 
+    fc_bytes(-4, 4, 0);
     if (IS_SINGLE) {
         s = stpos(-2);
 	am_push(ctx, *s++);
@@ -176,6 +286,7 @@ static void pop(struct am_context *ctx) {
 static void xch(struct am_context *ctx) {
     unsigned char *s, *t, v;
 
+    fc_bytes(-8, 8, 1);
     if (IS_SINGLE) {
 	s = stpos(-2);
 	t = stpos(-4);
@@ -200,6 +311,7 @@ static void chsf(struct am_context *ctx) {
      * (if not zero). And, as with the AM9511 chip, CHSF
      * is even faster than CHSS.
      */
+    fc_bytes(-4, 4, 1);
     if (*stpos(-2) & 0x80)
         *stpos(-1) ^= 0x80;
     sz(ctx);
@@ -209,6 +321,7 @@ static void chsf(struct am_context *ctx) {
 /* CHSS CHSD
  */
 static void chs(struct am_context *ctx) {
+    fc_bytes(-4, 4, 1);
     if (IS_SINGLE) {
         if (cm16(stpos(-2), stpos(-2)))
 	    ctx->status |= AM_ERR_OVF;
@@ -223,14 +336,8 @@ static void chs(struct am_context *ctx) {
 /* Push float to stack, set SIGN and ZERO
  */
 static void push_float(struct am_context *ctx, float x) {
-    unsigned char v[4];
-
-    na_fp(&x, ctx->fptmp);
-    fp_am(ctx->fptmp, v);
-    am_push(ctx, v[0]);
-    am_push(ctx, v[1]);
-    am_push(ctx, v[2]);
-    am_push(ctx, v[3]);
+    fc_store(ctx, 0, x);
+    inc_sp(4);
     ctx->op_latch = AM_FLOAT;
     sz(ctx);
 }
@@ -282,12 +389,9 @@ static void fltd(struct am_context *ctx) {
  */
 static void fixs(struct am_context *ctx) {
     float x;
-    unsigned char *s;
     int n;
 
-    s = stpos(-4);
-    am_fp(s, ctx->fptmp);
-    fp_na(ctx->fptmp, &x);
+    x = fc_load(ctx, -4);
     if ((x < -32768.0) || (x > 32767.0)) {
 	ctx->status |= AM_ERR_OVF;
 	sz(ctx);
@@ -307,13 +411,10 @@ static void fixs(struct am_context *ctx) {
  */
 static void fixd(struct am_context *ctx) {
     float x;
-    unsigned char *s;
     int32 n;
     float xl, xh;
 
-    s = stpos(-4);
-    am_fp(s, ctx->fptmp);
-    fp_na(ctx->fptmp, &x);
+    x = fc_load(ctx, -4);
     n = -2147483648;
     xl = (float)n;
     n = 2147483647;
@@ -340,6 +441,7 @@ static void add(struct am_context *ctx) {
     int carry;
     int overflow;
 
+    fc_bytes(-8, 8, 1);
     if (IS_SINGLE) {
         carry    = add16( stpos(-4), stpos(-2), stpos(-4));
         overflow = oadd16(stpos(-4), stpos(-2), stpos(-4));
@@ -363,6 +465,7 @@ static void sub(struct am_context *ctx) {
     int carry;
     int overflow;
 
+    fc_bytes(-8, 8, 1);
     if (IS_SINGLE) {
         carry    = sub16( stpos(-4), stpos(-2), stpos(-4));
         overflow = osub16(stpos(-4), stpos(-2), stpos(-4));
@@ -385,6 +488,7 @@ static void sub(struct am_context *ctx) {
 static void mul(struct am_context *ctx) {
     int overflow;
 
+    fc_bytes(-8, 8, 1);
     if (IS_SINGLE) {
         overflow = mull16(stpos(-4), stpos(-2), stpos(-4));
         dec_sp(2);
@@ -403,6 +507,7 @@ static void mul(struct am_context *ctx) {
 static void muu(struct am_context *ctx) {
     int overflow;
 
+    fc_bytes(-8, 8, 1);
     if (IS_SINGLE) {
         overflow = mulu16(stpos(-4), stpos(-2), stpos(-4));
         dec_sp(2);
@@ -421,6 +526,7 @@ static void muu(struct am_context *ctx) {
 static void divi(struct am_context *ctx) {
     int div0;
 
+    fc_bytes(-8, 8, 1);
     if (IS_SINGLE) {
         div0 = div16(stpos(-4), stpos(-2), stpos(-4));
         dec_sp(2);
@@ -459,18 +565,12 @@ static int fov(struct am_context *ctx, double r) {
  * should be implemented via bit operations, not arithmetic.
  */
 static void basicf(struct am_context *ctx) {
-    unsigned char *ap, *bp;
     float a, b, r;
     double m;
     int e;
  
-    ap = stpos(-4);
-    am_fp(ap, ctx->fptmp);
-    fp_na(ctx->fptmp, &a);
-
-    bp = stpos(-8);
-    am_fp(bp, ctx->fptmp);
-    fp_na(ctx->fptmp, &b);
+    a = fc_load(ctx, -4);
+    b = fc_load(ctx, -8);
 
     switch (ctx->op_latch & AM_OP) {
     case AM_FADD:
@@ -489,6 +589,12 @@ static void basicf(struct am_context *ctx) {
 	} else
             r = b / a;
 	break;
+    default:
+	/* Only the four ops above are dispatched here */
+	ctx->status |= AM_ERR_ARG;
+	ctx->op_latch = AM_FLOAT;
+	sz(ctx);
+	return;
     }
 
     /* We do not use fov() because we want to bias exponent by 128
@@ -504,8 +610,7 @@ static void basicf(struct am_context *ctx) {
 	e += 128;
 	r = ldexp(m, e);
     }
-    na_fp(&r, ctx->fptmp);
-    fp_am(ctx->fptmp, bp);
+    fc_store(ctx, -8, r);
     dec_sp(4);
     ctx->op_latch = AM_FLOAT;
     sz(ctx);
@@ -520,13 +625,10 @@ static void basicf(struct am_context *ctx) {
  * here.
  */
 static void ffunc(struct am_context *ctx) {
-    unsigned char *ap;
     float a;
     double x;
 
-    ap = stpos(-4);
-    am_fp(ap, ctx->fptmp);
-    fp_na(ctx->fptmp, &a);
+    a = fc_load(ctx, -4);
 
     x = a;
     switch (ctx->op_latch & AM_OP) {
@@ -590,9 +692,7 @@ static void ffunc(struct am_context *ctx) {
     }
     if (fov(ctx, x))
 	goto err;
-    a = x;
-    na_fp(&a, ctx->fptmp);
-    fp_am(ctx->fptmp, ap);
+    fc_store(ctx, -4, x);
 err:
     ctx->op_latch = AM_FLOAT;
     sz(ctx);
@@ -605,19 +705,14 @@ err:
  */
 static void pwr(struct am_context *ctx) {
     /* B^A = EXP( A * LN(B) ) */
-    unsigned char *ap, *bp;
     float a, b;
     double x;
 
     /* A */
-    ap = stpos(-4);
-    am_fp(ap, ctx->fptmp);
-    fp_na(ctx->fptmp, &a);
+    a = fc_load(ctx, -4);
 
     /* B */
-    bp = stpos(-8);
-    am_fp(bp, ctx->fptmp);
-    fp_na(ctx->fptmp, &b);
+    b = fc_load(ctx, -8);
 
     /* LN(B) */
     if (b < 0.0) {
@@ -641,9 +736,7 @@ static void pwr(struct am_context *ctx) {
         goto err;
 
     /* replace B with result */
-    b = x;
-    na_fp(&b, ctx->fptmp);
-    fp_am(ctx->fptmp, bp);
+    fc_store(ctx, -8, x);
 
     /* roll stack */
     dec_sp(4);
@@ -764,6 +857,62 @@ void am_command(void *amp, unsigned char op) {
 }
 
 
+/* Command execution times in device clocks, from the command summary
+ * in the AM9511A data sheet. The columns are float, double and single
+ * forms of the command. Where the sheet gives a range (the real figure
+ * depends on the operands) we use the middle of it.
+ */
+static const unsigned short am_time[32][3] = {
+    {    4,    4,    4 }, /* NOP */
+    {  826,  826,  826 }, /* SQRT */
+    { 4302, 4302, 4302 }, /* SIN */
+    { 4359, 4359, 4359 }, /* COS */
+    { 5390, 5390, 5390 }, /* TAN */
+    { 7084, 7084, 7084 }, /* ASIN */
+    { 7294, 7294, 7294 }, /* ACOS */
+    { 5764, 5764, 5764 }, /* ATAN */
+    { 5803, 5803, 5803 }, /* LOG */
+    { 5627, 5627, 5627 }, /* LN */
+    { 4336, 4336, 4336 }, /* EXP */
+    {10161,10161,10161 }, /* PWR */
+    {   21,   21,   17 }, /* ADD */
+    {   39,   39,   31 }, /* SUB */
+    {  202,  202,   89 }, /* MUL */
+    {  203,  203,   89 }, /* DIV */
+    {  211,  211,  211 }, /* FADD */
+    {  220,  220,  220 }, /* FSUB */
+    {  157,  157,  157 }, /* FMUL */
+    {  169,  169,  169 }, /* FDIV */
+    {   27,   27,   23 }, /* CHS */
+    {   18,   18,   18 }, /* CHSF */
+    {  200,  200,   89 }, /* MUU */
+    {   20,   20,   16 }, /* PTO */
+    {   12,   12,   10 }, /* POP */
+    {   26,   26,   18 }, /* XCH */
+    {   16,   16,   16 }, /* PUPI */
+    {    4,    4,    4 },
+    {  199,  199,  199 }, /* FLTD */
+    {  109,  109,  109 }, /* FLTS */
+    {  213,  213,  213 }, /* FIXD */
+    {  152,  152,  152 }  /* FIXS */
+};
+
+
+/* Return how many device clocks the chip stays BUSY for a command.
+ */
+unsigned int am_cycles(unsigned char op) {
+    int form;
+
+    if ((op & AM_SINGLE) == AM_SINGLE)
+	form = 2;
+    else if (op & AM_FIXED)
+	form = 1;
+    else
+	form = 0;
+    return am_time[op & AM_OP][form];
+}
+
+
 /* Reset the am9511 emulator
  */
 void am_reset(void *amp) {
@@ -774,8 +923,10 @@ void am_reset(void *amp) {
     ctx->status = 0;
     ctx->op_latch = 0;
     ctx->last_latch = 0;
-    for (i = 0; i < 16; ++i)
+    for (i = 0; i < 16; ++i) {
 	ctx->stack[i] = 0;
+	ctx->fstate[i] = FC_NONE;
+    }
 }
 
 
@@ -818,6 +969,7 @@ void am_dump(void *amp, unsigned char op) {
         "FLTD", "FLTS", "FIXD", "FIXS"
     };
 
+    fc_sync(ctx, 0, 16, 0);
     printf("AM9511 STATUS: %02x ", ctx->status);
         if (t & AM_BUSY)  printf("BUSY ");
         if (t & AM_SIGN)  printf("SIGN ");
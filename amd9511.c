@@ -1,6 +1,12 @@
 /*
  *	Wrap the AM9511 library into our usual format. The library is close
  *	to our needs anyway.
+ *
+ *	The library completes each command at once. We add the timing: the
+ *	chip reports BUSY for as long as the data sheet says the command
+ *	takes, and a data or command access made while busy is held off by
+ *	PAUSE until the command is done. We assume the APU is clocked at
+ *	half the CPU clock, which is the usual arrangement on an RC2014 bus.
  */
 
 #include <stdio.h>
@@ -11,10 +17,12 @@
 
 #include "amd9511.h"
 
+#define APU_DIV		2	/* CPU clocks per APU clock */
 
 struct amd9511 {
 	void *context;
 	unsigned int trace;
+	unsigned int busy;	/* CPU clocks until the command completes */
 };
 
 
@@ -23,6 +31,8 @@ uint8_t amd9511_read(struct amd9511 *am, uint8_t addr)
 	addr &= 1;
 	if (addr == 0)
 		return am_pop(am->context);
+	if (am->busy)
+		return AM_BUSY;
 	return am_status(am->context);
 }
 
@@ -31,8 +41,30 @@ void amd9511_write(struct amd9511 *am, uint8_t addr, uint8_t val)
 	addr &= 1;
 	if (addr == 0)
 		am_push(am->context, val);
-	else
+	else {
 		am_command(am->context, val);
+		am->busy = am_cycles(val) * APU_DIV;
+		if (am->trace)
+			fprintf(stderr, "am9511: command %02X busy for %u clocks.\n",
+				val, am->busy);
+	}
+}
+
+/* An access other than a status read waits for the APU. Returns the
+   CPU clocks the access is stalled by and finishes the command. */
+unsigned int amd9511_pause(struct amd9511 *am)
+{
+	unsigned int n = am->busy;
+	am->busy = 0;
+	return n;
+}
+
+void amd9511_tick(struct amd9511 *am, unsigned int clocks)
+{
+	if (am->busy > clocks)
+		am->busy -= clocks;
+	else
+		am->busy = 0;
 }
 
 struct amd9511 *amd9511_create(void)
@@ -43,6 +75,7 @@ struct amd9511 *amd9511_create(void)
 		exit(1);
 	}
 	am->trace = 0;
+	am->busy = 0;
 	am->context = am_create(0,0 /* parameters are unused */);
 	if (am->context == NULL) {
 		fprintf(stderr, "Failed to create AMD9511 FPU context.\n");
@@ -61,6 +94,7 @@ void amd9511_free(struct amd9511 *am)
 void amd9511_reset(struct amd9511 *am)
 {
 	am_reset(am->context);
+	am->busy = 0;
 }
 
 void amd9511_trace(struct amd9511 *am, unsigned int trace)
@@ -7,6 +7,8 @@ struct amd9511;
 
 uint8_t amd9511_read(struct amd9511 *am, uint8_t addr);
 void amd9511_write(struct amd9511 *am, uint8_t addr, uint8_t val);
+unsigned int amd9511_pause(struct amd9511 *am);
+void amd9511_tick(struct amd9511 *am, unsigned int clocks);
 struct amd9511 *amd9511_create(void);
 void amd9511_free(struct amd9511 *am);
 void amd9511_reset(struct amd9511 *am);
@@ -26,7 +26,9 @@ ay8912_t *ay8912_create(uint32_t psg_clock, uint32_t sample_rate)
     }
     /* Use the authentic AY-3-8910 non-linear volume table. */
     PSG_setVolumeMode(ay->psg, EMU2149_VOL_AY_3_8910);
-    PSG_set_quality(ay->psg, 0);
+    /* Average all the PSG steps in each output sample. With the block
+       interface this is cheap enough to leave on. */
+    PSG_set_quality(ay->psg, 1);
     PSG_reset(ay->psg);
     return ay;
 }
@@ -57,8 +59,26 @@ uint8_t ay8912_read_data(ay8912_t *ay)
     return PSG_readIO(ay->psg);
 }
 
+/* Latched register number, for saving snapshots. */
+uint8_t ay8912_selected(ay8912_t *ay)
+{
+    return ay->psg->adr;
+}
+
+/* Register contents without going through the port interface. */
+uint8_t ay8912_peek(ay8912_t *ay, uint8_t reg)
+{
+    return PSG_readReg(ay->psg, reg);
+}
+
 /* Step one output sample; returns mono mix in [0, AY8912_MAX_OUTPUT]. */
 int16_t ay8912_calc(ay8912_t *ay)
 {
     return PSG_calc(ay->psg);
+}
+
+/* Step n output samples into out[]. */
+void ay8912_calc_block(ay8912_t *ay, int16_t *out, uint32_t n)
+{
+    PSG_calc_block(ay->psg, out, n);
 }
\ No newline at end of file
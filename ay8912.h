@@ -8,9 +8,9 @@
  * Wraps the emu2149 library (EMU2149_VOL_AY_3_8910 table).
  *
  * The PSG is clocked at CPU_CLK/2 (~1.7735 MHz on ZX Spectrum 128K/+3)
- * and is stepped sample-by-sample at the host audio output rate via
- * ay8912_calc(), which must be called once per output sample inside the
- * audio advance loop (beeper_advance_to).
+ * and is stepped at the host audio output rate via ay8912_calc() or, for
+ * a run of samples, ay8912_calc_block() inside the audio advance loop
+ * (beeper_advance_to).
  *
  * Port usage (128K/+3):
  *   OUT 0xFFFD  -> ay8912_select_reg() : latch AY register address
@@ -37,12 +37,22 @@ void    ay8912_write_data(ay8912_t *ay, uint8_t val);
 /* IN  0xFFFD: read value from the currently selected register. */
 uint8_t ay8912_read_data(ay8912_t *ay);
 
+/* Snapshot support: the latched register and raw register contents. */
+uint8_t ay8912_selected(ay8912_t *ay);
+uint8_t ay8912_peek(ay8912_t *ay, uint8_t reg);
+
 /*
  * Step the PSG by one output sample and return the mono mixed value.
  * Output range: [0, AY8912_MAX_OUTPUT].
  */
 int16_t ay8912_calc(ay8912_t *ay);
 
+/*
+ * Step the PSG by n output samples, writing the mono mix of each to out[].
+ * Same output range as ay8912_calc().
+ */
+void    ay8912_calc_block(ay8912_t *ay, int16_t *out, uint32_t n);
+
 /*
  * Maximum value that ay8912_calc() can return
  * (three channels each at full AY-3-8910 volume: 0xFF<<4 * 3 = 12240).
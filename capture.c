@@ -0,0 +1,360 @@
+/*
+ *	Frame and audio capture to disk, for use without a UI and for
+ *	automated visual regression.
+ *
+ *	Frames are ARGB8888 rasters as the video devices produce them for the
+ *	SDL renderers. capture_frame() copies the frame into a small ring and
+ *	a background thread converts and writes it so the emulation doesn't
+ *	wait on zlib or the disk. If the ring is full the emulation waits,
+ *	frames are never dropped.
+ *
+ *	If the path ends .png each frame is written as a PNG. The path may
+ *	contain a printf %u style conversion for the frame number, otherwise
+ *	-NNNNNN is added before the extension. Any other path gets a raw RGB24
+ *	stream, which ffmpeg will take as -f rawvideo -pix_fmt rgb24 -s WxH.
+ *
+ *	Audio is written as it arrives as 16bit little endian PCM and the
+ *	WAV header sizes are filled in when the file is closed.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <zlib.h>
+
+#include "capture.h"
+
+#define CAPTURE_RING	8
+
+struct capture {
+	unsigned int width;
+	unsigned int height;
+	unsigned int png;
+	char *pattern;		/* PNG file name pattern */
+	FILE *fp;		/* Raw stream */
+	unsigned int frame;	/* Frames written */
+	/* Ring of frames. Only the thread touches slots between tail and
+	   head, only capture_frame() the one at head */
+	uint32_t *ring;
+	unsigned int head;
+	unsigned int tail;
+	unsigned int done;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	/* Encoder work space */
+	uint8_t *rgb;		/* Filter byte + RGB per line */
+	uint8_t *zbuf;
+	uLong zlen;
+};
+
+static void *capture_alloc(size_t size)
+{
+	void *p = malloc(size);
+	if (p == NULL) {
+		fprintf(stderr, "Out of memory.\n");
+		exit(1);
+	}
+	return p;
+}
+
+static void put32be(uint8_t *p, uint32_t v)
+{
+	p[0] = v >> 24;
+	p[1] = v >> 16;
+	p[2] = v >> 8;
+	p[3] = v;
+}
+
+static void png_chunk(FILE *fp, const char *type, const uint8_t *data, uint32_t len)
+{
+	uint8_t b[4];
+	uLong crc;
+
+	put32be(b, len);
+	fwrite(b, 4, 1, fp);
+	fwrite(type, 4, 1, fp);
+	crc = crc32(0, (const Bytef *)type, 4);
+	/* crc32() with a NULL buffer returns the initial value, not crc */
+	if (len) {
+		fwrite(data, len, 1, fp);
+		crc = crc32(crc, data, len);
+	}
+	put32be(b, crc);
+	fwrite(b, 4, 1, fp);
+}
+
+/*
+ *	Write one frame as an 8bit RGB PNG. Each line uses the Sub filter
+ *	which turns the large flat areas of emulated displays into zeros.
+ */
+static void capture_png(struct capture *cap, const uint32_t *frame)
+{
+	static const uint8_t sig[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	unsigned int line = cap->width * 3 + 1;
+	uint8_t hdr[13];
+	uint8_t *p = cap->rgb;
+	uLongf zlen = cap->zlen;
+	char name[1024];
+	unsigned int x, y;
+	FILE *fp;
+
+	for (y = 0; y < cap->height; y++) {
+		uint8_t l[3] = { 0, 0, 0 };
+		*p++ = 1;
+		for (x = 0; x < cap->width; x++) {
+			uint32_t c = *frame++;
+			uint8_t r = c >> 16, g = c >> 8, b = c;
+			*p++ = r - l[0];
+			*p++ = g - l[1];
+			*p++ = b - l[2];
+			l[0] = r;
+			l[1] = g;
+			l[2] = b;
+		}
+	}
+	if (compress2(cap->zbuf, &zlen, cap->rgb, line * cap->height, 6) != Z_OK) {
+		fprintf(stderr, "capture: compression failed.\n");
+		return;
+	}
+
+	snprintf(name, sizeof(name), cap->pattern, cap->frame);
+	fp = fopen(name, "wb");
+	if (fp == NULL) {
+		perror(name);
+		return;
+	}
+	put32be(hdr, cap->width);
+	put32be(hdr + 4, cap->height);
+	hdr[8] = 8;		/* 8 bits per channel */
+	hdr[9] = 2;		/* RGB */
+	hdr[10] = 0;
+	hdr[11] = 0;
+	hdr[12] = 0;
+	fwrite(sig, sizeof(sig), 1, fp);
+	png_chunk(fp, "IHDR", hdr, sizeof(hdr));
+	png_chunk(fp, "IDAT", cap->zbuf, zlen);
+	png_chunk(fp, "IEND", NULL, 0);
+	if (fclose(fp))
+		perror(name);
+}
+
+static void capture_raw(struct capture *cap, const uint32_t *frame)
+{
+	uint8_t *p = cap->rgb;
+	unsigned int n = cap->width * cap->height;
+
+	while (n--) {
+		uint32_t c = *frame++;
+		*p++ = c >> 16;
+		*p++ = c >> 8;
+		*p++ = c;
+	}
+	fwrite(cap->rgb, cap->width * cap->height * 3, 1, cap->fp);
+}
+
+static void *capture_thread(void *arg)
+{
+	struct capture *cap = arg;
+	unsigned int size = cap->width * cap->height;
+
+	pthread_mutex_lock(&cap->lock);
+	while (1) {
+		while (cap->tail == cap->head && !cap->done)
+			pthread_cond_wait(&cap->cond, &cap->lock);
+		if (cap->tail == cap->head)
+			break;
+		pthread_mutex_unlock(&cap->lock);
+
+		if (cap->png)
+			capture_png(cap, cap->ring + (cap->tail % CAPTURE_RING) * size);
+		else
+			capture_raw(cap, cap->ring + (cap->tail % CAPTURE_RING) * size);
+		cap->frame++;
+
+		pthread_mutex_lock(&cap->lock);
+		cap->tail++;
+		pthread_cond_broadcast(&cap->cond);
+	}
+	pthread_mutex_unlock(&cap->lock);
+	return NULL;
+}
+
+void capture_frame(struct capture *cap, const uint32_t *raster, unsigned int stride)
+{
+	uint32_t *slot;
+	unsigned int y;
+
+	pthread_mutex_lock(&cap->lock);
+	while (cap->head - cap->tail == CAPTURE_RING)
+		pthread_cond_wait(&cap->cond, &cap->lock);
+	pthread_mutex_unlock(&cap->lock);
+
+	slot = cap->ring + (cap->head % CAPTURE_RING) * cap->width * cap->height;
+	for (y = 0; y < cap->height; y++) {
+		memcpy(slot, raster, cap->width * sizeof(uint32_t));
+		slot += cap->width;
+		raster += stride;
+	}
+
+	pthread_mutex_lock(&cap->lock);
+	cap->head++;
+	pthread_cond_broadcast(&cap->cond);
+	pthread_mutex_unlock(&cap->lock);
+}
+
+/* Build the PNG name pattern, adding -%06u if the path has no % in it */
+static char *capture_pattern(const char *path)
+{
+	size_t len = strlen(path);
+	char *p;
+
+	if (strchr(path, '%'))
+		return strdup(path);
+	p = capture_alloc(len + 8);
+	memcpy(p, path, len - 4);
+	strcpy(p + len - 4, "-%06u.png");
+	return p;
+}
+
+struct capture *capture_create(const char *path, unsigned int width, unsigned int height)
+{
+	struct capture *cap = capture_alloc(sizeof(struct capture));
+	size_t len = strlen(path);
+
+	memset(cap, 0, sizeof(struct capture));
+	cap->width = width;
+	cap->height = height;
+	if (len > 4 && strcmp(path + len - 4, ".png") == 0) {
+		cap->png = 1;
+		cap->pattern = capture_pattern(path);
+		cap->zlen = compressBound((width * 3 + 1) * height);
+		cap->zbuf = capture_alloc(cap->zlen);
+	} else {
+		cap->fp = fopen(path, "wb");
+		if (cap->fp == NULL) {
+			perror(path);
+			free(cap);
+			return NULL;
+		}
+	}
+	cap->rgb = capture_alloc((width * 3 + 1) * height);
+	cap->ring = capture_alloc(CAPTURE_RING * width * height * sizeof(uint32_t));
+	pthread_mutex_init(&cap->lock, NULL);
+	pthread_cond_init(&cap->cond, NULL);
+	if (pthread_create(&cap->thread, NULL, capture_thread, cap)) {
+		fprintf(stderr, "capture: unable to create thread.\n");
+		exit(1);
+	}
+	return cap;
+}
+
+void capture_free(struct capture *cap)
+{
+	if (cap == NULL)
+		return;
+	pthread_mutex_lock(&cap->lock);
+	cap->done = 1;
+	pthread_cond_broadcast(&cap->cond);
+	pthread_mutex_unlock(&cap->lock);
+	pthread_join(cap->thread, NULL);
+	pthread_cond_destroy(&cap->cond);
+	pthread_mutex_destroy(&cap->lock);
+	if (cap->fp && fclose(cap->fp))
+		perror("capture");
+	free(cap->pattern);
+	free(cap->zbuf);
+	free(cap->rgb);
+	free(cap->ring);
+	free(cap);
+}
+
+/*
+ *	WAV
+ */
+
+struct wavfile {
+	FILE *fp;
+	unsigned int rate;
+	unsigned int channels;
+	uint32_t bytes;
+};
+
+static void put32le(uint8_t *p, uint32_t v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+	p[2] = v >> 16;
+	p[3] = v >> 24;
+}
+
+static void wavfile_header(struct wavfile *wav)
+{
+	uint8_t h[44];
+
+	memcpy(h, "RIFF", 4);
+	put32le(h + 4, 36 + wav->bytes);
+	memcpy(h + 8, "WAVEfmt ", 8);
+	put32le(h + 16, 16);
+	h[20] = 1;		/* PCM */
+	h[21] = 0;
+	h[22] = wav->channels;
+	h[23] = 0;
+	put32le(h + 24, wav->rate);
+	put32le(h + 28, wav->rate * wav->channels * 2);
+	h[32] = wav->channels * 2;
+	h[33] = 0;
+	h[34] = 16;
+	h[35] = 0;
+	memcpy(h + 36, "data", 4);
+	put32le(h + 40, wav->bytes);
+	fwrite(h, sizeof(h), 1, wav->fp);
+}
+
+struct wavfile *wavfile_create(const char *path, unsigned int rate, unsigned int channels)
+{
+	struct wavfile *wav = capture_alloc(sizeof(struct wavfile));
+
+	wav->fp = fopen(path, "wb");
+	if (wav->fp == NULL) {
+		perror(path);
+		free(wav);
+		return NULL;
+	}
+	wav->rate = rate;
+	wav->channels = channels;
+	wav->bytes = 0;
+	wavfile_header(wav);
+	return wav;
+}
+
+/* n is the number of samples, interleaved if there are several channels */
+void wavfile_write(struct wavfile *wav, const int16_t *samples, unsigned int n)
+{
+	uint8_t buf[1024];
+
+	while (n) {
+		unsigned int i;
+		unsigned int len = n > sizeof(buf) / 2 ? sizeof(buf) / 2 : n;
+		for (i = 0; i < len; i++) {
+			buf[2 * i] = *samples;
+			buf[2 * i + 1] = *samples++ >> 8;
+		}
+		fwrite(buf, 2 * len, 1, wav->fp);
+		wav->bytes += 2 * len;
+		n -= len;
+	}
+}
+
+void wavfile_free(struct wavfile *wav)
+{
+	if (wav == NULL)
+		return;
+	fseek(wav->fp, 0L, SEEK_SET);
+	wavfile_header(wav);
+	if (fclose(wav->fp))
+		perror("wav");
+	free(wav);
+}
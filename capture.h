@@ -0,0 +1,26 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+
+/*
+ *	Video capture of ARGB8888 rasters. A path ending .png gives a PNG
+ *	sequence, anything else a raw RGB24 stream. Frames are encoded on a
+ *	background thread; capture_free() flushes and closes.
+ */
+struct capture;
+
+extern struct capture *capture_create(const char *path, unsigned int width, unsigned int height);
+extern void capture_frame(struct capture *cap, const uint32_t *raster, unsigned int stride);
+extern void capture_free(struct capture *cap);
+
+/*
+ *	16bit PCM WAV output
+ */
+struct wavfile;
+
+extern struct wavfile *wavfile_create(const char *path, unsigned int rate, unsigned int channels);
+extern void wavfile_write(struct wavfile *wav, const int16_t *samples, unsigned int n);
+extern void wavfile_free(struct wavfile *wav);
+
+#endif
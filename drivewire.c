@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -15,6 +16,7 @@
 #define DW_ERR_OUT	3
 #define DW_CSUM_IN_1	4
 #define DW_CSUM_IN_2	5
+#define DW_WAIT		6	/* Waiting for the worker to read a sector */
 
 #define DW_DRIVES	16
 
@@ -27,6 +29,56 @@ static uint8_t dw_buf[262];
 static uint8_t *dw_ptr = dw_buf;
 static int dw_fd[DW_DRIVES];
 static unsigned dw_len;
+static unsigned dw_immediate;
+
+/*
+ *	Disk access is done by a worker thread so the emulation never waits
+ *	on the host. Sectors are kept in a direct mapped cache by LSN, reads
+ *	also fetch the following sectors, and writes update the cache at once
+ *	and go to disk behind the guest. Everything below is shared with the
+ *	worker and covered by dw_lock.
+ */
+
+#define DW_CACHE	256	/* Sectors, power of two */
+#define DW_READAHEAD	8
+#define DW_QUEUE	64
+
+#define JOB_READ	0	/* Read for the guest, then read ahead */
+#define JOB_WRITE	1
+#define JOB_PREFETCH	2	/* Read ahead only */
+
+struct dw_sector {
+	uint8_t valid;
+	uint8_t drive;
+	uint32_t lsn;
+	uint8_t data[256];
+};
+
+struct dw_job {
+	uint8_t type;
+	uint8_t drive;
+	uint32_t lsn;
+	uint8_t data[256];
+};
+
+static pthread_t dw_thread;
+static pthread_mutex_t dw_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dw_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t dw_done = PTHREAD_COND_INITIALIZER;
+static unsigned dw_running;
+static unsigned dw_stop;
+
+static struct dw_sector dw_cache[DW_CACHE];
+static struct dw_job dw_queue[DW_QUEUE];
+static unsigned dw_qhead;	/* Next job for the worker */
+static unsigned dw_qlen;
+static unsigned dw_busy;	/* Worker is running a job */
+
+/* The read the guest is waiting for */
+static unsigned dw_answer_ready;
+static uint8_t dw_answer_err;
+static uint8_t dw_answer[256];
+static uint8_t dw_werr[DW_DRIVES];	/* Write behind failed */
 
 /*
  *	Produce a time block
@@ -105,7 +157,7 @@ static void dw_command(uint8_t c)
 	case 0x53:
 	case 0x77:		/* Write */
 	case 0x57:
-		dw_tx_block(262);	/* drive, LSN, 256 bytes, checksum */
+		dw_rx_block(262);	/* drive, LSN, 256 bytes, checksum */
 		break;
 	case 0x23:		/* Get date */
 		dw_len = 7;
@@ -127,13 +179,14 @@ static uint16_t dw_checksum(uint8_t *p, unsigned len)
 {
 	uint16_t sum = 0;
 	while(len--)
-		sum += *p;
+		sum += *p++;
 	return sum;
 }
 
 static void dw_csum_1(uint8_t c)
 {
 	dw_rcsum = c;
+	dw_mode = DW_CSUM_IN_2;
 }
 
 static void dw_csum_2(uint8_t c)
@@ -147,32 +200,176 @@ static void dw_csum_2(uint8_t c)
 	drivewire_byte_pending();
 }
 
-static int dw_prepare(int *fd)
+static struct dw_sector *dw_slot(unsigned drive, uint32_t lsn)
 {
-	uint32_t lsn;
-	unsigned drive = dw_buf[0];
-	if (drive >= DW_DRIVES || dw_fd[drive] == -1)
+	return dw_cache + ((lsn + drive * 0x35) & (DW_CACHE - 1));
+}
+
+static struct dw_sector *dw_lookup(unsigned drive, uint32_t lsn)
+{
+	struct dw_sector *s = dw_slot(drive, lsn);
+	if (s->valid && s->drive == drive && s->lsn == lsn)
+		return s;
+	return NULL;
+}
+
+/* A write for this sector is still queued so the disk copy is stale */
+static int dw_write_pending(unsigned drive, uint32_t lsn)
+{
+	unsigned i;
+	for (i = 0; i < dw_qlen; i++) {
+		struct dw_job *j = dw_queue + (dw_qhead + i) % DW_QUEUE;
+		if (j->type == JOB_WRITE && j->drive == drive && j->lsn == lsn)
+			return 1;
+	}
+	return 0;
+}
+
+/* Called with the lock held. Waits only if the queue is full */
+static void dw_queue_job(unsigned type, unsigned drive, uint32_t lsn, uint8_t *data)
+{
+	struct dw_job *j;
+
+	while (dw_qlen == DW_QUEUE)
+		pthread_cond_wait(&dw_done, &dw_lock);
+	j = dw_queue + (dw_qhead + dw_qlen) % DW_QUEUE;
+	j->type = type;
+	j->drive = drive;
+	j->lsn = lsn;
+	if (data)
+		memcpy(j->data, data, 256);
+	dw_qlen++;
+	pthread_cond_signal(&dw_work);
+}
+
+/*
+ *	Worker side. The file descriptors are only changed by attach and
+ *	detach, which wait for the worker to go idle first.
+ */
+
+static int dw_disk_read(unsigned drive, uint32_t lsn, uint8_t *buf)
+{
+	if (dw_fd[drive] == -1)
 		return -1;
-	lsn = dw_buf[1] << 24;
-	lsn |= dw_buf[2] << 16;
-	lsn |= dw_buf[3] << 8;
-	*fd = dw_fd[drive];
-	if (lseek(*fd, lsn, SEEK_SET) < 0)
+	if (pread(dw_fd[drive], buf, 256, (off_t)lsn << 8) != 256)
 		return -1;
 	return 0;
 }
 
-static void dw_read(void)
+static void dw_job_read(struct dw_job *j)
+{
+	uint8_t buf[256];
+	unsigned i;
+	int err;
+
+	/* The requested sector then read ahead. For JOB_READ the first
+	   answers the guest */
+	for (i = 0; i <= DW_READAHEAD; i++) {
+		uint32_t lsn = j->lsn + i;
+		unsigned answer = (i == 0 && j->type == JOB_READ);
+		struct dw_sector *s;
+
+		pthread_mutex_lock(&dw_lock);
+		s = dw_lookup(j->drive, lsn);
+		if (s && answer) {
+			memcpy(dw_answer, s->data, 256);
+			dw_answer_err = 0;
+			dw_answer_ready = 1;
+			pthread_cond_broadcast(&dw_done);
+		}
+		pthread_mutex_unlock(&dw_lock);
+		if (s)
+			continue;
+
+		err = dw_disk_read(j->drive, lsn, buf);
+
+		pthread_mutex_lock(&dw_lock);
+		if (answer) {
+			if (err)
+				memset(dw_answer, 0, 256);
+			else
+				memcpy(dw_answer, buf, 256);
+			dw_answer_err = err ? 0xF5 : 0x00;
+			dw_answer_ready = 1;
+			pthread_cond_broadcast(&dw_done);
+		}
+		/* Don't replace newer data from the guest with the disk copy */
+		if (!err && !dw_lookup(j->drive, lsn) && !dw_write_pending(j->drive, lsn)) {
+			s = dw_slot(j->drive, lsn);
+			memcpy(s->data, buf, 256);
+			s->drive = j->drive;
+			s->lsn = lsn;
+			s->valid = 1;
+		}
+		pthread_mutex_unlock(&dw_lock);
+		if (err)
+			break;
+	}
+}
+
+static void dw_job_write(struct dw_job *j)
+{
+	if (dw_fd[j->drive] == -1 ||
+		pwrite(dw_fd[j->drive], j->data, 256, (off_t)j->lsn << 8) != 256) {
+		pthread_mutex_lock(&dw_lock);
+		dw_werr[j->drive] = 0xF5;
+		pthread_mutex_unlock(&dw_lock);
+	}
+}
+
+static void *dw_worker(void *unused)
+{
+	struct dw_job j;
+
+	pthread_mutex_lock(&dw_lock);
+	while (1) {
+		while (dw_qlen == 0 && !dw_stop)
+			pthread_cond_wait(&dw_work, &dw_lock);
+		if (dw_qlen == 0)
+			break;
+		/* Work on a copy so the queue slot can be reused */
+		j = dw_queue[dw_qhead];
+		dw_busy = 1;
+		pthread_mutex_unlock(&dw_lock);
+
+		if (j.type == JOB_WRITE)
+			dw_job_write(&j);
+		else
+			dw_job_read(&j);
+
+		pthread_mutex_lock(&dw_lock);
+		dw_qhead = (dw_qhead + 1) % DW_QUEUE;
+		dw_qlen--;
+		dw_busy = 0;
+		pthread_cond_broadcast(&dw_done);
+	}
+	pthread_mutex_unlock(&dw_lock);
+	return NULL;
+}
+
+/* Wait for all queued disk work to finish */
+static void dw_sync(void)
+{
+	pthread_mutex_lock(&dw_lock);
+	while (dw_qlen || dw_busy)
+		pthread_cond_wait(&dw_done, &dw_lock);
+	pthread_mutex_unlock(&dw_lock);
+}
+
+static int dw_prepare(unsigned *drive, uint32_t *lsn)
+{
+	*drive = dw_buf[0];
+	if (*drive >= DW_DRIVES || dw_fd[*drive] == -1)
+		return -1;
+	*lsn = dw_buf[1] << 16;
+	*lsn |= dw_buf[2] << 8;
+	*lsn |= dw_buf[3];
+	return 0;
+}
+
+/* The sector is in dw_buf, send it */
+static void dw_read_done(void)
 {
-	int fd;
-	/* Bytes in buffer 0: drive, 1-3 LSN. Seek disk and get ready */
-	if (dw_prepare(&fd))
-		memset(dw_buf, 0, 256);	/* Send zeros on error */
-	else if (read(fd, dw_buf, 256) != 256) {
-		memset(dw_buf, 0, 256);
-		dw_err = 0xF5;
-	} else
-		dw_err = 0x00;
 	/* Now stream the bytes to the client */
 	dw_len = 256;
 	dw_ptr = dw_buf;
@@ -180,26 +377,98 @@ static void dw_read(void)
 	/* Weirdly the checksum is sent by the client and checked, not sent by server so adds
 	   extra turn arounds and latency */
 	dw_csum = dw_checksum(dw_buf, 256);
+	drivewire_byte_pending();
+}
+
+static void dw_read(void)
+{
+	struct dw_sector *s;
+	unsigned drive;
+	uint32_t lsn;
+
+	/* Bytes in buffer 0: drive, 1-3 LSN */
+	if (dw_prepare(&drive, &lsn)) {
+		memset(dw_buf, 0, 256);	/* Send zeros on error */
+		dw_read_done();
+		return;
+	}
+	pthread_mutex_lock(&dw_lock);
+	s = dw_lookup(drive, lsn);
+	if (s) {
+		memcpy(dw_buf, s->data, 256);
+		dw_err = dw_werr[drive];
+		dw_werr[drive] = 0;
+		/* Keep the read ahead going on sequential access */
+		if (!dw_lookup(drive, lsn + DW_READAHEAD / 2))
+			dw_queue_job(JOB_PREFETCH, drive, lsn + DW_READAHEAD / 2, NULL);
+		pthread_mutex_unlock(&dw_lock);
+		dw_read_done();
+		return;
+	}
+	/* Miss. The worker fills dw_answer, and drivewire_poll() picks it up
+	   unless we were asked to complete transactions immediately */
+	dw_answer_ready = 0;
+	dw_queue_job(JOB_READ, drive, lsn, NULL);
+	dw_mode = DW_WAIT;
+	if (dw_immediate) {
+		while (!dw_answer_ready)
+			pthread_cond_wait(&dw_done, &dw_lock);
+	}
+	pthread_mutex_unlock(&dw_lock);
+	drivewire_poll();
 }
 
 /* The block to write has arrived. Process it, set up for an error
    return and move to the err return state */
 static void dw_write(void)
 {
-	int fd;
+	struct dw_sector *s;
+	unsigned drive;
+	uint32_t lsn;
+
 	dw_csum = dw_checksum(dw_buf + 4, 256);
 	if ((dw_csum >> 8) != dw_buf[260] ||
 		(dw_csum & 0xFF) != dw_buf[261]) {
 		dw_err = 0xF3;
 		return;
 	}
-	if (dw_prepare(&fd))
+	if (dw_prepare(&drive, &lsn))
 		return;
-	if (write(fd, dw_buf + 4, 256) != 256) {
-		dw_err = 0xF5;
+	/* Update the cache now and write behind */
+	pthread_mutex_lock(&dw_lock);
+	s = dw_slot(drive, lsn);
+	memcpy(s->data, dw_buf + 4, 256);
+	s->drive = drive;
+	s->lsn = lsn;
+	s->valid = 1;
+	dw_queue_job(JOB_WRITE, drive, lsn, dw_buf + 4);
+	dw_err = dw_werr[drive];
+	dw_werr[drive] = 0;
+	pthread_mutex_unlock(&dw_lock);
+}
+
+/* Platform calls this regularly to collect completed reads */
+void drivewire_poll(void)
+{
+	if (dw_mode != DW_WAIT)
+		return;
+	pthread_mutex_lock(&dw_lock);
+	if (dw_answer_ready) {
+		memcpy(dw_buf, dw_answer, 256);
+		dw_err = dw_answer_err;
+		dw_answer_ready = 0;
+		pthread_mutex_unlock(&dw_lock);
+		dw_read_done();
 		return;
 	}
-	dw_err = 0;
+	pthread_mutex_unlock(&dw_lock);
+}
+
+/* Complete transactions as soon as the guest asks rather than when the
+   worker gets round to them. Trades waiting on the host disk for latency */
+void drivewire_set_immediate(unsigned on)
+{
+	dw_immediate = on;
 }
 
 /* We received the block we were supposed to */
@@ -208,12 +477,9 @@ static void dw_in_done(void)
 	switch(dw_cmd) {
 	case 0xF2:
 	case 0xD2:
-		/* Read the data info block, set error */
+		/* Read the data info block, set error, and send the
+		   256 bytes once we have them */
 		dw_read();
-		/* Now send the 256 bytes */
-		dw_len = 256;
-		dw_mode = DW_DATA_OUT;
-		drivewire_byte_pending();
 		break;
 	case 0x57:
 	case 0x77:
@@ -259,7 +525,7 @@ uint8_t drivewire_tx(void)
 	uint8_t r;
 	switch(dw_mode) {
 	case DW_DATA_OUT:
-		r = *dw_ptr;
+		r = *dw_ptr++;
 		dw_len--;
 		if (dw_len == 0)
 			dw_out_done();
@@ -301,11 +567,26 @@ void drivewire_init(void)
 	dw_mode = DW_IDLE;
 	for (i = 0; i < DW_DRIVES; i++)
 		dw_fd[i] = -1;
+	dw_stop = 0;
+	if (pthread_create(&dw_thread, NULL, dw_worker, NULL)) {
+		fprintf(stderr, "drivewire: unable to start worker.\n");
+		exit(1);
+	}
+	dw_running = 1;
 }
 
 void drivewire_shutdown(void)
 {
 	unsigned i;
+	/* Let the write behind finish */
+	if (dw_running) {
+		pthread_mutex_lock(&dw_lock);
+		dw_stop = 1;
+		pthread_cond_signal(&dw_work);
+		pthread_mutex_unlock(&dw_lock);
+		pthread_join(dw_thread, NULL);
+		dw_running = 0;
+	}
 	for (i = 0; i < DW_DRIVES; i++) {
 		if (dw_fd[i] != -1) {
 			close(dw_fd[i]);
@@ -318,6 +599,7 @@ int drivewire_attach(unsigned drive, const char *path, unsigned ro)
 {
 	if (drive >= DW_DRIVES)
 		return -1;
+	drivewire_detach(drive);
 	if (ro)
 		dw_fd[drive] = open(path, O_RDONLY);
 	else
@@ -327,8 +609,16 @@ int drivewire_attach(unsigned drive, const char *path, unsigned ro)
 
 void drivewire_detach(unsigned drive)
 {
+	unsigned i;
 	if (drive >= DW_DRIVES)
 		return;
+	if (dw_running)
+		dw_sync();
+	pthread_mutex_lock(&dw_lock);
+	for (i = 0; i < DW_CACHE; i++)
+		if (dw_cache[i].drive == drive)
+			dw_cache[i].valid = 0;
+	pthread_mutex_unlock(&dw_lock);
 	if (dw_fd[drive] != -1) {
 		close(dw_fd[drive]);
 		dw_fd[drive] = -1;
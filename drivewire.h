@@ -4,6 +4,8 @@ extern void drivewire_init(void);
 extern void drivewire_shutdown(void);
 extern int drivewire_attach(unsigned drive, const char *path, unsigned ro);
 extern void drivewire_detach(unsigned drive);
+extern void drivewire_poll(void);
+extern void drivewire_set_immediate(unsigned on);
 
 /* Platform provided */
 extern void drivewire_byte_pending(void);
@@ -13,6 +13,18 @@
 #include "ef9345.h"
 #include "ef9345_render.h"
 
+/* As the SDL renderer, so the raster can be captured without a UI */
+static uint32_t ef9345_ctab[16] = {
+	0xFF000000,
+	0xFFFF0000,
+	0xFF00FF00,
+	0xFFFFFF00,
+	0xFF0000FF,
+	0xFF00FFFF,
+	0xFFFFFF00,
+	0xFFFFFFFF
+};
+
 struct ef9345_renderer {
 	unsigned dummy;
 };
@@ -30,5 +42,6 @@ void ef8345_renderer_free(struct ef9345_renderer *render)
 
 struct ef9345_renderer *ef9345_renderer_create(struct ef9345 *ef9345)
 {
+	ef9345_set_colourmap(ef9345, ef9345_ctab);
 	return &dummy;
 }
@@ -36,6 +36,26 @@ static const uint8_t regmsk[16] = {
 
 #define GETA_BITS 24
 
+/* Size the block rate converter for the current clock and rate. Every
+ * output sample spans spb or spb + 1 PSG steps, so two reciprocals are
+ * all the averaging needs. Returns 0 if the step buffer can't be had. */
+static int
+block_setup (PSG * psg)
+{
+  int16_t *raw;
+
+  psg->spb = psg->realstep / psg->psgstep;
+  if (psg->spb >= 0xFFFF)
+    return 0;
+  psg->recip[0] = psg->spb ? (32768 + psg->spb / 2) / psg->spb : 0;
+  psg->recip[1] = (32768 + (psg->spb + 1) / 2) / (psg->spb + 1);
+  raw = realloc (psg->raw, PSG_BLOCK * (psg->spb + 1) * sizeof (int16_t));
+  if (raw == NULL)
+    return 0;
+  psg->raw = raw;
+  return 1;
+}
+
 static void
 internal_refresh (PSG * psg)
 {
@@ -51,8 +71,10 @@ internal_refresh (PSG * psg)
     psg->psgstep = psg->rate * 8;
     psg->psgtime = 0;
     psg->freq_limit = (uint32_t)(f_master / 16 / (psg->rate / 2));
+    if (!block_setup (psg))
+      psg->quality = 0;
   }
-  else
+  if (!psg->quality)
   {
     psg->base_incr = (uint32_t)((double)f_master * (1 << GETA_BITS) / 8 / psg->rate);
     psg->freq_limit = 0;
@@ -195,6 +217,7 @@ PSG_reset (PSG * psg)
 void
 PSG_delete (PSG * psg)
 {
+  free (psg->raw);
   free (psg);
 }
 
@@ -337,27 +360,77 @@ mix_output(PSG *psg)
   return (int16_t)(psg->ch_out[0] + psg->ch_out[1] + psg->ch_out[2]);
 }
 
-int16_t
-PSG_calc (PSG * psg)
+/* Render a block of samples. With quality set this runs in three passes
+ * of up to PSG_BLOCK output samples: work out how many PSG steps fall in
+ * each output sample, run the PSG for the whole block, then average each
+ * output sample over its steps (a box filter). */
+void
+PSG_calc_block (PSG * psg, int16_t * out, uint32_t n)
 {
-  if (!psg->quality) 
+  uint32_t len, total, i, k;
+  const int16_t *raw;
+  int32_t sum;
+
+  if (!psg->quality)
   {
-    update_output(psg);
-    psg->out = mix_output(psg);
+    while (n--)
+    {
+      update_output(psg);
+      psg->out = mix_output(psg);
+      *out++ = psg->out;
+    }
+    return;
   }
-  else
+
+  while (n)
   {
-    /* Simple rate converter (See README for detail). */
-    while (psg->realstep > psg->psgtime)
+    len = n < PSG_BLOCK ? n : PSG_BLOCK;
+    n -= len;
+
+    total = 0;
+    for (i = 0; i < len; i++)
+    {
+      uint32_t t = psg->psgtime + psg->spb * psg->psgstep;
+      k = psg->spb;
+      if (t < psg->realstep)
+      {
+        t += psg->psgstep;
+        k++;
+      }
+      psg->psgtime = t - psg->realstep;
+      psg->nstep[i] = k;
+      total += k;
+    }
+
+    for (i = 0; i < total; i++)
     {
-      psg->psgtime += psg->psgstep;
       update_output(psg);
-      psg->out += mix_output(psg);
-      psg->out >>= 1;
+      psg->raw[i] = mix_output(psg);
+    }
+
+    raw = psg->raw;
+    for (i = 0; i < len; i++)
+    {
+      k = psg->nstep[i];
+      /* If the output rate is above the PSG step rate hold the last value */
+      if (k)
+      {
+        sum = 0;
+        while (k--)
+          sum += *raw++;
+        psg->out = (sum * psg->recip[psg->nstep[i] - psg->spb]) >> 15;
+      }
+      *out++ = psg->out;
     }
-    psg->psgtime -= psg->realstep;
   }
-  return psg->out;
+}
+
+int16_t
+PSG_calc (PSG * psg)
+{
+  int16_t s;
+  PSG_calc_block(psg, &s, 1);
+  return s;
 }
 
 void
@@ -10,6 +10,9 @@
 
 #define PSG_MASK_CH(x) (1<<(x))
 
+/* Output samples rendered per pass of PSG_calc_block */
+#define PSG_BLOCK 256
+
 typedef struct __PSG
 {
 
@@ -55,6 +58,13 @@ typedef struct __PSG
   uint32_t psgtime;
   uint32_t psgstep;
 
+  /* block rate converter: each output sample takes spb or spb + 1 PSG
+     steps, averaged with the matching reciprocal (Q15) */
+  uint32_t spb;
+  int32_t recip[2];
+  uint16_t nstep[PSG_BLOCK];
+  int16_t *raw;
+
   uint32_t freq_limit;
 
   /* I/O Ctrl */
@@ -75,6 +85,7 @@ void PSG_writeIO (PSG * psg, uint32_t adr, uint32_t val);
 uint8_t PSG_readReg (PSG * psg, uint32_t reg);
 uint8_t PSG_readIO (PSG * psg);
 int16_t PSG_calc (PSG *);
+void PSG_calc_block (PSG *, int16_t *out, uint32_t n);
 void PSG_setVolumeMode (PSG * psg, int type);
 uint32_t PSG_setMask (PSG *, uint32_t mask);
 uint32_t PSG_toggleMask (PSG *, uint32_t mask);
@@ -50,17 +50,39 @@ static uint32_t voltbl[16] = {
 
 #define GETA_BITS 24
 
+/* Size the block rate converter for the current clock and rate. Every
+   output sample spans spb or spb + 1 steps, so two reciprocals are all
+   the averaging needs. Returns 0 if the step buffer can't be had. */
+static int
+block_setup (SNG * sng)
+{
+  int16_t *raw;
+
+  sng->spb = sng->realstep / sng->sngstep;
+  if (sng->spb >= 0xFFFF)
+    return 0;
+  sng->recip[0] = sng->spb ? (32768 + sng->spb / 2) / sng->spb : 0;
+  sng->recip[1] = (32768 + (sng->spb + 1) / 2) / (sng->spb + 1);
+  raw = realloc (sng->raw, SNG_BLOCK * (sng->spb + 1) * sizeof (int16_t));
+  if (raw == NULL)
+    return 0;
+  sng->raw = raw;
+  return 1;
+}
+
 static void
 internal_refresh (SNG * sng)
 {
   if (sng->quality)
   {
     sng->base_incr = 1 << GETA_BITS;
-    sng->realstep = (uint32_t) ((1 << 31) / sng->rate);
-    sng->sngstep = (uint32_t) ((1 << 31) / (sng->clk / 16));
+    sng->realstep = (uint32_t) ((1U << 31) / sng->rate);
+    sng->sngstep = (uint32_t) ((1U << 31) / (sng->clk / 16));
     sng->sngtime = 0;
+    if (!block_setup (sng))
+      sng->quality = 0;
   }
-  else
+  if (!sng->quality)
   {
     sng->base_incr = (uint32_t) ((double) sng->clk * (1 << GETA_BITS) / (16 * sng->rate));
   }
@@ -88,6 +110,7 @@ SNG * SNG_new (uint32_t c, uint32_t r)
 
   sng->clk = c;
   sng->rate = r ? r : 44100;
+  sng->raw = NULL;
   SNG_set_quality (sng, 0);
 
   return sng;
@@ -124,6 +147,7 @@ void SNG_reset (SNG * sng)
 
 void SNG_delete (SNG * sng)
 {
+  free (sng->raw);
   free (sng);
 }
 
@@ -262,22 +286,65 @@ static inline int16_t mix_output (SNG * sng)
   return (int16_t) sng->out;
 }
 
-int16_t SNG_calc (SNG * sng)
+/* Render a block of samples. With quality set this runs in three passes
+   of up to SNG_BLOCK output samples: work out how many chip steps fall in
+   each output sample, run the chip for the whole block, then average each
+   output sample over its steps (a box filter). */
+void SNG_calc_block (SNG * sng, int16_t * out, uint32_t n)
 {
+  uint32_t len, total, i, k;
+  const int16_t *raw;
+  int32_t sum;
+
   if (!sng->quality) {
-    update_output(sng);
-    return mix_output(sng);
+    while (n--) {
+      update_output(sng);
+      *out++ = mix_output(sng);
+    }
+    return;
   }
 
-  /* Simple rate converter */
-  while (sng->realstep > sng->sngtime)
-  {
-    sng->sngtime += sng->sngstep;
-    update_output(sng);
-  }
+  while (n) {
+    len = n < SNG_BLOCK ? n : SNG_BLOCK;
+    n -= len;
+
+    total = 0;
+    for (i = 0; i < len; i++) {
+      uint32_t t = sng->sngtime + sng->spb * sng->sngstep;
+      k = sng->spb;
+      if (t < sng->realstep) {
+        t += sng->sngstep;
+        k++;
+      }
+      sng->sngtime = t - sng->realstep;
+      sng->nstep[i] = k;
+      total += k;
+    }
 
-  sng->sngtime = sng->sngtime - sng->realstep;
+    for (i = 0; i < total; i++) {
+      update_output(sng);
+      sng->raw[i] = mix_output(sng);
+    }
 
-  return mix_output(sng);
+    raw = sng->raw;
+    for (i = 0; i < len; i++) {
+      k = sng->nstep[i];
+      /* Output rate above the step rate: hold the last value */
+      if (k) {
+        sum = 0;
+        while (k--)
+          sum += *raw++;
+        sng->out = (sum * sng->recip[sng->nstep[i] - sng->spb]) >> 15;
+      }
+      *out++ = sng->out;
+    }
+  }
+}
+
+int16_t SNG_calc (SNG * sng)
+{
+  int16_t s;
+  SNG_calc_block(sng, &s, 1);
+  return s;
 }
 
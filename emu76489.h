@@ -2,6 +2,9 @@
 #define _EMU76489_H_
 #include "stdint.h"
 
+/* Output samples rendered per pass of SNG_calc_block */
+#define SNG_BLOCK 256
+
 typedef struct __SNG {
 
   int32_t out;
@@ -28,6 +31,13 @@ typedef struct __SNG {
   uint32_t sngtime;
   uint32_t sngstep;
 
+/* block rate converter: each output sample takes spb or spb + 1 steps,
+   averaged with the matching reciprocal (Q15) */
+  uint32_t spb;
+  int32_t recip[2];
+  uint16_t nstep[SNG_BLOCK];
+  int16_t *raw;
+
   uint32_t adr;
   uint8_t ready;
   int16_t ch_out[4];
@@ -42,5 +52,6 @@ void SNG_set_quality(SNG *,uint32_t q);
 void SNG_writeIO(SNG *SNG, uint32_t val);
 uint8_t SNG_readReady(SNG *SNG);
 int16_t SNG_calc(SNG *);
+void SNG_calc_block(SNG *, int16_t *out, uint32_t n);
 
 #endif
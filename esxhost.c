@@ -0,0 +1,475 @@
+/*
+ *	esxDOS host directory passthrough
+ *
+ *	Serves the esxDOS RST 8 file API from a directory on the host so that
+ *	a program loading a file does one host read() rather than the sector
+ *	by sector FAT walk esxDOS does over the emulated SD or IDE card.
+ *
+ *	Paths are resolved as FAT does, ignoring case and accepting either
+ *	slash, and cannot leave the host directory. The drive is ignored,
+ *	everything is on the one host drive. Calls not handled here return 0
+ *	and go on to the real firmware (or the ROM error handler if there is
+ *	none).
+ *
+ *	Files opened here get handles from 0x80 up. Calls on any other handle
+ *	are the firmware's and go to it untouched, so files it opened itself
+ *	(from the emulated card) keep working alongside.
+ *
+ *	Ref: esxDOS 0.8.x API (z88dk arch/zx/esxdos.h)
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "esxhost.h"
+
+/* Call codes */
+#define M_GETSETDRV	0x89
+#define F_OPEN		0x9A
+#define F_CLOSE		0x9B
+#define F_SYNC		0x9C
+#define F_READ		0x9D
+#define F_WRITE		0x9E
+#define F_SEEK		0x9F
+#define F_GETPOS	0xA0
+#define F_FSTAT		0xA1
+#define F_STAT		0xAC
+#define F_UNLINK	0xAD
+
+/* F_OPEN modes */
+#define FA_READ		0x01
+#define FA_WRITE	0x02
+#define FA_OPEN_EX	0x00
+#define FA_CREATE_NEW	0x04
+#define FA_OPEN_AL	0x08
+#define FA_CREATE_AL	0x0C
+#define FA_USE_HEADER	0x40
+
+/* Error codes */
+#define ESX_ENOENT	5
+#define ESX_EIO		6
+#define ESX_EINVAL	7
+#define ESX_EACCES	8
+#define ESX_ENOSPC	9
+#define ESX_ENFILE	12
+#define ESX_EBADF	13
+#define ESX_EISDIR	16
+#define ESX_ENOTDIR	17
+#define ESX_EEXIST	18
+#define ESX_ENAMETOOLONG 21
+#define ESX_ERDONLY	24
+
+#define ESX_DRIVE	'*'
+#define ESX_FILES	16
+#define ESX_HANDLE	0x80	/* Host handles, clear of the firmware's own */
+#define ESX_PATH	1024
+
+struct esxhost {
+	char *root;
+	int fd[ESX_FILES];
+	uint8_t (*read)(uint16_t addr);
+	void (*write)(uint16_t addr, uint8_t val);
+	uint8_t buf[65536];
+	int trace;
+};
+
+struct esxhost *esxhost_create(const char *root,
+	uint8_t (*read)(uint16_t addr), void (*write)(uint16_t addr, uint8_t val))
+{
+	struct esxhost *esx = malloc(sizeof(struct esxhost));
+	struct stat st;
+	unsigned int i;
+
+	if (esx == NULL) {
+		fprintf(stderr, "Out of memory.\n");
+		exit(1);
+	}
+	if (stat(root, &st) == -1 || !S_ISDIR(st.st_mode)) {
+		fprintf(stderr, "esxhost: %s is not a directory.\n", root);
+		free(esx);
+		return NULL;
+	}
+	esx->root = strdup(root);
+	for (i = 0; i < ESX_FILES; i++)
+		esx->fd[i] = -1;
+	esx->read = read;
+	esx->write = write;
+	esx->trace = 0;
+	return esx;
+}
+
+void esxhost_free(struct esxhost *esx)
+{
+	unsigned int i;
+
+	if (esx == NULL)
+		return;
+	for (i = 0; i < ESX_FILES; i++)
+		if (esx->fd[i] != -1)
+			close(esx->fd[i]);
+	free(esx->root);
+	free(esx);
+}
+
+void esxhost_trace(struct esxhost *esx, int onoff)
+{
+	esx->trace = onoff;
+}
+
+static uint8_t esx_errno(void)
+{
+	switch (errno) {
+	case ENOENT:
+		return ESX_ENOENT;
+	case EACCES:
+	case EPERM:
+		return ESX_EACCES;
+	case EEXIST:
+		return ESX_EEXIST;
+	case EISDIR:
+		return ESX_EISDIR;
+	case ENOTDIR:
+		return ESX_ENOTDIR;
+	case ENOSPC:
+		return ESX_ENOSPC;
+	case EMFILE:
+	case ENFILE:
+		return ESX_ENFILE;
+	case EROFS:
+		return ESX_ERDONLY;
+	case ENAMETOOLONG:
+		return ESX_ENAMETOOLONG;
+	case EBADF:
+		return ESX_EBADF;
+	case EINVAL:
+		return ESX_EINVAL;
+	default:
+		return ESX_EIO;
+	}
+}
+
+/* Find name in directory dir ignoring case as FAT would. Returns the host
+   name in match or leaves it as given if there is no such entry */
+static void esx_match(const char *dir, const char *name, char *match, size_t len)
+{
+	DIR *d = opendir(dir);
+	struct dirent *de;
+
+	snprintf(match, len, "%s", name);
+	if (d == NULL)
+		return;
+	while ((de = readdir(d)) != NULL) {
+		if (strcasecmp(de->d_name, name) == 0) {
+			snprintf(match, len, "%s", de->d_name);
+			break;
+		}
+	}
+	closedir(d);
+}
+
+/*
+ *	Turn a guest path into a host one. The host path is built a component
+ *	at a time so that each is matched against what is on disk and '..'
+ *	stops at the top.
+ */
+static uint8_t esx_path(struct esxhost *esx, uint16_t addr, char *out)
+{
+	char name[256];
+	char part[256];
+	char match[256];
+	size_t rootlen = strlen(esx->root);
+	unsigned int n = 0;
+	char *p, *e;
+	uint8_t c;
+
+	while ((c = esx->read(addr++)) != 0) {
+		if (n == sizeof(name) - 1)
+			return ESX_ENAMETOOLONG;
+		name[n++] = c == '\\' ? '/' : c;
+	}
+	name[n] = 0;
+
+	strcpy(out, esx->root);
+	p = name;
+	/* Drive letter prefix */
+	if (p[0] && p[1] == ':')
+		p += 2;
+	while (*p) {
+		while (*p == '/')
+			p++;
+		if (*p == 0)
+			break;
+		e = strchr(p, '/');
+		if (e == NULL)
+			e = p + strlen(p);
+		snprintf(part, sizeof(part), "%.*s", (int)(e - p), p);
+		p = e;
+		if (strcmp(part, ".") == 0)
+			continue;
+		if (strcmp(part, "..") == 0) {
+			e = strrchr(out, '/');
+			if (e && e >= out + rootlen)
+				*e = 0;
+			continue;
+		}
+		esx_match(out, part, match, sizeof(match));
+		if (strlen(out) + strlen(match) + 2 > ESX_PATH)
+			return ESX_ENAMETOOLONG;
+		strcat(out, "/");
+		strcat(out, match);
+	}
+	return 0;
+}
+
+static int esx_handle(struct esxhost *esx, uint8_t h)
+{
+	if (h < ESX_HANDLE || h >= ESX_HANDLE + ESX_FILES)
+		return -1;
+	return esx->fd[h - ESX_HANDLE];
+}
+
+/* Build the 11 byte stat block: drive, device, attributes, DOS time and
+   date, size */
+static void esx_stat(struct esxhost *esx, struct stat *st, uint16_t addr)
+{
+	struct tm *tm = localtime(&st->st_mtime);
+	uint16_t t = 0, d = 0x21;
+	uint32_t size = st->st_size;
+	unsigned int i;
+
+	if (tm && tm->tm_year >= 80) {
+		t = (tm->tm_hour << 11) | (tm->tm_min << 5) | (tm->tm_sec / 2);
+		d = ((tm->tm_year - 80) << 9) | ((tm->tm_mon + 1) << 5) | tm->tm_mday;
+	}
+	esx->write(addr++, ESX_DRIVE);
+	esx->write(addr++, 0);
+	esx->write(addr++, S_ISDIR(st->st_mode) ? 0x10 : 0x20);
+	esx->write(addr++, t);
+	esx->write(addr++, t >> 8);
+	esx->write(addr++, d);
+	esx->write(addr++, d >> 8);
+	for (i = 0; i < 4; i++) {
+		esx->write(addr++, size);
+		size >>= 8;
+	}
+}
+
+/* Skip a +3DOS header, handing the 8 bytes of BASIC header to the caller */
+static void esx_header(struct esxhost *esx, int fd, uint16_t addr)
+{
+	uint8_t h[128];
+	unsigned int i;
+
+	if (read(fd, h, 128) == 128 && memcmp(h, "PLUS3DOS\032", 9) == 0) {
+		for (i = 0; i < 8; i++)
+			esx->write(addr + i, h[15 + i]);
+	} else
+		lseek(fd, 0L, SEEK_SET);
+}
+
+static uint8_t esx_open(struct esxhost *esx, Z80Context *cpu, uint16_t name)
+{
+	char path[ESX_PATH];
+	uint8_t mode = cpu->R1.br.B;
+	int flags;
+	unsigned int h;
+	uint8_t err;
+	int fd;
+
+	for (h = 0; h < ESX_FILES; h++)
+		if (esx->fd[h] == -1)
+			break;
+	if (h == ESX_FILES)
+		return ESX_ENFILE;
+	err = esx_path(esx, name, path);
+	if (err)
+		return err;
+
+	switch (mode & (FA_READ | FA_WRITE)) {
+	case FA_WRITE:
+		flags = O_WRONLY;
+		break;
+	case FA_READ | FA_WRITE:
+		flags = O_RDWR;
+		break;
+	default:
+		flags = O_RDONLY;
+	}
+	switch (mode & FA_CREATE_AL) {
+	case FA_OPEN_AL:
+		flags |= O_CREAT;
+		break;
+	case FA_CREATE_NEW:
+		flags |= O_CREAT | O_EXCL;
+		break;
+	case FA_CREATE_AL:
+		flags |= O_CREAT | O_TRUNC;
+		break;
+	}
+
+	fd = open(path, flags, 0666);
+	if (esx->trace)
+		fprintf(stderr, "esxhost: open %s %02X = %d\n", path, mode, fd);
+	if (fd == -1)
+		return esx_errno();
+	if ((mode & FA_USE_HEADER) && !(flags & O_CREAT))
+		esx_header(esx, fd, cpu->R1.wr.DE);
+	esx->fd[h] = fd;
+	cpu->R1.br.A = ESX_HANDLE + h;
+	return 0;
+}
+
+static uint8_t esx_read(struct esxhost *esx, Z80Context *cpu, int fd, uint16_t addr)
+{
+	unsigned int len = cpu->R1.wr.BC;
+	unsigned int i;
+	ssize_t n;
+
+	n = read(fd, esx->buf, len);
+	if (n == -1)
+		return esx_errno();
+	for (i = 0; i < (unsigned int)n; i++)
+		esx->write(addr + i, esx->buf[i]);
+	cpu->R1.wr.BC = n;
+	cpu->R1.wr.DE = n;
+	cpu->R1.wr.HL = addr + n;
+	return 0;
+}
+
+static uint8_t esx_write(struct esxhost *esx, Z80Context *cpu, int fd, uint16_t addr)
+{
+	unsigned int len = cpu->R1.wr.BC;
+	unsigned int i;
+	ssize_t n;
+
+	for (i = 0; i < len; i++)
+		esx->buf[i] = esx->read(addr + i);
+	n = write(fd, esx->buf, len);
+	if (n == -1)
+		return esx_errno();
+	cpu->R1.wr.BC = n;
+	cpu->R1.wr.DE = n;
+	cpu->R1.wr.HL = addr + n;
+	return 0;
+}
+
+static void esx_setpos(Z80Context *cpu, off_t pos)
+{
+	cpu->R1.wr.BC = pos >> 16;
+	cpu->R1.wr.DE = pos;
+}
+
+static uint8_t esx_seek(Z80Context *cpu, int fd, unsigned int whence)
+{
+	off_t off = ((uint32_t)cpu->R1.wr.BC << 16) | cpu->R1.wr.DE;
+	off_t pos;
+
+	switch (whence) {
+	case 0:
+		pos = lseek(fd, off, SEEK_SET);
+		break;
+	case 1:
+		pos = lseek(fd, off, SEEK_CUR);
+		break;
+	case 2:
+		pos = lseek(fd, -off, SEEK_CUR);
+		break;
+	default:
+		return ESX_EINVAL;
+	}
+	if (pos == -1)
+		return esx_errno();
+	esx_setpos(cpu, pos);
+	return 0;
+}
+
+int esxhost_call(struct esxhost *esx, Z80Context *cpu, uint8_t code, unsigned dot)
+{
+	uint16_t ptr = dot ? cpu->R1.wr.HL : cpu->R1.wr.IX;
+	char path[ESX_PATH];
+	struct stat st;
+	uint8_t err = 0;
+	int fd = -1;
+
+	switch (code) {
+	case F_CLOSE:
+	case F_SYNC:
+	case F_READ:
+	case F_WRITE:
+	case F_SEEK:
+	case F_GETPOS:
+	case F_FSTAT:
+		/* Not one of ours, so it belongs to the firmware */
+		fd = esx_handle(esx, cpu->R1.br.A);
+		if (fd == -1)
+			return 0;
+		break;
+	}
+
+	switch (code) {
+	case M_GETSETDRV:
+		if (cpu->R1.br.A == 0)
+			cpu->R1.br.A = ESX_DRIVE;
+		break;
+	case F_OPEN:
+		err = esx_open(esx, cpu, ptr);
+		break;
+	case F_CLOSE:
+		close(fd);
+		esx->fd[cpu->R1.br.A - ESX_HANDLE] = -1;
+		break;
+	case F_SYNC:
+		fsync(fd);
+		break;
+	case F_READ:
+		err = esx_read(esx, cpu, fd, ptr);
+		break;
+	case F_WRITE:
+		err = esx_write(esx, cpu, fd, ptr);
+		break;
+	case F_SEEK:
+		err = esx_seek(cpu, fd, dot ? cpu->R1.br.L : cpu->R1.br.IXl);
+		break;
+	case F_GETPOS:
+		esx_setpos(cpu, lseek(fd, 0L, SEEK_CUR));
+		break;
+	case F_FSTAT:
+		if (fstat(fd, &st) == -1)
+			err = esx_errno();
+		else
+			esx_stat(esx, &st, ptr);
+		break;
+	case F_STAT:
+		err = esx_path(esx, ptr, path);
+		if (err == 0 && stat(path, &st) == -1)
+			err = esx_errno();
+		if (err == 0)
+			esx_stat(esx, &st, cpu->R1.wr.DE);
+		break;
+	case F_UNLINK:
+		err = esx_path(esx, ptr, path);
+		if (err == 0 && unlink(path) == -1)
+			err = esx_errno();
+		break;
+	default:
+		return 0;
+	}
+	if (esx->trace)
+		fprintf(stderr, "esxhost: call %02X A %02X err %u\n",
+			code, cpu->R1.br.A, err);
+	if (err) {
+		cpu->R1.br.A = err;
+		cpu->R1.br.F |= F_C;
+	} else
+		cpu->R1.br.F &= ~F_C;
+	return 1;
+}
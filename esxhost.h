@@ -0,0 +1,22 @@
+#ifndef ESXHOST_H
+#define ESXHOST_H
+
+#include <stdint.h>
+#include "libz80/z80.h"
+
+/*
+ *	esxDOS RST 8 file calls served from a host directory. The machine
+ *	intercepts RST 8 and passes the call code that follows it here; a
+ *	non zero return means the call was handled and the registers hold
+ *	the result, zero that it should go on to the ROM or esxDOS as usual.
+ *	dot is set when the caller is a dot command (pointers in HL not IX).
+ */
+struct esxhost;
+
+extern struct esxhost *esxhost_create(const char *root,
+	uint8_t (*read)(uint16_t addr), void (*write)(uint16_t addr, uint8_t val));
+extern void esxhost_free(struct esxhost *esx);
+extern void esxhost_trace(struct esxhost *esx, int onoff);
+extern int esxhost_call(struct esxhost *esx, Z80Context *cpu, uint8_t code, unsigned dot);
+
+#endif
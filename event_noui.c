@@ -14,6 +14,11 @@ unsigned ui_event(void)
 	return 0;
 }
 
+unsigned ui_generation(void)
+{
+	return 0;
+}
+
 void ui_init(void)
 {
 }
@@ -43,16 +43,43 @@ static void handler(SDL_Event *ev)
 	}
 }
 
+/*
+ *	Boards call this far more often than anything can change so only
+ *	ask SDL for events once a millisecond. SDL wants the events handled
+ *	on the thread that owns the windows so we can't push this off onto
+ *	another thread. Anyone caching input state can compare the
+ *	generation to see if anything has happened since they looked.
+ */
+
+#define UI_POLL_MS	1
+
+static unsigned ui_quit;
+static unsigned ui_gen;
+static Uint32 ui_last;
+
 unsigned ui_event(void)
 {
 	SDL_Event ev;
+	Uint32 now;
+
+	if (ui_quit)
+		return 1;
+	now = SDL_GetTicks();
+	if (now - ui_last < UI_POLL_MS)
+		return 0;
+	ui_last = now;
+
 	while (SDL_PollEvent(&ev)) {
+		ui_gen++;
 		switch(ev.type) {
 		case SDL_WINDOWEVENT:
-			if (ev.window.event == SDL_WINDOWEVENT_CLOSE)
+			if (ev.window.event == SDL_WINDOWEVENT_CLOSE) {
+				ui_quit = 1;
 				return 1;
+			}
 			break;
 		case SDL_QUIT:
+			ui_quit = 1;
 			return 1;
 		}
 		handler(&ev);
@@ -60,6 +87,11 @@ unsigned ui_event(void)
 	return 0;
 }
 
+unsigned ui_generation(void)
+{
+	return ui_gen;
+}
+
 void ui_init(void)
 {
 	if (SDL_Init(SDL_INIT_EVERYTHING) < 0) {
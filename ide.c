@@ -15,11 +15,18 @@
  *
  *	You should have received a copy of the GNU General Public License
  *	along with IDE-emu.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *	New images are sparse. Space the guest has never written, or has
+ *	trimmed or erased, is a hole in the file and reads back as zero.
  */
 
+/* fallocate() */
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <string.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -60,6 +67,7 @@
 #define DCL_SRST	4
 #define DCL_NIEN	2
 
+#define IDE_CMD_DSM		0x06
 #define IDE_CMD_CALIB		0x10
 #define IDE_CMD_READ		0x20
 #define IDE_CMD_READ_NR		0x21
@@ -70,9 +78,12 @@
 #define IDE_CMD_SEEK		0x70
 #define IDE_CMD_EDD		0x90
 #define IDE_CMD_INTPARAMS	0x91
+#define IDE_CMD_CFA_ERASE	0xC0
 #define IDE_CMD_IDENTIFY	0xEC
 #define IDE_CMD_SETFEATURES	0xEF
 
+#define DSM_TRIM	1
+
 const uint8_t ide_magic[8] = {
 	'1','D','E','D','1','5','C','0'
 };
@@ -456,12 +467,52 @@ static void ide_set_error(struct ide_drive *d)
 	completed(&d->taskfile);
 }
 
+static uint32_t ide_total_sectors(struct ide_drive *d)
+{
+	return d->cylinders * d->heads * d->sectors;
+}
+
+/* Fill pos to end with zeroes, as a hole reads */
+static int ide_fill_zero(struct ide_drive *d, off_t pos, off_t end)
+{
+	uint8_t buf[4096];
+	size_t n;
+
+	memset(buf, 0, sizeof(buf));
+	while (pos < end) {
+		n = end - pos > (off_t)sizeof(buf) ? sizeof(buf) : end - pos;
+		if (pwrite(d->fd, buf, n, pos) != (ssize_t)n)
+			return -1;
+		pos += n;
+	}
+	return 0;
+}
+
+/*
+ *	Give trimmed or erased sectors back to the host by punching them out
+ *	of the image. They then read as zero, the same as the never written
+ *	space of a fresh image. Where the file system can't punch holes the
+ *	zeroes are written instead.
+ */
+static int ide_discard(struct ide_drive *d, off_t sector, unsigned int count)
+{
+	off_t start = sector * 512;
+	off_t end = start + count * 512;
+
+#ifdef FALLOC_FL_PUNCH_HOLE
+	if (fallocate(d->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+			start, end - start) == 0)
+		return 0;
+#endif
+	return ide_fill_zero(d, start, end);
+}
+
 static int ide_read_sector(struct ide_drive *d)
 {
 	int len;
 
 	d->dptr = d->data;
-	if ((len = read(d->fd, d->data, 512)) != 512) {
+	if ((len = pread(d->fd, d->data, 512, 512 * d->offset)) != 512) {
 		perror("ide_read_sector");
 		d->taskfile.status |= ST_ERR;
 		d->taskfile.status &= ~ST_DSC;
@@ -469,7 +520,7 @@ static int ide_read_sector(struct ide_drive *d)
 		return -1;
 	}
 	HEXDUMP_DATA(d->data)
-	d->offset += 512;
+	d->offset++;
 	return 0;
 }
 
@@ -478,17 +529,45 @@ static int ide_write_sector(struct ide_drive *d)
 	int len;
 
 	d->dptr = d->data;
-	if ((len = write(d->fd, d->data, 512)) != 512) {
+	if ((len = pwrite(d->fd, d->data, 512, 512 * d->offset)) != 512) {
 		d->taskfile.status |= ST_ERR;
 		d->taskfile.status &= ~ST_DSC;
 		ide_xlate_errno(&d->taskfile, len);
 		return -1;
 	}
 	HEXDUMP_DATA(d->data)
-	d->offset += 512;
+	d->offset++;
 	return 0;
 }
 
+/*
+ *	A sector of DATA SET MANAGEMENT ranges: 64 entries of a 48bit LBA and
+ *	a 16bit count. Zero counts are padding.
+ */
+static void ide_trim_sector(struct ide_drive *d)
+{
+	uint8_t *p = d->data;
+	uint64_t lba;
+	unsigned int len;
+	unsigned int i;
+
+	d->dptr = d->data;
+	for (i = 0; i < 64; i++, p += 8) {
+		lba = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint64_t)p[3] << 24) |
+			((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40);
+		len = p[6] | (p[7] << 8);
+		if (len == 0)
+			continue;
+		if (lba + len > ide_total_sectors(d)) {
+			d->taskfile.status |= ST_ERR;
+			d->taskfile.error |= ERR_ABRT;
+			continue;
+		}
+		if (ide_discard(d, 2 + lba, len) < 0)
+			ide_xlate_errno(&d->taskfile, -1);
+	}
+}
+
 static uint16_t ide_data_in(struct ide_drive *d, int len)
 {
 	uint16_t v;
@@ -538,7 +617,9 @@ static void ide_data_out(struct ide_drive *d, uint16_t v, int len)
 			d->taskfile.data = v >> 8;
 		}
 		if (d->dptr == d->data + 512) {
-			if (ide_write_sector(d) < 0) {
+			if (d->trim)
+				ide_trim_sector(d);
+			else if (ide_write_sector(d) < 0) {
 				ide_set_error(d);
 				return;
 			}
@@ -553,12 +634,52 @@ static void ide_data_out(struct ide_drive *d, uint16_t v, int len)
 	}
 }
 
+/* Only the TRIM form is defined. We take the ranges by PIO */
+static void cmd_dsm_complete(struct ide_taskfile *tf)
+{
+	struct ide_drive *d = tf->drive;
+	if (d->failed) {
+		drive_failed(tf);
+		return;
+	}
+	if (!(tf->feature & DSM_TRIM) || !d->lba) {
+		tf->status |= ST_ERR;
+		tf->error |= ERR_ABRT;
+		completed(tf);
+		return;
+	}
+	d->length = tf->count ? tf->count : 256;
+	d->trim = 1;
+	data_out_state(tf);
+}
+
+/* CFA ERASE SECTORS: the sectors become blank */
+static void cmd_erasesectors_complete(struct ide_taskfile *tf)
+{
+	struct ide_drive *d = tf->drive;
+	if (d->failed) {
+		drive_failed(tf);
+		return;
+	}
+	d->offset = xlate_block(tf);
+	/* 0 = 256 sectors */
+	d->length = tf->count ? tf->count : 256;
+	if (d->offset == -1 || d->offset + d->length > 2 + ide_total_sectors(d)) {
+		tf->status |= ST_ERR;
+		tf->error |= ERR_IDNF;
+	} else if (ide_discard(d, d->offset, d->length) < 0)
+		ide_xlate_errno(tf, -1);
+	tf->status |= ST_DSC;
+	completed(tf);
+}
+
 static void ide_issue_command(struct ide_taskfile *t)
 {
 	t->status &= ~(ST_ERR|ST_DRDY);
 	t->status |= ST_BSY;
 	t->error = 0;
 	t->drive->state = IDE_CMD;
+	t->drive->trim = 0;
 
 	/* We could complete with delays but don't do so yet */
 	switch(t->command) {
@@ -586,6 +707,12 @@ static void ide_issue_command(struct ide_taskfile *t)
 		case IDE_CMD_WRITE_NR:	/* 0x31 */
 			cmd_writesectors_complete(t);
 			break;
+		case IDE_CMD_DSM:	/* 0x06 */
+			cmd_dsm_complete(t);
+			break;
+		case IDE_CMD_CFA_ERASE:	/* 0xC0 */
+			cmd_erasesectors_complete(t);
+			break;
 		default:
 			if ((t->command & 0xF0) == IDE_CMD_CALIB)	/* 1x */
 				cmd_recalibrate_complete(t);
@@ -934,12 +1061,15 @@ int ide_make_drive(uint8_t type, int fd)
 	ident[58] = le16(sectors >> 16);
 	ident[60] = ident[57];
 	ident[61] = ident[58];
+	ident[69] = le16((1 << 14) | (1 << 5));	/* Trimmed sectors read as zero */
+	ident[83] = le16((1 << 14) | (1 << 2));	/* CFA feature set */
+	ident[105] = le16(1);		/* One sector of TRIM ranges a command */
+	ident[169] = le16(1);		/* DATA SET MANAGEMENT TRIM */
 	if (write(fd, ident, 512) != 512)
 		return -1;
 
-	memset(ident, 0xE5, 512);
-	while(sectors--)
-		if (write(fd, ident, 512) != 512)
-			return -1;
+	/* The data area is left as a hole that reads as zero until written */
+	if (ftruncate(fd, 512 * (2 + (off_t)sectors)) == -1)
+		return -1;
 	return 0;
 }
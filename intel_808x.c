@@ -0,0 +1,1582 @@
+/*
+  Intel 8080 emulator in C
+  Written by Mike Chambers, April 2018
+
+  Use this code for whatever you want. I don't care. It's officially public domain.
+  Credit would be appreciated.
+
+  Modified to sort of emulate the Intel 8085, Alan Cox 2019.
+
+  The 8085 emulation is WIP and the 8085 undocumented instruction behaviour
+  is exactly that so may not be entirely correct.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ *	The 8080 and 8085 share this core. It is not built by itself but
+ *	included by intel_8080_emulator.c or intel_8085_emulator.c, which
+ *	define I8080 or I8085 and map the i808x_ names onto the public
+ *	i8080_ or i8085_ ones.
+ */
+
+#if !defined(I8080) && !defined(I8085)
+#error "define I8080 or I8085"
+#endif
+
+static char *i808x_disassemble(uint16_t addr);
+
+#define reg16_PSW (((uint16_t)cpu.reg8[A] << 8) | (uint16_t)cpu.reg8[FLAGS])
+#define reg16_BC (((uint16_t)cpu.reg8[B] << 8) | (uint16_t)cpu.reg8[C])
+#define reg16_DE (((uint16_t)cpu.reg8[D] << 8) | (uint16_t)cpu.reg8[E])
+#define reg16_HL (((uint16_t)cpu.reg8[H] << 8) | (uint16_t)cpu.reg8[L])
+
+/* All of the processor state */
+struct i808x_cpu {
+	uint8_t reg8[9];
+	uint16_t sp, pc;
+	uint8_t inte;
+	uint8_t intpend;
+	uint8_t halted;
+#ifdef I8085
+	uint8_t im;
+	uint8_t intprotect;	/* EI takes effect after the next instruction */
+#endif
+};
+
+#ifdef I8085
+static struct i808x_cpu cpu = {
+	.im = 0x07	/* Verified with a Tundra CA80C85B */
+};
+#else
+static struct i808x_cpu cpu;
+#endif
+
+/* Cycle counts where the two processors differ */
+#ifdef I8085
+#define CYC(c80, c85)	(c85)
+#else
+#define CYC(c80, c85)	(c80)
+#endif
+
+#define set_S() cpu.reg8[FLAGS] |= 0x80
+#define set_Z() cpu.reg8[FLAGS] |= 0x40
+#define set_AC() cpu.reg8[FLAGS] |= 0x10
+#define set_P() cpu.reg8[FLAGS] |= 0x04
+#define set_C() cpu.reg8[FLAGS] |= 0x01
+#define clear_S() cpu.reg8[FLAGS] &= 0x7F
+#define clear_Z() cpu.reg8[FLAGS] &= 0xBF
+#define clear_AC() cpu.reg8[FLAGS] &= 0xEF
+#define clear_P() cpu.reg8[FLAGS] &= 0xFB
+#define clear_C() cpu.reg8[FLAGS] &= 0xFE
+#define test_S() (cpu.reg8[FLAGS] & 0x80)
+#define test_Z() (cpu.reg8[FLAGS] & 0x40)
+#define test_AC() (cpu.reg8[FLAGS] & 0x10)
+#define test_P() (cpu.reg8[FLAGS] & 0x04)
+#define test_C() (cpu.reg8[FLAGS] & 0x01)
+
+#ifdef I8085
+#define set_K() cpu.reg8[FLAGS] |= 0x20
+#define set_V() cpu.reg8[FLAGS] |= 0x02
+#define clear_K() cpu.reg8[FLAGS] &= 0xDF
+#define clear_V() cpu.reg8[FLAGS] &= 0xFD
+#define test_K() (cpu.reg8[FLAGS] & 0x20)
+#define test_V() (cpu.reg8[FLAGS] & 0x02)
+#else
+/* The 8080 has no V or K flag, so the 8085 flag updates compile away */
+#define set_K() do { } while (0)
+#define set_V() do { } while (0)
+#define clear_K() do { } while (0)
+#define clear_V() do { } while (0)
+#define calc_Vadd(a, b, c) do { } while (0)
+#define calc_Vadd16(a, b) do { } while (0)
+#define calc_Vsub(a, b, c) do { } while (0)
+#define calc_K(r) do { } while (0)
+#define calc_KVlogic(v) do { } while (0)
+#endif
+
+/* Bits 1, 3 and 5 of the flags as they go to and from the stack */
+#ifdef I8085
+#define PSW_OUT(f)	(f)
+#define PSW_IN(f)	((f) & 0xF7)
+#else
+#define PSW_OUT(f)	(((f) | 0x02) & 0xD7)
+#define PSW_IN(f)	(((f) | 0x02) & 0xD7)
+#endif
+
+FILE *i808x_log;
+
+/* S, Z and P flag bits for each possible result */
+static const uint8_t szp[0x100] = {
+	0x44, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04,
+	0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00,
+	0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00,
+	0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04,
+	0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00,
+	0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04,
+	0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04,
+	0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x00,
+	0x80, 0x84, 0x84, 0x80, 0x84, 0x80, 0x80, 0x84, 0x84, 0x80, 0x80, 0x84, 0x80, 0x84, 0x84, 0x80,
+	0x84, 0x80, 0x80, 0x84, 0x80, 0x84, 0x84, 0x80, 0x80, 0x84, 0x84, 0x80, 0x84, 0x80, 0x80, 0x84,
+	0x84, 0x80, 0x80, 0x84, 0x80, 0x84, 0x84, 0x80, 0x80, 0x84, 0x84, 0x80, 0x84, 0x80, 0x80, 0x84,
+	0x80, 0x84, 0x84, 0x80, 0x84, 0x80, 0x80, 0x84, 0x84, 0x80, 0x80, 0x84, 0x80, 0x84, 0x84, 0x80,
+	0x84, 0x80, 0x80, 0x84, 0x80, 0x84, 0x84, 0x80, 0x80, 0x84, 0x84, 0x80, 0x84, 0x80, 0x80, 0x84,
+	0x80, 0x84, 0x84, 0x80, 0x84, 0x80, 0x80, 0x84, 0x84, 0x80, 0x80, 0x84, 0x80, 0x84, 0x84, 0x80,
+	0x80, 0x84, 0x84, 0x80, 0x84, 0x80, 0x80, 0x84, 0x84, 0x80, 0x80, 0x84, 0x80, 0x84, 0x84, 0x80,
+	0x84, 0x80, 0x80, 0x84, 0x80, 0x84, 0x84, 0x80, 0x80, 0x84, 0x84, 0x80, 0x84, 0x80, 0x80, 0x84
+};
+
+/* Register pairs 0-2 are B:C, D:E and H:L which sit next to each other
+   in cpu.reg8[], high byte first, so index rather than switch */
+static inline uint16_t read_RP(uint8_t rp) {
+	if (rp == 3)
+		return cpu.sp;
+	rp <<= 1;
+	return ((uint16_t)cpu.reg8[rp] << 8) | cpu.reg8[rp + 1];
+}
+
+static inline uint16_t read_RP_PUSHPOP(uint8_t rp) {
+	if (rp == 3)
+		return ((uint16_t)cpu.reg8[A] << 8) | PSW_OUT(cpu.reg8[FLAGS]);
+	rp <<= 1;
+	return ((uint16_t)cpu.reg8[rp] << 8) | cpu.reg8[rp + 1];
+}
+
+static inline void write_RP(uint8_t rp, uint8_t lb, uint8_t hb) {
+	if (rp == 3) {
+		cpu.sp = (uint16_t)lb | ((uint16_t)hb << 8);
+		return;
+	}
+	rp <<= 1;
+	cpu.reg8[rp] = hb;
+	cpu.reg8[rp + 1] = lb;
+}
+
+static inline void write16_RP(uint8_t rp, uint16_t value) {
+	write_RP(rp, value, value >> 8);
+}
+
+static inline void write16_RP_PUSHPOP(uint8_t rp, uint16_t value) {
+	if (rp == 3) {
+		cpu.reg8[FLAGS] = PSW_IN(value & 0x00FF);
+		cpu.reg8[A] = value >> 8;
+		return;
+	}
+	write_RP(rp, value, value >> 8);
+}
+
+static inline void calc_SZP(uint8_t value) {
+	cpu.reg8[FLAGS] = (cpu.reg8[FLAGS] & 0x3B) | szp[value];
+}
+
+void calc_AC(uint8_t val1, uint8_t val2) {
+	if (((val1 & 0x0F) + (val2 & 0x0F)) > 0x0F) {
+		set_AC();
+	} else {
+		clear_AC();
+	}
+}
+
+void calc_AC_carry(uint8_t val1, uint8_t val2) {
+	if (((val1 & 0x0F) + (val2 & 0x0F)) >= 0x0F) {
+		set_AC();
+	} else {
+		clear_AC();
+	}
+}
+
+void calc_subAC(int8_t val1, uint8_t val2) {
+	if ((val2 & 0x0F) <= (val1 & 0x0F)) {
+		set_AC();
+	} else {
+		clear_AC();
+	}
+}
+
+void calc_subAC_borrow(int8_t val1, uint8_t val2) {
+	if ((val2 & 0x0F) < (val1 & 0x0F)) {
+		set_AC();
+	} else {
+		clear_AC();
+	}
+}
+
+/* The 8085 always sets AC on an AND, the 8080 it's an or of bit 3 of
+   the values */
+static inline void calc_andAC(uint8_t val1, uint8_t val2) {
+#ifdef I8085
+	set_AC();
+#else
+	if ((val1 | val2) & 0x08) set_AC(); else clear_AC();
+#endif
+}
+
+#ifdef I8085
+
+void calc_Vadd(int8_t val1, int8_t val2, int c)
+{
+	/* Did adding bits 0-6 together carry into bit 7 ? */
+	uint8_t c6 = ((val1 & 0x7F) + (val2 & 0x7F) + c) & 0x80;
+	/* Did adding bits 0-7 together carry into bit 8 ? */
+	uint16_t c7 = ((uint16_t)val1 + val2 + c) & 0x100;
+	/* V is the xor of the two carries */
+	/* Annoying C has no ^^ operator */
+	if ((!!c6) ^ (!!c7))
+		set_V();
+	else
+		clear_V();
+}
+
+/* 16bit maths is actually 8bit maths done twice */
+void calc_Vadd16(int16_t val1, int16_t val2)
+{
+	/* Internal carry of the first add */
+	int c = ((val1 & 0xFF) + (val2 & 0xFF)) & 0x100;
+	/* Fed into the carry of the following adc */
+	calc_Vadd(val1 >> 8, val2 >> 8, !!c);
+}
+
+void calc_Vsub(int8_t val1, int8_t val2, int c)
+{
+	uint8_t c6 = ((val1 & 0x7F) - (val2 & 0x7F) - c) & 0x80;
+	uint16_t c7 = ((val1 - val2 - c) & 0x100) >> 1;
+	if (c6 ^ c7)
+		set_V();
+	else
+		clear_V();
+}
+
+void calc_Vsub16(int16_t val1, int16_t val2)
+{
+	int c = (val1 & 0xFF) < (val2 & 0xFF);
+	calc_Vsub(val1 >> 8, val2 >> 8, c);
+}
+
+void calc_K(int8_t r)
+{
+	if ((!!test_V()) ^ !!(r & 0x80))
+		set_K();
+	else
+		clear_K();
+}
+
+void calc_KVlogic(uint8_t val)
+{
+	clear_V();
+	calc_K(val);
+}
+#endif
+
+/* Condition codes are NZ, Z, NC, C, PO, PE, P, M: a flag and a sense */
+static const uint8_t cond_flag[4] = { 0x40, 0x01, 0x04, 0x80 };
+
+static inline uint8_t test_cond(uint8_t code) {
+	return !(cpu.reg8[FLAGS] & cond_flag[code >> 1]) == !(code & 1);
+}
+
+void i808x_push(uint16_t value) {
+	i808x_write(--cpu.sp, value >> 8);
+	i808x_write(--cpu.sp, (uint8_t)value);
+}
+
+uint16_t i808x_pop(void) {
+	uint16_t temp;
+	temp = i808x_read(cpu.sp++);
+	temp |= (uint16_t)i808x_read(cpu.sp++) << 8;
+	return temp;
+}
+
+void i808x_set_int(int n)
+{
+	cpu.intpend |= n;
+}
+
+void i808x_clear_int(int n)
+{
+	cpu.intpend &= ~n;
+}
+
+
+void i808x_jump(uint16_t addr) {
+	cpu.pc = addr;
+}
+
+void i808x_reset(void) {
+	cpu.pc = cpu.sp = 0x0000;
+	//cpu.reg8[FLAGS] = 0x02;
+}
+
+void i808x_write_reg8(reg_t reg, uint8_t value) {
+	if (reg == M) {
+		i808x_write(reg16_HL, value);
+	} else {
+		cpu.reg8[reg] = value;
+	}
+}
+
+uint8_t i808x_read_reg8(reg_t reg) {
+	if (reg == M) {
+		return i808x_read(reg16_HL);
+	} else {
+		return cpu.reg8[reg];
+	}
+}
+
+uint16_t i808x_read_reg16(reg_t reg) {
+	switch (reg) {
+		case AF: return reg16_PSW;
+		case BC: return reg16_BC;
+		case DE: return reg16_DE;
+		case HL: return reg16_HL;
+		case SP: return cpu.sp;
+		case PC: return cpu.pc;
+		default:
+			fprintf(stderr, "bogus rr16\n");
+	}
+	return 0;
+}
+
+void i808x_write_reg16(reg_t reg, uint16_t value) {
+	switch (reg) {
+		case AF: cpu.reg8[A] = value>>8; cpu.reg8[FLAGS] = value; break;
+		case BC: cpu.reg8[B] = value>>8; cpu.reg8[C] = value; break;
+		case DE: cpu.reg8[D] = value>>8; cpu.reg8[E] = value; break;
+		case HL: cpu.reg8[H] = value>>8; cpu.reg8[L] = value; break;
+		case SP: cpu.sp = value; break;
+		case PC: cpu.pc = value; break;
+		default:
+			fprintf(stderr, "bogus rr16\n");
+	}
+}
+
+static char *i808x_flags(uint8_t v)
+{
+	static char buf[9];
+	char *fp = "SZKA-PVC";
+	char *t = buf;
+
+	strcpy(buf, "--------");
+
+	while(*fp) {
+		if (v & 0x80)
+			*t = *fp;
+		t++;
+		fp++;
+		v <<= 1;
+	}
+	return buf;
+}
+
+int i808x_exec(int cycles) {
+	uint8_t opcode, temp8, reg, reg2;
+	uint16_t temp16;
+	uint32_t temp32;
+#ifdef I8085
+	uint8_t vec;
+#endif
+
+	while (cycles > 0) {
+#ifdef I8085
+		/* TRAP is edge and level - must see the edge and it held */
+		if (cpu.intpend & INT_NMI) {	/* TRAP - NMI */
+			cpu.inte = 0;
+			cpu.intpend &= ~8;
+			if (cpu.halted)
+				i808x_push(cpu.pc + 1);
+			else
+				i808x_push(cpu.pc);
+			cpu.pc = 0x24;
+			cycles -= 12; /* Check me */
+			if (i808x_log)
+				fprintf(i808x_log, "NMI taken.\n");
+		/* The others are level except 0x3C which is positive edge.
+		   The 8085 prioritizes so we must do likewise */
+		} else if (cpu.inte && cpu.intprotect == 0 && (cpu.intpend & ~cpu.im)) {
+			cpu.inte = 0;
+			temp8 = cpu.intpend & ~cpu.im;
+
+			if (i808x_log)
+				fprintf(i808x_log, "IRQ taken (%x)\n", temp8);
+
+			if (temp8 & INT_RST75) {
+				/* FIXME: we should temporarily mask not
+				   clear here. We clear in SIM */
+				vec = 0x3C;
+				cpu.intpend &= ~INT_RST75;
+			} else if (temp8 & INT_RST65)
+				vec = 0x34;
+			else if (temp8 & INT_RST55)
+				vec = 0x2C;
+			else
+				vec = 0x38;
+			if (cpu.halted)
+				i808x_push(cpu.pc + 1);
+			else
+				i808x_push(cpu.pc);
+			cpu.pc = vec;
+			cycles -= 12;	/* Check me */
+		}
+		cpu.intprotect = 0;
+		cpu.halted = 0;
+
+		opcode = i808x_read(cpu.pc);
+
+		if (i808x_log)
+			fprintf(i808x_log, "%04X : %02X %02X %02X : %6s %02X %04X %04X %04X %04X %s\n",
+				cpu.pc, i808x_debug_read(cpu.pc), i808x_debug_read(cpu.pc + 1), i808x_debug_read(cpu.pc + 2),
+				i808x_flags(cpu.reg8[FLAGS]), cpu.reg8[A], reg16_BC, reg16_DE, reg16_HL, cpu.sp,
+					i808x_disassemble(cpu.pc));
+
+		cpu.pc++;
+#else
+		if (cpu.intpend & INT_NMI) {
+			cpu.inte = 0;
+			cpu.intpend &= ~INT_NMI;
+			i808x_push(cpu.pc + cpu.halted);
+			cpu.pc = 0x24;
+			cycles -= 12;	/* FIXME: 8080 clocking check */
+			if (i808x_log)
+				fprintf(i808x_log, "NMI taken.\n");
+		} else if (cpu.inte && (cpu.intpend & INT_IRQ)) {
+			cpu.inte = 0;
+			if (i808x_log)
+				fprintf(i808x_log, "IRQ taken\n");
+			opcode = i808x_get_vector();
+			if (i808x_log)
+				fprintf(i808x_log, "IRQ taken (vector op %02X)\n", opcode);
+			if (cpu.halted)
+				cpu.pc++;
+			cycles -= 12;	/* Check 8080 timings */
+			if (i808x_log)
+				fprintf(i808x_log, "IRQ opcode %02X executed , PC was %04X\n",
+					opcode, cpu.pc);
+		} else {
+			opcode = i808x_read(cpu.pc);
+			if (i808x_log)
+				fprintf(i808x_log, "%04X : %02X %02X %02X : %6s %02X %04X %04X %04X %04X %s\n",
+					cpu.pc, i808x_debug_read(cpu.pc), i808x_debug_read(cpu.pc + 1), i808x_debug_read(cpu.pc + 2),
+					i808x_flags(cpu.reg8[FLAGS]), cpu.reg8[A], reg16_BC, reg16_DE, reg16_HL, cpu.sp,
+						i808x_disassemble(cpu.pc));
+			cpu.pc++;
+		}
+		/* if we are re-executing a hlt it'll set halted again */
+		cpu.halted = 0;
+#endif
+
+		switch (opcode) {
+			case 0x3A: //LDA a - load A from memory
+				temp16 = (uint16_t)i808x_read(cpu.pc) | ((uint16_t)i808x_read(cpu.pc+1)<<8);
+				cpu.reg8[A] = i808x_read(temp16);
+				cpu.pc += 2;
+				cycles -= 13;
+				break;
+			case 0x32: //STA a - store A to memory
+				temp16 = (uint16_t)i808x_read(cpu.pc) | ((uint16_t)i808x_read(cpu.pc+1)<<8);
+				i808x_write(temp16, cpu.reg8[A]);
+				cpu.pc += 2;
+				cycles -= 13;
+				break;
+			case 0x2A: //LHLD a - load H:L from memory
+				temp16 = (uint16_t)i808x_read(cpu.pc);
+				temp16 |= ((uint16_t)i808x_read(cpu.pc+1)<<8);
+				cpu.reg8[L] = i808x_read(temp16++);
+				cpu.reg8[H] = i808x_read(temp16);
+				cpu.pc += 2;
+				cycles -= 16;
+				break;
+			case 0x22: //SHLD a - store H:L to memory
+				temp16 = (uint16_t)i808x_read(cpu.pc) | ((uint16_t)i808x_read(cpu.pc+1)<<8);
+				i808x_write(temp16++, cpu.reg8[L]);
+				i808x_write(temp16, cpu.reg8[H]);
+				cpu.pc += 2;
+				cycles -= 16;
+				break;
+			case 0xEB: //XCHG - exchange DE and HL content
+				temp8 = cpu.reg8[D];
+				cpu.reg8[D] = cpu.reg8[H];
+				cpu.reg8[H] = temp8;
+				temp8 = cpu.reg8[E];
+				cpu.reg8[E] = cpu.reg8[L];
+				cpu.reg8[L] = temp8;
+				cycles -= 5;
+				break;
+			case 0xC6: //ADI # - add immediate to A
+				temp8 = i808x_read(cpu.pc++);
+				temp16 = (uint16_t)cpu.reg8[A] + (uint16_t)temp8;
+				if (temp16 & 0xFF00) set_C(); else clear_C();
+				calc_AC(cpu.reg8[A], temp8);
+				calc_SZP((uint8_t)temp16);
+				calc_Vadd(cpu.reg8[A], temp8, 0);
+				calc_K((uint8_t)temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				cycles -= 7;
+				break;
+			case 0xCE: //ACI # - add immediate to A with carry
+				temp8 = i808x_read(cpu.pc++);
+				temp16 = (uint16_t)cpu.reg8[A] + (uint16_t)temp8 + (uint16_t)test_C();
+				if (test_C()) calc_AC_carry(cpu.reg8[A], temp8); else calc_AC(cpu.reg8[A], temp8);
+				/* The carry out is computed including the
+				   carry in of the bit before */
+				calc_Vadd(cpu.reg8[A], temp8, test_C());
+				if (temp16 & 0xFF00) set_C(); else clear_C();
+				calc_SZP((uint8_t)temp16);
+				calc_K((uint8_t)temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				cycles -= 7;
+				break;
+			case 0xD6: //SUI # - subtract immediate from A
+				temp8 = i808x_read(cpu.pc++);
+				temp16 = (uint16_t)cpu.reg8[A] - (uint16_t)temp8;
+				if (((temp16 & 0x00FF) >= cpu.reg8[A]) && temp8) set_C(); else clear_C();
+				calc_subAC(cpu.reg8[A], temp8);
+				calc_SZP((uint8_t)temp16);
+				calc_Vsub(cpu.reg8[A], temp8, 0);
+				calc_K((uint8_t)temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				cycles -= 7;
+				break;
+			case 0x27: //DAA - decimal adjust accumulator
+				temp8 = cpu.reg8[A];
+				temp16 = temp8;
+				if (((temp16 & 0x0F) > 0x09) || test_AC()) {
+					if (((temp16 & 0x0F) + 0x06) & 0xF0) set_AC(); else clear_AC();
+					temp16 += 0x06;
+					if (temp16 & 0xFF00) set_C(); //can also cause carry to be set during addition to the low nibble
+				}
+				if (((temp16 & 0xF0) > 0x90) || test_C()) {
+					temp16 += 0x60;
+					if (temp16 & 0xFF00) set_C(); //doesn't clear it if this clause is false
+				}
+				calc_SZP((uint8_t)temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				/* Verify this behaviour */
+				if ((temp8 & 0xF0) == 0x70 &&
+					(temp16 & 0xF0) == 0x80)
+					set_V();
+				else
+					clear_V();
+				calc_K(cpu.reg8[A]);
+				cycles -= 4;
+				break;
+			case 0xE6: //ANI # - AND immediate with A
+				temp8 = i808x_read(cpu.pc++);
+				calc_andAC(cpu.reg8[A], temp8);
+				cpu.reg8[A] &= temp8;
+				clear_C();
+				calc_SZP(cpu.reg8[A]);
+				calc_KVlogic(cpu.reg8[A]);
+				cycles -= 7;
+				break;
+			case 0xF6: //ORI # - OR immediate with A
+				cpu.reg8[A] |= i808x_read(cpu.pc++);
+				clear_AC();
+				clear_C();
+				calc_SZP(cpu.reg8[A]);
+				calc_KVlogic(cpu.reg8[A]);
+				cycles -= 7;
+				break;
+			case 0xEE: //XRI # - XOR immediate with A
+				cpu.reg8[A] ^= i808x_read(cpu.pc++);
+				clear_AC();
+				clear_C();
+				calc_SZP(cpu.reg8[A]);
+				calc_KVlogic(cpu.reg8[A]);
+				cycles -= 7;
+				break;
+			case 0xDE: //SBI # - subtract immediate from A with borrow
+				temp8 = i808x_read(cpu.pc++);
+				temp16 = (uint16_t)cpu.reg8[A] - (uint16_t)temp8 - (uint16_t)test_C();
+				if (test_C()) calc_subAC_borrow(cpu.reg8[A], temp8); else calc_subAC(cpu.reg8[A], temp8);
+				calc_Vsub(cpu.reg8[A], temp8, test_C());
+				if (((temp16 & 0x00FF) >= cpu.reg8[A]) && (temp8 | test_C())) set_C(); else clear_C();
+				calc_SZP((uint8_t)temp16);
+				calc_K((uint8_t)temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				cycles -= 7;
+				break;
+			case 0xFE: //CPI # - compare immediate with A
+				temp8 = i808x_read(cpu.pc++);
+				temp16 = (uint16_t)cpu.reg8[A] - (uint16_t)temp8;
+				if (((temp16 & 0x00FF) >= cpu.reg8[A]) && temp8) set_C(); else clear_C();
+				calc_subAC(cpu.reg8[A], temp8);
+				calc_SZP((uint8_t)temp16);
+				calc_Vsub(cpu.reg8[A], temp8, 0);
+				calc_K((uint8_t)temp16);
+				cycles -= 7;
+				break;
+			case 0x07: //RLC - rotate A left
+				if (cpu.reg8[A] & 0x80) set_C(); else clear_C();
+				calc_Vadd(cpu.reg8[A],cpu.reg8[A], cpu.reg8[A] & 0x80);
+				cpu.reg8[A] = (cpu.reg8[A] >> 7) | (cpu.reg8[A] << 1);
+				calc_K(cpu.reg8[A]);
+				cycles -= 4;
+				break;
+			case 0x0F: //RRC - rotate A right
+				if (cpu.reg8[A] & 0x01) set_C(); else clear_C();
+				cpu.reg8[A] = (cpu.reg8[A] << 7) | (cpu.reg8[A] >> 1);
+				clear_V();
+				/* Verify if RR ops affect K */
+				cycles -= 4;
+				break;
+			case 0x17: //RAL - rotate A left through carry
+				temp8 = test_C();
+				if (cpu.reg8[A] & 0x80) set_C(); else clear_C();
+				calc_Vadd(cpu.reg8[A],cpu.reg8[A], temp8);
+				cpu.reg8[A] = (cpu.reg8[A] << 1) | temp8;
+				calc_K(cpu.reg8[A]);
+				cycles -= 4;
+				break;
+			case 0x1F: //RAR - rotate A right through carry
+				temp8 = test_C();
+				if (cpu.reg8[A] & 0x01) set_C(); else clear_C();
+				cpu.reg8[A] = (cpu.reg8[A] >> 1) | (temp8 << 7);
+				cycles -= 4;
+				/* Verify if RR ops affect K */
+				clear_V();
+				break;
+			case 0x2F: //CMA - complement A
+				cpu.reg8[A] = ~cpu.reg8[A];
+				cycles -= 4;
+				/* This does not affect flags */
+				break;
+			case 0x3F: //CMC - complement carry flag
+				cpu.reg8[FLAGS] ^= 1;
+				cycles -= 4;
+				break;
+			case 0x37: //STC - set carry flag
+				set_C();
+				cycles -= 4;
+				break;
+#ifdef I8085
+			case 0xCB: //RSTv
+				if (test_V()) {
+					cycles -= 6;
+					i808x_push(cpu.pc);
+					cpu.pc = 0x40;
+				}
+				cycles -= 6;
+				break;
+#endif
+			case 0xC7: //RST n - restart (call n*8)
+			case 0xD7:
+			case 0xE7:
+			case 0xF7:
+			case 0xCF:
+			case 0xDF:
+			case 0xEF:
+			case 0xFF:
+				i808x_push(cpu.pc);
+				cpu.pc = (uint16_t)((opcode >> 3) & 7) << 3;
+				cycles -= CYC(11, 12);
+				break;
+			case 0xE9: //PCHL - jump to address in H:L
+				cpu.pc = reg16_HL;
+				cycles -= CYC(5, 6);
+				break;
+			case 0xE3: //XTHL - swap H:L with top word on stack
+				temp16 = i808x_pop();
+				i808x_push(reg16_HL);
+				write16_RP(2, temp16);
+				cycles -= CYC(18, 16);
+				break;
+			case 0xF9: //SPHL - set SP to content of HL
+				cpu.sp = reg16_HL;
+				cycles -= CYC(5, 6);
+				break;
+			case 0xDB: //IN p - read input port into A
+				cpu.reg8[A] = i808x_inport(i808x_read(cpu.pc++));
+				cycles -= 10;
+				break;
+			case 0xD3: //OUT p - write A to output port
+				i808x_outport(i808x_read(cpu.pc++), cpu.reg8[A]);
+				cycles -= 10;
+				break;
+			case 0xFB: //EI - enable intersrupts
+				cpu.inte = 1;
+#ifdef I8085
+				cpu.intprotect = 1;
+#endif
+				cycles -= 4;
+				break;
+			case 0xF3: //DI - disbale interrupts
+				cpu.inte = 0;
+				cycles -= 4;
+				break;
+			case 0x76: //HLT - halt processor
+				cpu.pc--;
+				cycles -= 7;
+				cpu.halted = 1;
+				break;
+#ifdef I8080
+			/* Undocumented on the 8080 where they act as NOP */
+			case 0x08:
+			case 0x10:
+			case 0x18:
+			case 0x20:
+			case 0x28:
+			case 0x30:
+			case 0x38:
+#endif
+			case 0x00: //NOP - no operation
+				cycles -= 4;
+				break;
+#ifdef I8085
+			case 0x08: // DSUB - 16bit subtraction
+				/* Does SUB L,C; SBC H,B for flags */
+				temp8 = cpu.reg8[C];
+				temp16 = (uint16_t)cpu.reg8[L] - (uint16_t)temp8;
+				if ((temp16 & 0x00FF) >= cpu.reg8[L] && temp8)
+					set_C();
+				else
+					clear_C();
+				cpu.reg8[L] = (uint8_t)temp16;
+				/* We don't need the other intermediate flags */
+				temp8 = cpu.reg8[B];
+				temp16 = (uint16_t)cpu.reg8[H] - (uint16_t)temp8 - (uint16_t)test_C();
+				if (test_C())
+					calc_subAC_borrow(cpu.reg8[H], temp8);
+				else
+					calc_subAC(cpu.reg8[H], temp8);
+				calc_Vsub(cpu.reg8[H], temp8, test_C());
+				if ((temp16 & 0x00FF) >= cpu.reg8[H] && (temp8 | test_C()))
+					set_C();
+				else
+					clear_C();
+				calc_SZP((uint8_t)temp16);
+				calc_K(temp16);
+				cpu.reg8[H] = (uint8_t)temp16;
+				cycles -= 10;
+				break;
+			case 0x10: // ARHL
+				if (reg16_HL & 1)
+					set_C();
+				else
+					clear_C();
+				temp16 = reg16_HL >> 1;
+				if (temp16 & 0x4000)
+					temp16 |= 0x8000;
+				i808x_write_reg16(HL, temp16);
+				cycles -= 7;
+				break;
+			case 0x18: // RDEL
+				/* Affects only CY and V */
+				temp16 = reg16_DE;
+				temp8 = test_C();
+				i808x_write_reg16(DE, (temp16 << 1) + temp8);
+				if (temp16 & 0x8000)
+					set_C();
+				else
+					clear_C();
+				cycles -= 10;
+				/* This seems to be a DAD D,D with carry but
+				   I'm not enitrely sure. FIXME */
+				calc_Vadd16(temp16, temp16 + temp8);
+				break;
+			case 0x20: // RIM
+				temp8 = cpu.im & 0x07;
+				if (cpu.intpend & INT_RST75)
+					temp8 |= 0x10;
+				temp8 |= i808x_get_input() ? 0x80: 0x00;
+				temp8 |= (cpu.intpend & 7)  << 4;
+				cpu.reg8[A] = temp8;
+				cycles -= 4;
+				break;
+			case 0x28: // LDHI
+				i808x_write_reg16(DE, reg16_HL + i808x_read(cpu.pc++));
+				cycles -= 10;
+				break;
+			case 0x30: // SIM
+				if (cpu.reg8[A] & 0x08)
+					cpu.im = cpu.reg8[A] & 0x07;
+				if (cpu.reg8[A] & 0x10)
+					cpu.intpend &= ~INT_RST75;
+				if (cpu.reg8[A] & 0x40)
+					i808x_set_output(cpu.reg8[A] & 0x80);
+				cycles -= 4;
+				break;
+			case 0x38: // LDSI
+				i808x_write_reg16(DE, cpu.sp + i808x_read(cpu.pc++));
+				cycles -= 10;
+				break;
+#endif
+			case 0x40: case 0x50: case 0x60: case 0x70: //MOV D,S - move register to register
+			case 0x41: case 0x51: case 0x61: case 0x71:
+			case 0x42: case 0x52: case 0x62: case 0x72:
+			case 0x43: case 0x53: case 0x63: case 0x73:
+			case 0x44: case 0x54: case 0x64: case 0x74:
+			case 0x45: case 0x55: case 0x65: case 0x75:
+			case 0x46: case 0x56: case 0x66:
+			case 0x47: case 0x57: case 0x67: case 0x77:
+			case 0x48: case 0x58: case 0x68: case 0x78:
+			case 0x49: case 0x59: case 0x69: case 0x79:
+			case 0x4A: case 0x5A: case 0x6A: case 0x7A:
+			case 0x4B: case 0x5B: case 0x6B: case 0x7B:
+			case 0x4C: case 0x5C: case 0x6C: case 0x7C:
+			case 0x4D: case 0x5D: case 0x6D: case 0x7D:
+			case 0x4E: case 0x5E: case 0x6E: case 0x7E:
+			case 0x4F: case 0x5F: case 0x6F: case 0x7F:
+				reg = (opcode >> 3) & 7;
+				reg2 = opcode & 7;
+				i808x_write_reg8(reg, i808x_read_reg8(reg2));
+				if ((reg == M) || (reg2 == M)) {
+					cycles -= 7;
+				} else {
+					cycles -= CYC(5, 4);
+				}
+				break;
+			case 0x06: //MVI D,# - move immediate to register
+			case 0x16:
+			case 0x26:
+			case 0x36:
+			case 0x0E:
+			case 0x1E:
+			case 0x2E:
+			case 0x3E:
+				reg = (opcode >> 3) & 7;
+				i808x_write_reg8(reg, i808x_read(cpu.pc++));
+				if (reg == M) {
+					cycles -= 10;
+				} else {
+					cycles -= 7;
+				}
+				break;
+			case 0x01: //LXI RP,# - load register pair immediate
+			case 0x11:
+			case 0x21:
+			case 0x31:
+				reg = (opcode >> 4) & 3;
+				/* Although there are not internal side effects we must put
+				   the two reads on the bus in order */
+				temp8 = i808x_read(cpu.pc);
+				write_RP(reg, temp8, i808x_read(cpu.pc + 1));
+				cpu.pc += 2;
+				cycles -= 10;
+				break;
+			case 0x0A: //LDAX BC - load A indirect through BC
+				cpu.reg8[A] = i808x_read(reg16_BC);
+				cycles -= 7;
+				break;
+			case 0x1A: //LDAX DE - load A indirect through DE
+				cpu.reg8[A] = i808x_read(reg16_DE);
+				cycles -= 7;
+				break;
+			case 0x02: //STAX BC - store A indirect through BC
+				i808x_write(reg16_BC, cpu.reg8[A]);
+				cycles -= 7;
+				break;
+			case 0x12: //STAX DE - store A indirect through DE
+				i808x_write(reg16_DE, cpu.reg8[A]);
+				cycles -= 7;
+				break;
+			case 0x04: //INR D - increment register
+			case 0x14:
+			case 0x24:
+			case 0x34:
+			case 0x0C:
+			case 0x1C:
+			case 0x2C:
+			case 0x3C:
+				reg = (opcode >> 3) & 7;
+				temp8 = i808x_read_reg8(reg); //cpu.reg8[reg];
+				calc_AC(temp8, 1);
+				calc_SZP(temp8 + 1);
+				if (temp8 == 0x7F)
+					set_V();
+				else
+					clear_V();
+				calc_K(temp8+1);
+				i808x_write_reg8(reg, temp8 + 1); //cpu.reg8[reg]++;
+				if (reg == M) {
+					cycles -= 10;
+				} else {
+					cycles -= CYC(5, 4);
+				}
+				break;
+			case 0x05: //DCR D - decrement register
+			case 0x15:
+			case 0x25:
+			case 0x35:
+			case 0x0D:
+			case 0x1D:
+			case 0x2D:
+			case 0x3D:
+				reg = (opcode >> 3) & 7;
+				temp8 = i808x_read_reg8(reg); //cpu.reg8[reg];
+				calc_subAC(temp8, 1);
+				calc_SZP(temp8 - 1);
+				if (temp8 == 0x80)
+					set_V();
+				else
+					clear_V();
+				calc_K(temp8 - 1);
+				i808x_write_reg8(reg, temp8 - 1); //cpu.reg8[reg]--;
+				if (reg == M) {
+					cycles -= 10;
+				} else {
+					cycles -= CYC(5, 4);
+				}
+				break;
+			case 0x03: //INX RP - increment register pair
+			case 0x13:
+			case 0x23:
+			case 0x33:
+				reg = (opcode >> 4) & 3;
+				temp16 = read_RP(reg) + 1;
+				if (temp16 == 0x8000)
+					set_V();
+				else
+					clear_V();
+				if (temp16 == 0x0000)
+					set_K();
+				else
+					clear_K();
+				write16_RP(reg, temp16);
+				cycles -= CYC(5, 6);
+				break;
+			case 0x0B: //DCX RP - decrement register pair
+			case 0x1B:
+			case 0x2B:
+			case 0x3B:
+				reg = (opcode >> 4) & 3;
+				temp16 = read_RP(reg) - 1;
+				if (temp16 == 0x7FFF)
+					set_V();
+				else
+					clear_V();
+				if (temp16 == 0xFFFF)
+					set_K();
+				else
+					clear_K();
+				write16_RP(reg, temp16);
+				cycles -= CYC(5, 6);
+				break;
+			case 0x09: //DAD RP - add register pair to HL
+			case 0x19:
+			case 0x29:
+			case 0x39:
+				reg = (opcode >> 4) & 3;
+				calc_Vadd16(reg16_HL, read_RP(reg));
+				temp32 = (uint32_t)reg16_HL + (uint32_t)read_RP(reg);
+				write16_RP(2, (uint16_t)temp32);
+				if (temp32 & 0xFFFF0000) set_C(); else clear_C();
+				calc_K(temp32 >> 8);;
+				cycles -= 10;
+				break;
+			case 0x80: //ADD S - add register or memory to A
+			case 0x81:
+			case 0x82:
+			case 0x83:
+			case 0x84:
+			case 0x85:
+			case 0x86:
+			case 0x87:
+				reg = opcode & 7;
+				temp8 = i808x_read_reg8(reg);
+				temp16 = (uint16_t)cpu.reg8[A] + (uint16_t)temp8;
+				if (temp16 & 0xFF00) set_C(); else clear_C();
+				calc_AC(cpu.reg8[A], temp8);
+				calc_SZP((uint8_t)temp16);
+				calc_Vadd(cpu.reg8[A], temp8, 0);
+				calc_K(temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				if (reg == M) {
+					cycles -= 7;
+				} else {
+					cycles -= 4;
+				}
+				break;
+			case 0x88: //ADC S - add register or memory to A with carry
+			case 0x89:
+			case 0x8A:
+			case 0x8B:
+			case 0x8C:
+			case 0x8D:
+			case 0x8E:
+			case 0x8F:
+				reg = opcode & 7;
+				temp8 = i808x_read_reg8(reg);
+				temp16 = (uint16_t)cpu.reg8[A] + (uint16_t)temp8 + (uint16_t)test_C();
+				if (test_C()) calc_AC_carry(cpu.reg8[A], temp8); else calc_AC(cpu.reg8[A], temp8);
+				calc_Vadd(cpu.reg8[A], temp8, test_C());
+				if (temp16 & 0xFF00) set_C(); else clear_C();
+				calc_SZP((uint8_t)temp16);
+				calc_K(temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				if (reg == M) {
+					cycles -= 7;
+				} else {
+					cycles -= 4;
+				}
+				break;
+			case 0x90: //SUB S - subtract register or memory from A
+			case 0x91:
+			case 0x92:
+			case 0x93:
+			case 0x94:
+			case 0x95:
+			case 0x96:
+			case 0x97:
+				reg = opcode & 7;
+				temp8 = i808x_read_reg8(reg);
+				temp16 = (uint16_t)cpu.reg8[A] - (uint16_t)temp8;
+				if (((temp16 & 0x00FF) >= cpu.reg8[A]) && temp8) set_C(); else clear_C();
+				calc_subAC(cpu.reg8[A], temp8);
+				calc_SZP((uint8_t)temp16);
+				calc_Vsub(cpu.reg8[A], temp8, 0);
+				calc_K(temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				if (reg == M) {
+					cycles -= 7;
+				} else {
+					cycles -= 4;
+				}
+				break;
+			case 0x98: //SBB S - subtract register or memory from A with borrow
+			case 0x99:
+			case 0x9A:
+			case 0x9B:
+			case 0x9C:
+			case 0x9D:
+			case 0x9E:
+			case 0x9F:
+				reg = opcode & 7;
+				temp8 = i808x_read_reg8(reg);
+				temp16 = (uint16_t)cpu.reg8[A] - (uint16_t)temp8 - (uint16_t)test_C();
+				if (test_C()) calc_subAC_borrow(cpu.reg8[A], temp8); else calc_subAC(cpu.reg8[A], temp8);
+				calc_Vsub(cpu.reg8[A], temp8, test_C());
+				if (((temp16 & 0x00FF) >= cpu.reg8[A]) && (temp8 | test_C())) set_C(); else clear_C();
+				calc_SZP((uint8_t)temp16);
+				calc_K(temp16);
+				cpu.reg8[A] = (uint8_t)temp16;
+				if (reg == M) {
+					cycles -= 7;
+				} else {
+					cycles -= 4;
+				}
+				break;
+			case 0xA0: //ANA S - AND register with A
+			case 0xA1:
+			case 0xA2:
+			case 0xA3:
+			case 0xA4:
+			case 0xA5:
+			case 0xA6:
+			case 0xA7:
+				reg = opcode & 7;
+				temp8 = i808x_read_reg8(reg);
+				calc_andAC(cpu.reg8[A], temp8);
+				cpu.reg8[A] &= temp8;
+				clear_C();
+				calc_SZP(cpu.reg8[A]);
+				calc_KVlogic(cpu.reg8[A]);
+				if (reg == M) {
+					cycles -= 7;
+				} else {
+					cycles -= 4;
+				}
+				break;
+			case 0xB0: //ORA S - OR register with A
+			case 0xB1:
+			case 0xB2:
+			case 0xB3:
+			case 0xB4:
+			case 0xB5:
+			case 0xB6:
+			case 0xB7:
+				reg = opcode & 7;
+				cpu.reg8[A] |= i808x_read_reg8(reg);
+				clear_AC();
+				clear_C();
+				calc_SZP(cpu.reg8[A]);
+				calc_KVlogic(cpu.reg8[A]);
+				if (reg == M) {
+					cycles -= 7;
+				} else {
+					cycles -= 4;
+				}
+				break;
+			case 0xA8: //XRA S - XOR register with A
+			case 0xA9:
+			case 0xAA:
+			case 0xAB:
+			case 0xAC:
+			case 0xAD:
+			case 0xAE:
+			case 0xAF:
+				reg = opcode & 7;
+				cpu.reg8[A] ^= i808x_read_reg8(reg);
+				clear_AC();
+				clear_C();
+				calc_SZP(cpu.reg8[A]);
+				calc_KVlogic(cpu.reg8[A]);
+				if (reg == M) {
+					cycles -= 7;
+				} else {
+					cycles -= 4;
+				}
+				break;
+			case 0xB8: //CMP S - compare register with A
+			case 0xB9:
+			case 0xBA:
+			case 0xBB:
+			case 0xBC:
+			case 0xBD:
+			case 0xBE:
+			case 0xBF:
+				reg = opcode & 7;
+				temp8 = i808x_read_reg8(reg);
+				temp16 = (uint16_t)cpu.reg8[A] - (uint16_t)temp8;
+				if (((temp16 & 0x00FF) >= cpu.reg8[A]) && temp8) set_C(); else clear_C();
+				calc_subAC(cpu.reg8[A], temp8);
+				calc_SZP((uint8_t)temp16);
+				calc_Vsub(cpu.reg8[A], temp8, 0);
+				calc_K(temp16);
+				if (reg == M) {
+					cycles -= 7;
+				} else {
+					cycles -= 4;
+				}
+				break;
+			case 0xC3: //JMP a - unconditional jump
+#ifdef I8080
+			case 0xCB:
+#endif
+				temp16 = (uint8_t)i808x_read(cpu.pc);
+				temp16 |= (((uint16_t)i808x_read(cpu.pc + 1)) << 8);
+				cpu.pc = temp16;
+				cycles -= 10;
+				break;
+			case 0xC2: //Jccc - conditional jumps
+			case 0xCA:
+			case 0xD2:
+			case 0xDA:
+			case 0xE2:
+			case 0xEA:
+			case 0xF2:
+			case 0xFA:
+				temp16 = (uint8_t)i808x_read(cpu.pc);
+				temp16 |= (((uint16_t)i808x_read(cpu.pc + 1)) << 8);
+				if (test_cond((opcode >> 3) & 7)) {
+					cpu.pc = temp16;
+					cycles -= 10;
+				} else {
+					cpu.pc += 2;
+					cycles -= CYC(10, 7);
+				}
+				break;
+#ifdef I8085
+			case 0xDD: // JNK
+				temp16 = (uint8_t)i808x_read(cpu.pc);
+				temp16 |= (((uint16_t)i808x_read(cpu.pc + 1)) << 8);
+				if (!test_K()) {
+					cpu.pc = temp16;
+					cycles -= 10;
+				} else {
+					cpu.pc += 2;
+					cycles -= 7;
+				}
+				break;
+			case 0xED:
+				cpu.reg8[L] = i808x_read(reg16_DE);
+				cpu.reg8[H] = i808x_read(reg16_DE + 1);
+				cycles -= 10;
+				break;
+			case 0xFD: // JK
+				temp16 = (uint8_t)i808x_read(cpu.pc);
+				temp16 |= (((uint16_t)i808x_read(cpu.pc + 1)) << 8);
+				if (test_K()) {
+					cpu.pc = temp16;
+					cycles -= 10;
+				} else {
+					cpu.pc += 2;
+					cycles -= 7;
+				}
+				break;
+#endif
+			case 0xCD: //CALL a - unconditional call
+#ifdef I8080
+			case 0xDD:
+			case 0xED:
+			case 0xFD:
+#endif
+				temp16 = (uint8_t)i808x_read(cpu.pc);
+				temp16 |= (((uint16_t)i808x_read(cpu.pc + 1)) << 8);
+				i808x_push(cpu.pc + 2);
+				cpu.pc = temp16;
+				cycles -= CYC(17, 18);
+				break;
+			case 0xC4: //Cccc - conditional calls
+			case 0xCC:
+			case 0xD4:
+			case 0xDC:
+			case 0xE4:
+			case 0xEC:
+			case 0xF4:
+			case 0xFC:
+				temp16 = (uint8_t)i808x_read(cpu.pc);
+				temp16 |= (((uint16_t)i808x_read(cpu.pc + 1)) << 8);
+				if (test_cond((opcode >> 3) & 7)) {
+					i808x_push(cpu.pc + 2);
+					cpu.pc = temp16;
+					cycles -= CYC(17, 18);
+				} else {
+					cpu.pc += 2;
+					cycles -= CYC(11, 9);
+				}
+				break;
+#ifdef I8085
+			case 0xD9: //SHLX
+				i808x_write(reg16_DE, cpu.reg8[L]);
+				i808x_write(reg16_DE+1, cpu.reg8[H]);
+				cycles -= 10;
+				break;
+#endif
+			case 0xC9: //RET - unconditional return
+#ifdef I8080
+			case 0xD9:
+#endif
+				cpu.pc = i808x_pop();
+				cycles -= 10;
+				break;
+			case 0xC0: //Rccc - conditional returns
+			case 0xC8:
+			case 0xD0:
+			case 0xD8:
+			case 0xE0:
+			case 0xE8:
+			case 0xF0:
+			case 0xF8:
+				if (test_cond((opcode >> 3) & 7)) {
+					cpu.pc = i808x_pop();
+					cycles -= CYC(11, 12);
+				} else {
+					cycles -= CYC(5, 6);
+				}
+				break;
+			case 0xC5: //PUSH RP - push register pair on the stack
+			case 0xD5:
+			case 0xE5:
+			case 0xF5:
+				reg = (opcode >> 4) & 3;
+				i808x_push(read_RP_PUSHPOP(reg));
+				cycles -= CYC(11, 12);
+				break;
+			case 0xC1: //POP RP - pop register pair from the stack
+			case 0xD1:
+			case 0xE1:
+			case 0xF1:
+				reg = (opcode >> 4) & 3;
+				write16_RP_PUSHPOP(reg, i808x_pop());
+				cycles -= 10;
+				break;
+			default:
+				printf("UNRECOGNIZED INSTRUCTION @ %04Xh: %02X\n", cpu.pc - 1, opcode);
+				exit(0);
+		}
+
+	}
+	return cycles;
+}
+
+/*
+ *	8085 disassembler - added by Alan Cox 2022, 8080 from 2025
+ */
+
+
+struct i808x_addr {
+	unsigned addr;
+	struct i808x_addr *next;
+	char name[16];
+	char type;
+};
+
+static struct i808x_addr *sym[0x40];
+
+static unsigned ahash(unsigned addr)
+{
+	return (addr >> 6) & 0x3F;
+}
+
+static struct i808x_addr *i808x_addr_find(unsigned addr)
+{
+	unsigned hash = ahash(addr);
+	struct i808x_addr *a = sym[hash];
+	while(a) {
+		if (a->addr == addr)
+			return a;
+		a = a->next;
+	}
+	return NULL;
+}
+
+static void i808x_add_symbol(unsigned addr, char type, char *name)
+{
+	struct i808x_addr *a = malloc(sizeof(struct i808x_addr));
+	unsigned hash = ahash(addr);
+	strncpy(a->name, name, 16);
+	a->addr = addr;
+	a->type = type;
+	a->next = sym[hash];
+	sym[hash] = a;
+}
+
+void i808x_load_symbols(const char *path)
+{
+	char buf[64];
+	unsigned addr;
+	char type;
+	char name[17];
+	FILE *fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return;
+	}
+	while(fgets(buf, 63, fp) != NULL) {
+		if (sscanf(buf, "%x %c %16s", &addr, &type, name) == 3)
+			i808x_add_symbol(addr, type, name);
+		else
+			fprintf(stderr, "format error %s\n", buf);
+	}
+	fclose(fp);
+}
+
+static char opbuf[32];
+
+static char rname[8] = { "bcdehlma" };
+static char *rpair_s[4] = { "bc", "de", "hl", "sp" };
+static char *rpair_p[4] = { "bc", "de", "hl", "psw" };
+static char *cc[8] = { "nz", "z", "nc", "c", "po", "pe", "p", "m" };
+
+static char *blk00[] = {
+#ifdef I8085
+	"nop", "dsub", "arhl", "rdel", "rim", "ldhi", "sim", "ldsi"
+#else
+	"nop", "ill(dsub)", "ill(arhl)", "ill(rdel)", "ill(rim)", "ill(ldhi)", "ill(sim)", "ill(ldsi)"
+#endif
+};
+
+static char *blk02[] = {
+	"stax b", "ldax b", "stax d", "ldax d",
+	"shld", "lhld", "sta", "lda"
+};
+
+static char *blk07[] = {
+	"rlc", "rrc", "ral", "rar",
+	"daa", "cma", "stc", "cmc"
+};
+
+static char *idrw(unsigned addr)
+{
+	static char buf[16];
+	struct i808x_addr *a;
+	unsigned v = i808x_debug_read(addr);
+	v |= i808x_debug_read(addr + 1) << 8;
+	a = i808x_addr_find(v);
+	if (a)
+		return a->name;
+	else {
+		sprintf(buf, "%04X", v);
+		return buf;
+	}
+}
+
+static void dis0(uint8_t op, uint16_t addr)
+{
+	unsigned y = (op >> 3) & 7;
+	switch(op & 7) {
+		case 0:
+			/* Real mix */
+			if (y == 5 || y == 7)
+				sprintf(opbuf, "%s %02X", blk00[y], i808x_debug_read(addr));
+			else
+				strcpy(opbuf, blk00[y]);
+			break;
+		case 1:
+			if (y & 1)
+				sprintf(opbuf, "dad %s", rpair_s[y >> 1]);
+			else
+				sprintf(opbuf, "lxi %s, %s", rpair_s[y >> 1], idrw(addr));
+			break;
+		case 2:
+			if (y & 4)
+				sprintf(opbuf, "%s %s", blk02[y],
+					idrw(addr));
+			else
+				strcpy(opbuf, blk02[y]);
+			break;
+		case 3:
+			if (!(y & 1))
+				sprintf(opbuf, "inx %s", rpair_s[y >> 1]);
+			else
+				sprintf(opbuf, "dcx %s", rpair_s[y >> 1]);
+			break;
+		case 4:
+			sprintf(opbuf, "inr %c", rname[y]);
+			break;
+		case 5:
+			sprintf(opbuf, "dcr %c", rname[y]);
+			break;
+		case 6:
+			sprintf(opbuf, "mvi %c,%02X", rname[y],
+				i808x_debug_read(addr));
+			break;
+		case 7:
+			strcpy(opbuf, blk07[y]);
+			break;
+	}
+}
+
+static void dis1(uint8_t op, uint16_t addr)
+{
+	if (op == 0x76)
+		strcpy(opbuf, "hlt");
+	else
+		sprintf(opbuf, "mov %c,%c", rname[(op >> 3) & 7], rname[op & 7]);
+}
+
+static char *aluop[] = {
+	"add", "adc", "sub", "sbb", "ana", "xra", "ora", "cmp"
+};
+
+static char *aluim[] = {
+	"adi", "aci", "sui", "sbi", "ani", "xri", "ori", "cmi"
+};
+
+static void dis2(uint8_t op, uint16_t addr)
+{
+	sprintf(opbuf, "%s %c", aluop[(op >> 3) & 7], rname[op & 7]);
+}
+
+static char *blk31[] = {
+#ifdef I8085
+	"ret", "shlx", "pchl", "sphl"
+#else
+	"ret", "ill(shlx)", "pchl", "sphl"
+#endif
+};
+
+static void dis3(uint8_t op, uint16_t addr)
+{
+	unsigned y = (op >> 3) & 7;
+	switch(op & 7) {
+	case 0:
+		sprintf(opbuf, "r%s", cc[y]);
+		break;
+	case 1:
+		if ((y & 1) == 0)
+			sprintf(opbuf, "pop %s", rpair_p[y >> 1]);
+		else
+			strcpy(opbuf, blk31[y >> 1]);
+		break;
+	case 2:
+		sprintf(opbuf, "j%s %s", cc[y], idrw(addr));
+		break;
+	case 3:
+		/* This one appears to have been the dumping ground */
+		switch(y) {
+		case 0:
+			sprintf(opbuf, "jmp %s", idrw(addr));
+			break;
+		case 1:
+			strcpy(opbuf, "rstv");
+			return;
+		case 2:
+			sprintf(opbuf, "out %02X", i808x_debug_read(addr));
+			return;
+		case 3:
+			sprintf(opbuf, "in %02X", i808x_debug_read(addr));
+			return;
+		case 4:
+			strcpy(opbuf, "xthl");
+			return;
+		case 5:
+			strcpy(opbuf, "xchg");
+			return;
+		case 6:
+			strcpy(opbuf, "di");
+			return;
+		case 7:
+			strcpy(opbuf, "ei");
+			return;
+		}
+		break;
+	case 4:
+		sprintf(opbuf, "c%s %s", cc[y], idrw(addr));
+		break;
+	case 5:
+		if (!(y & 1)) {
+			sprintf(opbuf, "push %s", rpair_p[y >> 1]);
+			break;
+		}
+		switch(y >> 1) {
+		case 0:
+			sprintf(opbuf, "call %s", idrw(addr));
+			break;
+		case 1:
+#ifdef I8085
+			sprintf(opbuf, "jnx %s", idrw(addr));
+#else
+			sprintf(opbuf, "ill(jnx %s)", idrw(addr));
+#endif
+			break;
+		case 2:
+#ifdef I8085
+			strcpy(opbuf, "lhlx");
+#else
+			strcpy(opbuf, "ill(lhlx)");
+#endif
+			break;
+		case 3:
+#ifdef I8085
+			sprintf(opbuf, "jx %s", idrw(addr));
+#else
+			sprintf(opbuf, "ill(jx %s)", idrw(addr));
+#endif
+			break;
+		}
+		break;
+	case 6:
+		sprintf(opbuf, "%s %02X", aluim[y], i808x_debug_read(addr));
+		break;
+	case 7:
+		sprintf(opbuf, "rst %d", y);
+		break;
+	}
+}
+
+static char *i808x_disassemble(uint16_t addr)
+{
+	uint8_t op = i808x_debug_read(addr++);
+	switch (op & 0xC0) {
+	case 0x00:
+		dis0(op, addr);
+		break;
+	case 0x40:
+		dis1(op, addr);
+		break;
+	case 0x80:
+		dis2(op, addr);
+		break;
+	case 0xC0:
+		dis3(op, addr);
+		break;
+	}
+	return opbuf;
+}
@@ -31,6 +31,8 @@ struct keymatrix {
 	bool *status;
 	int trace;
 	void (*translate)(SDL_Event *ev);
+	/* Scan results for the low and high byte of the select bits */
+	uint8_t scan[2][256];
 };
 
 /*
@@ -49,6 +51,34 @@ static int keymatrix_find(struct keymatrix *km, SDL_Keycode keycode)
 
 }
 
+/*
+ *	Machines scan the keyboard far more often than keys change so work
+ *	out the answer for every possible select pattern when a key changes.
+ *	Each byte of select bits covers 8 rows and the answers are or'd.
+ */
+static void keymatrix_rebuild(struct keymatrix *km)
+{
+	uint8_t row[16];
+	unsigned int r, c, n;
+	bool *p = km->status;
+
+	memset(row, 0, sizeof(row));
+	for (r = 0; r < km->rows && r < 16; r++)
+		for (c = 0; c < km->cols; c++)
+			if (*p++ == true)
+				row[r] |= 1 << c;
+
+	km->scan[0][0] = 0;
+	km->scan[1][0] = 0;
+	for (n = 1, r = 0; n < 256; n++) {
+		/* Top select bit plus the answer without it */
+		if (n == 2U << r)
+			r++;
+		km->scan[0][n] = km->scan[0][n & ~(1U << r)] | row[r];
+		km->scan[1][n] = km->scan[1][n & ~(1U << r)] | row[r + 8];
+	}
+}
+
 /*
  *	Update the matrix. We don't care about state change tracking and
  *	the like as all that the matrix interface provides is a current
@@ -65,7 +95,10 @@ static bool keymatrix_event(struct keymatrix *km, SDL_Keysym *keysym, bool down)
 			(unsigned int)keysym->sym,
 			down ? "Down" : "Up",
 			n / km->cols, n % km->cols);
-	km->status[n] = down;
+	if (km->status[n] != down) {
+		km->status[n] = down;
+		keymatrix_rebuild(km);
+	}
 	return true;
 }
 
@@ -81,6 +114,9 @@ uint8_t keymatrix_input(struct keymatrix *km, uint16_t scanbits)
 	uint8_t r = 0;
 	bool *p = km->status;
 
+	if (!km->trace)
+		return km->scan[0][scanbits & 0xFF] | km->scan[1][scanbits >> 8];
+
 	/* Work out what byte code you get back. For the moment ignore ghosting
 	   emulation */
 	for (row = 0; row < km->rows; row++) {
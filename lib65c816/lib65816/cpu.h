@@ -122,6 +122,50 @@ extern word32   cpu_cycle_count;
 
 
 
+/* Memory page table. The 16MB address space is split into 4K pages and
+ * each page can be pointed straight at host memory, separately for reads
+ * and writes so that ROM can be mapped read only. Accesses to an unmapped
+ * page go to the platform read65c816() and write65c816() routines. Mapped
+ * accesses (including direct page and stack) are then inline loads and
+ * stores.
+ */
+
+#define CPU_PAGE_SHIFT  12
+#define CPU_PAGE_SIZE   (1 << CPU_PAGE_SHIFT)
+#define CPU_PAGES       4096
+
+extern byte *cpu_read_page[CPU_PAGES];
+extern byte *cpu_write_page[CPU_PAGES];
+
+extern uint8_t read65c816(uint32_t addr, uint8_t mode);
+extern void write65c816(uint32_t addr, uint8_t value);
+
+static inline byte CPU_read(word32 a)
+{
+    word32 p = a >> CPU_PAGE_SHIFT;
+    if (p < CPU_PAGES && cpu_read_page[p])
+        return cpu_read_page[p][a & (CPU_PAGE_SIZE - 1)];
+    return read65c816(a, 0);
+}
+
+static inline void CPU_write(word32 a, byte v)
+{
+    word32 p = a >> CPU_PAGE_SHIFT;
+    if (p < CPU_PAGES && cpu_write_page[p])
+        cpu_write_page[p][a & (CPU_PAGE_SIZE - 1)] = v;
+    else
+        write65c816(a, v);
+}
+
+/* Map the 4K page holding addr to host memory. NULL for either pointer
+ * sends that direction back to the platform routines. */
+
+void CPU_mapPage(word32 addr, byte *read, byte *write);
+
+/* Return every page to the platform routines */
+
+void CPU_unmapAll(void);
+
 /* These are the core memory access macros used in the 65816 emulator.
  * Set these to point to routines which handle your emulated machine's
  * memory access (generally these routines will check for access to
@@ -133,11 +177,11 @@ extern word32   cpu_cycle_count;
 
 #define EMUL_PIN_SYNC 1 // much more work to provide VPD and VPA
 #define EMUL_PIN_VP   2
-#define M_READ(a)         read65c816(a, 0)
+#define M_READ(a)         CPU_read(a)
 #define DB_READ(a)        read65c816(a, 1)
-#define M_READ_OPCODE(a)  read65c816(a, 0)
+#define M_READ_OPCODE(a)  CPU_read(a)
 #define M_READ_VECTOR(a)  read65c816(a, 0)
-#define M_WRITE(a,v)      write65c816((a),(v))
+#define M_WRITE(a,v)      CPU_write((a),(v))
 
 
 /* Set this macro to your emulator's "update" routine. Your update
@@ -203,6 +247,37 @@ void CPU_clearIRQ( word32 mask );
 
 void CPU_run(void);
 
+/* Set up the power on mode state. CPU_run() does this itself, call */
+/* it before the first CPU_execute().                               */
+
+void CPU_init(void);
+
+/* Run for at least the given number of cycles and return. The      */
+/* update macro is still called every update period.                */
+
+void CPU_execute(word32 cycles);
+
+/* The complete CPU state. The emulator works on a single live copy */
+/* of the state, so several 65816 machines can share a process by   */
+/* saving and loading their context around CPU_execute() calls.     */
+
+struct CPU_context {
+    dualw   A, D, S, X, Y;
+    byte    P, DB;
+    int     E;
+    word32  PC;
+    int     reset, abort, nmi, stop, wait, trace;
+    word32  irq;
+    word32  update_period;
+    word32  cycle_count;
+    word32  next_update;
+    byte    *read_page[CPU_PAGES];
+    byte    *write_page[CPU_PAGES];
+};
+
+void CPU_getContext(struct CPU_context *ctx);
+void CPU_setContext(const struct CPU_context *ctx);
+
 /* Internal routine called when the mode bits (e/m/x) change */
 
 void CPU_modeSwitch(void);
@@ -214,8 +289,6 @@ void CPU_debug(void);
 
 /* Platform routines */
 
-extern uint8_t read65c816(uint32_t addr, uint8_t mode);
-extern void write65c816(uint32_t addr, uint8_t value);
 extern void system_process(void);
 extern void wdm(void);
 
@@ -10,6 +10,7 @@
  * Modified for greater portability and virtual hardware independence.
  */
 
+#include <string.h>
 #include <lib65816/config.h>
 #include <lib65816/cpu.h>
 
@@ -22,6 +23,10 @@ int	cpu_wait;
 int	cpu_trace;
 
 word32	cpu_update_period;
+word32	cpu_next_update;
+
+byte	*cpu_read_page[CPU_PAGES];
+byte	*cpu_write_page[CPU_PAGES];
 #if defined( __sparc__ ) && defined( __GNUC__ )
 register word32	cpu_cycle_count asm ("g5");
 #else
@@ -62,3 +67,16 @@ void CPU_clearIRQ( word32 m )
 {
 	cpu_irq &= ~m;
 }
+
+void CPU_mapPage(word32 addr, byte *read, byte *write)
+{
+	word32 p = (addr >> CPU_PAGE_SHIFT) & (CPU_PAGES - 1);
+	cpu_read_page[p] = read;
+	cpu_write_page[p] = write;
+}
+
+void CPU_unmapAll(void)
+{
+	memset(cpu_read_page, 0, sizeof(cpu_read_page));
+	memset(cpu_write_page, 0, sizeof(cpu_write_page));
+}
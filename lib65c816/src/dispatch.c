@@ -15,6 +15,7 @@
 #include <lib65816/cpu.h>
 #include "cpumicro.h"
 #include <stdio.h>
+#include <string.h>
 
 dualw   A;  /* Accumulator               */
 dualw   D;  /* Direct Page Register      */
@@ -47,6 +48,7 @@ void        (**cpu_curr_opcode_table)();
 
 extern int  cpu_reset,cpu_abort,cpu_nmi,cpu_irq,cpu_stop,cpu_wait,cpu_trace;
 extern int  cpu_update_period;
+extern word32 cpu_next_update;
 
 extern void (*cpu_opcode_table[1300])();
 
@@ -149,21 +151,34 @@ byte    cpu_cycle_table[1300] =
 };
 #endif
 
-void CPU_run(void)
+void CPU_init(void)
 {
-    word32  last_update,next_update;
-    int opcode;
-
     cpu_cycle_count = 0;
-    last_update = 0;
-    next_update = cpu_update_period;
+    cpu_next_update = cpu_update_period;
     E = 1;
     F_setM(1);
     F_setX(1);
     CPU_modeSwitch();
+}
+
+void CPU_run(void)
+{
+    CPU_init();
+    for (;;)
+        CPU_execute(cpu_update_period);
+}
+
+void CPU_execute(word32 cycles)
+{
+    word32  end, next_event;
+    int opcode;
+
+    /* The update and the end of the run share one test per opcode */
+    end = cpu_cycle_count + cycles;
+    next_event = end < cpu_next_update ? end : cpu_next_update;
 
 dispatch:
-    if (cpu_cycle_count >= next_update) goto update;
+    if (cpu_cycle_count >= next_event) goto update;
 update_resume:
 #ifdef DEBUG
     if (cpu_trace) goto debug;
@@ -192,9 +207,13 @@ irq_return:
 /* we take the branch penalty (if there is one).            */
 
 update:
-    E_UPDATE(cpu_cycle_count);
-    last_update = cpu_cycle_count;
-    next_update = last_update + cpu_update_period;
+    if (cpu_cycle_count >= cpu_next_update) {
+        E_UPDATE(cpu_cycle_count);
+        cpu_next_update = cpu_cycle_count + cpu_update_period;
+    }
+    if (cpu_cycle_count >= end)
+        return;
+    next_event = end < cpu_next_update ? end : cpu_next_update;
     goto update_resume;
 
 #ifdef DEBUG
@@ -238,3 +257,55 @@ void CPU_modeSwitch(void) {
 #endif
     cpu_curr_opcode_table = cpu_opcode_table + opcode_offset;
 }
+
+void CPU_getContext(struct CPU_context *ctx)
+{
+    ctx->A = A;
+    ctx->D = D;
+    ctx->S = S;
+    ctx->X = X;
+    ctx->Y = Y;
+    ctx->P = P;
+    ctx->DB = DB;
+    ctx->E = E;
+    ctx->PC = PC.A;
+    ctx->reset = cpu_reset;
+    ctx->abort = cpu_abort;
+    ctx->nmi = cpu_nmi;
+    ctx->stop = cpu_stop;
+    ctx->wait = cpu_wait;
+    ctx->trace = cpu_trace;
+    ctx->irq = cpu_irq;
+    ctx->update_period = cpu_update_period;
+    ctx->cycle_count = cpu_cycle_count;
+    ctx->next_update = cpu_next_update;
+    memcpy(ctx->read_page, cpu_read_page, sizeof(cpu_read_page));
+    memcpy(ctx->write_page, cpu_write_page, sizeof(cpu_write_page));
+}
+
+void CPU_setContext(const struct CPU_context *ctx)
+{
+    A = ctx->A;
+    D = ctx->D;
+    S = ctx->S;
+    X = ctx->X;
+    Y = ctx->Y;
+    P = ctx->P;
+    DB = ctx->DB;
+    E = ctx->E;
+    PC.A = ctx->PC;
+    cpu_reset = ctx->reset;
+    cpu_abort = ctx->abort;
+    cpu_nmi = ctx->nmi;
+    cpu_stop = ctx->stop;
+    cpu_wait = ctx->wait;
+    cpu_trace = ctx->trace;
+    cpu_irq = ctx->irq;
+    cpu_update_period = ctx->update_period;
+    cpu_cycle_count = ctx->cycle_count;
+    cpu_next_update = ctx->next_update;
+    memcpy(cpu_read_page, ctx->read_page, sizeof(cpu_read_page));
+    memcpy(cpu_write_page, ctx->write_page, sizeof(cpu_write_page));
+    /* The dispatch table follows the mode bits */
+    CPU_modeSwitch();
+}
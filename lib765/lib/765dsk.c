@@ -170,7 +170,7 @@ static long fdd_lookup_track(DSK_FLOPPY_DRIVE *fdd, int cylinder, int head)
 		b = fdd->fdd_disk_header + 0x34;
 		for (nt = 0; nt < track; nt++)
 		{
-			trk_offset += 256 * (1 + b[nt]);
+			trk_offset += 256 * b[nt];
 		}
 	}
 	else	/* Normal; all tracks have the same length */
@@ -287,7 +287,7 @@ static long fdd_sector_offset(DSK_FLOPPY_DRIVE *fdd, int sector, int *seclen,
 	{
 		for (n = 0; n < maxsec; n++)
 		{
-			*seclen = (*secid)[7] + 256 * (*secid)[8];
+			*seclen = (*secid)[6] + 256 * (*secid)[7];
                        if ((*secid)[2] == sector) return offset;
 			offset   += (*seclen);
 			(*secid) += 8;
@@ -218,10 +218,13 @@ CP n
 
 CPDR
 	%CPD
-	if (WR.BC != 0 && !GETFLAG(F_Z))
+	while (WR.BC != 0 && !GETFLAG(F_Z))
 	{
 		ctx->tstates += 5;
 		ctx->PC -= 2;
+		if (!blockRepeat(ctx, -1))
+			break;
+		%CPD
 	}
 
 CPD
@@ -242,10 +245,13 @@ CPD
 
 CPIR
 	%CPI
-	if (WR.BC != 0 && !GETFLAG(F_Z))
+	while (WR.BC != 0 && !GETFLAG(F_Z))
 	{
 		ctx->tstates += 5;
 		ctx->PC -= 2;
+		if (!blockRepeat(ctx, -1))
+			break;
+		%CPI
 	}
 
 CPI
@@ -312,43 +318,35 @@ IN A,\(n\)
 
 INDR
 	%IND
-	if (BR.B != 0)
+	while (BR.B != 0)
 	{
 		ctx->tstates += 5;
 		ctx->PC -= 2;
+		if (!blockRepeat(ctx, (ushort)(WR.HL + 1)))
+			break;
+		if (!blockIn(ctx, -1))
+			%IND
 	}
 
 IND
 	ctx->tstates += 1;
-	byte val = ioRead(ctx, WR.BC);
-	write8(ctx, WR.HL, val);
-	WR.HL--;
-	BR.B = doIncDec(ctx, BR.B, ID_DEC);
-	VALFLAG(F_N, (val & 0x80) != 0);
-	int flagval = val + ((BR.C - 1) & 0xff);
-	VALFLAG(F_H, flagval > 0xff);
-	VALFLAG(F_C, flagval > 0xff);
-	VALFLAG(F_PV, parityBit[(flagval & 7) ^ BR.B]);
+	doINI(ctx, ioRead(ctx, WR.BC), -1);
 
 INIR
 	%INI
-	if (BR.B != 0)
+	while (BR.B != 0)
 	{
 		ctx->tstates += 5;
 		ctx->PC -= 2;
+		if (!blockRepeat(ctx, (ushort)(WR.HL - 1)))
+			break;
+		if (!blockIn(ctx, 1))
+			%INI
 	}
 
 INI
 	ctx->tstates += 1;
-	byte val = ioRead(ctx, WR.BC);
-	write8(ctx, WR.HL, val);
-	WR.HL++;
-	BR.B = doIncDec(ctx, BR.B, ID_DEC);
-	VALFLAG(F_N, (val & 0x80) != 0);
-	int flagval = val + ((BR.C + 1) & 0xff);
-	VALFLAG(F_H, flagval > 0xff);
-	VALFLAG(F_C, flagval > 0xff);
-	VALFLAG(F_PV, parityBit[(flagval & 7) ^ BR.B]);
+	doINI(ctx, ioRead(ctx, WR.BC), 1);
 
 #
 # Loads
@@ -453,10 +451,13 @@ LD (BC|DE|HL|SP|IX|IY),nn
 
 LDIR
 	%LDI
-	if (WR.BC != 0)
+	while (WR.BC != 0)
 	{
 		ctx->tstates += 5;
 		ctx->PC -= 2;
+		if (!blockRepeat(ctx, (ushort)(WR.DE - 1)))
+			break;
+		%LDI
 	}
 
 LDI
@@ -473,10 +474,13 @@ LDI
 
 LDDR
 	%LDD
-	if (WR.BC != 0)
+	while (WR.BC != 0)
 	{
 		ctx->tstates += 5;
 		ctx->PC -= 2;
+		if (!blockRepeat(ctx, (ushort)(WR.DE + 1)))
+			break;
+		%LDD
 	}
 
 LDD
@@ -507,19 +511,18 @@ OUTI
 	BR.B = doIncDec(ctx, BR.B, 1);
 	ioWrite(ctx, WR.BC, value);
 	WR.HL++;
-	int flag_value = value + BR.L;
-	VALFLAG(F_N, value & 0x80);
-	VALFLAG(F_H, flag_value > 0xff);
-	VALFLAG(F_C, flag_value > 0xff);
-	VALFLAG(F_PV, parityBit[(flag_value & 7) ^ BR.B]);
-	adjustFlags(ctx, BR.B);
+	doOUTIFlags(ctx, value);
 
 OTIR
 	%OUTI
-	if (BR.B != 0)
+	while (BR.B != 0)
 	{
 		ctx->tstates += 5;
 		ctx->PC -= 2;
+		if (!blockRepeat(ctx, -1))
+			break;
+		if (!blockOut(ctx, 1))
+			%OUTI
 	}
 
 OUTD
@@ -528,19 +531,18 @@ OUTD
 	BR.B = doIncDec(ctx, BR.B, 1);
 	ioWrite(ctx, WR.BC, value);
 	WR.HL--;
-	int flag_value = value + BR.L;
-	VALFLAG(F_N, value & 0x80);
-	VALFLAG(F_H, flag_value > 0xff);
-	VALFLAG(F_C, flag_value > 0xff);
-	VALFLAG(F_PV, parityBit[(flag_value & 7) ^ BR.B]);
-	adjustFlags(ctx, BR.B);
+	doOUTIFlags(ctx, value);
 
 OTDR
 	%OUTD
-	if (BR.B != 0)
+	while (BR.B != 0)
 	{
 		ctx->tstates += 5;
 		ctx->PC -= 2;
+		if (!blockRepeat(ctx, -1))
+			break;
+		if (!blockOut(ctx, -1))
+			%OUTD
 	}
 
 OUT \(C\),0
@@ -0,0 +1,1136 @@
+static void ADC_A_off_HL (Z80Context* ctx);
+static void ADC_A_off_IX_d (Z80Context* ctx);
+static void ADC_A_off_IY_d (Z80Context* ctx);
+static void ADC_A_A (Z80Context* ctx);
+static void ADC_A_B (Z80Context* ctx);
+static void ADC_A_C (Z80Context* ctx);
+static void ADC_A_D (Z80Context* ctx);
+static void ADC_A_E (Z80Context* ctx);
+static void ADC_A_H (Z80Context* ctx);
+static void ADC_A_IXh (Z80Context* ctx);
+static void ADC_A_IXl (Z80Context* ctx);
+static void ADC_A_IYh (Z80Context* ctx);
+static void ADC_A_IYl (Z80Context* ctx);
+static void ADC_A_L (Z80Context* ctx);
+static void ADC_A_n (Z80Context* ctx);
+static void ADC_HL_BC (Z80Context* ctx);
+static void ADC_HL_DE (Z80Context* ctx);
+static void ADC_HL_HL (Z80Context* ctx);
+static void ADC_HL_SP (Z80Context* ctx);
+static void ADD_A_off_HL (Z80Context* ctx);
+static void ADD_A_off_IX_d (Z80Context* ctx);
+static void ADD_A_off_IY_d (Z80Context* ctx);
+static void ADD_A_A (Z80Context* ctx);
+static void ADD_A_B (Z80Context* ctx);
+static void ADD_A_C (Z80Context* ctx);
+static void ADD_A_D (Z80Context* ctx);
+static void ADD_A_E (Z80Context* ctx);
+static void ADD_A_H (Z80Context* ctx);
+static void ADD_A_IXh (Z80Context* ctx);
+static void ADD_A_IXl (Z80Context* ctx);
+static void ADD_A_IYh (Z80Context* ctx);
+static void ADD_A_IYl (Z80Context* ctx);
+static void ADD_A_L (Z80Context* ctx);
+static void ADD_A_n (Z80Context* ctx);
+static void ADD_HL_BC (Z80Context* ctx);
+static void ADD_HL_DE (Z80Context* ctx);
+static void ADD_HL_HL (Z80Context* ctx);
+static void ADD_HL_SP (Z80Context* ctx);
+static void ADD_IX_BC (Z80Context* ctx);
+static void ADD_IX_DE (Z80Context* ctx);
+static void ADD_IX_IX (Z80Context* ctx);
+static void ADD_IX_SP (Z80Context* ctx);
+static void ADD_IY_BC (Z80Context* ctx);
+static void ADD_IY_DE (Z80Context* ctx);
+static void ADD_IY_IY (Z80Context* ctx);
+static void ADD_IY_SP (Z80Context* ctx);
+static void AND_off_HL (Z80Context* ctx);
+static void AND_off_IX_d (Z80Context* ctx);
+static void AND_off_IY_d (Z80Context* ctx);
+static void AND_A (Z80Context* ctx);
+static void AND_B (Z80Context* ctx);
+static void AND_C (Z80Context* ctx);
+static void AND_D (Z80Context* ctx);
+static void AND_E (Z80Context* ctx);
+static void AND_H (Z80Context* ctx);
+static void AND_IXh (Z80Context* ctx);
+static void AND_IXl (Z80Context* ctx);
+static void AND_IYh (Z80Context* ctx);
+static void AND_IYl (Z80Context* ctx);
+static void AND_L (Z80Context* ctx);
+static void AND_n (Z80Context* ctx);
+static void BIT_0_off_HL (Z80Context* ctx);
+static void BIT_0_off_IX_d (Z80Context* ctx);
+static void BIT_0_off_IY_d (Z80Context* ctx);
+static void BIT_0_A (Z80Context* ctx);
+static void BIT_0_B (Z80Context* ctx);
+static void BIT_0_C (Z80Context* ctx);
+static void BIT_0_D (Z80Context* ctx);
+static void BIT_0_E (Z80Context* ctx);
+static void BIT_0_H (Z80Context* ctx);
+static void BIT_0_L (Z80Context* ctx);
+static void BIT_1_off_HL (Z80Context* ctx);
+static void BIT_1_off_IX_d (Z80Context* ctx);
+static void BIT_1_off_IY_d (Z80Context* ctx);
+static void BIT_1_A (Z80Context* ctx);
+static void BIT_1_B (Z80Context* ctx);
+static void BIT_1_C (Z80Context* ctx);
+static void BIT_1_D (Z80Context* ctx);
+static void BIT_1_E (Z80Context* ctx);
+static void BIT_1_H (Z80Context* ctx);
+static void BIT_1_L (Z80Context* ctx);
+static void BIT_2_off_HL (Z80Context* ctx);
+static void BIT_2_off_IX_d (Z80Context* ctx);
+static void BIT_2_off_IY_d (Z80Context* ctx);
+static void BIT_2_A (Z80Context* ctx);
+static void BIT_2_B (Z80Context* ctx);
+static void BIT_2_C (Z80Context* ctx);
+static void BIT_2_D (Z80Context* ctx);
+static void BIT_2_E (Z80Context* ctx);
+static void BIT_2_H (Z80Context* ctx);
+static void BIT_2_L (Z80Context* ctx);
+static void BIT_3_off_HL (Z80Context* ctx);
+static void BIT_3_off_IX_d (Z80Context* ctx);
+static void BIT_3_off_IY_d (Z80Context* ctx);
+static void BIT_3_A (Z80Context* ctx);
+static void BIT_3_B (Z80Context* ctx);
+static void BIT_3_C (Z80Context* ctx);
+static void BIT_3_D (Z80Context* ctx);
+static void BIT_3_E (Z80Context* ctx);
+static void BIT_3_H (Z80Context* ctx);
+static void BIT_3_L (Z80Context* ctx);
+static void BIT_4_off_HL (Z80Context* ctx);
+static void BIT_4_off_IX_d (Z80Context* ctx);
+static void BIT_4_off_IY_d (Z80Context* ctx);
+static void BIT_4_A (Z80Context* ctx);
+static void BIT_4_B (Z80Context* ctx);
+static void BIT_4_C (Z80Context* ctx);
+static void BIT_4_D (Z80Context* ctx);
+static void BIT_4_E (Z80Context* ctx);
+static void BIT_4_H (Z80Context* ctx);
+static void BIT_4_L (Z80Context* ctx);
+static void BIT_5_off_HL (Z80Context* ctx);
+static void BIT_5_off_IX_d (Z80Context* ctx);
+static void BIT_5_off_IY_d (Z80Context* ctx);
+static void BIT_5_A (Z80Context* ctx);
+static void BIT_5_B (Z80Context* ctx);
+static void BIT_5_C (Z80Context* ctx);
+static void BIT_5_D (Z80Context* ctx);
+static void BIT_5_E (Z80Context* ctx);
+static void BIT_5_H (Z80Context* ctx);
+static void BIT_5_L (Z80Context* ctx);
+static void BIT_6_off_HL (Z80Context* ctx);
+static void BIT_6_off_IX_d (Z80Context* ctx);
+static void BIT_6_off_IY_d (Z80Context* ctx);
+static void BIT_6_A (Z80Context* ctx);
+static void BIT_6_B (Z80Context* ctx);
+static void BIT_6_C (Z80Context* ctx);
+static void BIT_6_D (Z80Context* ctx);
+static void BIT_6_E (Z80Context* ctx);
+static void BIT_6_H (Z80Context* ctx);
+static void BIT_6_L (Z80Context* ctx);
+static void BIT_7_off_HL (Z80Context* ctx);
+static void BIT_7_off_IX_d (Z80Context* ctx);
+static void BIT_7_off_IY_d (Z80Context* ctx);
+static void BIT_7_A (Z80Context* ctx);
+static void BIT_7_B (Z80Context* ctx);
+static void BIT_7_C (Z80Context* ctx);
+static void BIT_7_D (Z80Context* ctx);
+static void BIT_7_E (Z80Context* ctx);
+static void BIT_7_H (Z80Context* ctx);
+static void BIT_7_L (Z80Context* ctx);
+static void CALL_off_nn (Z80Context* ctx);
+static void CALL_C_off_nn (Z80Context* ctx);
+static void CALL_M_off_nn (Z80Context* ctx);
+static void CALL_NC_off_nn (Z80Context* ctx);
+static void CALL_NZ_off_nn (Z80Context* ctx);
+static void CALL_P_off_nn (Z80Context* ctx);
+static void CALL_PE_off_nn (Z80Context* ctx);
+static void CALL_PO_off_nn (Z80Context* ctx);
+static void CALL_Z_off_nn (Z80Context* ctx);
+static void CCF (Z80Context* ctx);
+static void CP_off_HL (Z80Context* ctx);
+static void CP_off_IX_d (Z80Context* ctx);
+static void CP_off_IY_d (Z80Context* ctx);
+static void CP_A (Z80Context* ctx);
+static void CP_B (Z80Context* ctx);
+static void CP_C (Z80Context* ctx);
+static void CP_D (Z80Context* ctx);
+static void CP_E (Z80Context* ctx);
+static void CP_H (Z80Context* ctx);
+static void CP_IXh (Z80Context* ctx);
+static void CP_IXl (Z80Context* ctx);
+static void CP_IYh (Z80Context* ctx);
+static void CP_IYl (Z80Context* ctx);
+static void CP_L (Z80Context* ctx);
+static void CP_n (Z80Context* ctx);
+static void CPD (Z80Context* ctx);
+static void CPDR (Z80Context* ctx);
+static void CPI (Z80Context* ctx);
+static void CPIR (Z80Context* ctx);
+static void CPL (Z80Context* ctx);
+static void DAA (Z80Context* ctx);
+static void DEC_off_HL (Z80Context* ctx);
+static void DEC_off_IX_d (Z80Context* ctx);
+static void DEC_off_IY_d (Z80Context* ctx);
+static void DEC_A (Z80Context* ctx);
+static void DEC_B (Z80Context* ctx);
+static void DEC_BC (Z80Context* ctx);
+static void DEC_C (Z80Context* ctx);
+static void DEC_D (Z80Context* ctx);
+static void DEC_DE (Z80Context* ctx);
+static void DEC_E (Z80Context* ctx);
+static void DEC_H (Z80Context* ctx);
+static void DEC_HL (Z80Context* ctx);
+static void DEC_IX (Z80Context* ctx);
+static void DEC_IXh (Z80Context* ctx);
+static void DEC_IXl (Z80Context* ctx);
+static void DEC_IY (Z80Context* ctx);
+static void DEC_IYh (Z80Context* ctx);
+static void DEC_IYl (Z80Context* ctx);
+static void DEC_L (Z80Context* ctx);
+static void DEC_SP (Z80Context* ctx);
+static void DI (Z80Context* ctx);
+static void DJNZ_off_PC_e (Z80Context* ctx);
+static void EI (Z80Context* ctx);
+static void EX_off_SP_HL (Z80Context* ctx);
+static void EX_off_SP_IX (Z80Context* ctx);
+static void EX_off_SP_IY (Z80Context* ctx);
+static void EX_AF_AF_ (Z80Context* ctx);
+static void EX_DE_HL (Z80Context* ctx);
+static void EXX (Z80Context* ctx);
+static void HALT (Z80Context* ctx);
+static void IM_0 (Z80Context* ctx);
+static void IM_1 (Z80Context* ctx);
+static void IM_2 (Z80Context* ctx);
+static void IN_A_off_C (Z80Context* ctx);
+static void IN_A_off_n (Z80Context* ctx);
+static void IN_B_off_C (Z80Context* ctx);
+static void IN_C_off_C (Z80Context* ctx);
+static void IN_D_off_C (Z80Context* ctx);
+static void IN_E_off_C (Z80Context* ctx);
+static void IN_F_off_C (Z80Context* ctx);
+static void IN_H_off_C (Z80Context* ctx);
+static void IN_L_off_C (Z80Context* ctx);
+static void INC_off_HL (Z80Context* ctx);
+static void INC_off_IX_d (Z80Context* ctx);
+static void INC_off_IY_d (Z80Context* ctx);
+static void INC_A (Z80Context* ctx);
+static void INC_B (Z80Context* ctx);
+static void INC_BC (Z80Context* ctx);
+static void INC_C (Z80Context* ctx);
+static void INC_D (Z80Context* ctx);
+static void INC_DE (Z80Context* ctx);
+static void INC_E (Z80Context* ctx);
+static void INC_H (Z80Context* ctx);
+static void INC_HL (Z80Context* ctx);
+static void INC_IX (Z80Context* ctx);
+static void INC_IXh (Z80Context* ctx);
+static void INC_IXl (Z80Context* ctx);
+static void INC_IY (Z80Context* ctx);
+static void INC_IYh (Z80Context* ctx);
+static void INC_IYl (Z80Context* ctx);
+static void INC_L (Z80Context* ctx);
+static void INC_SP (Z80Context* ctx);
+static void IND (Z80Context* ctx);
+static void INDR (Z80Context* ctx);
+static void INI (Z80Context* ctx);
+static void INIR (Z80Context* ctx);
+static void JP_off_HL (Z80Context* ctx);
+static void JP_off_IX (Z80Context* ctx);
+static void JP_off_IY (Z80Context* ctx);
+static void JP_off_nn (Z80Context* ctx);
+static void JP_C_off_nn (Z80Context* ctx);
+static void JP_M_off_nn (Z80Context* ctx);
+static void JP_NC_off_nn (Z80Context* ctx);
+static void JP_NZ_off_nn (Z80Context* ctx);
+static void JP_P_off_nn (Z80Context* ctx);
+static void JP_PE_off_nn (Z80Context* ctx);
+static void JP_PO_off_nn (Z80Context* ctx);
+static void JP_Z_off_nn (Z80Context* ctx);
+static void JR_off_PC_e (Z80Context* ctx);
+static void JR_C_off_PC_e (Z80Context* ctx);
+static void JR_NC_off_PC_e (Z80Context* ctx);
+static void JR_NZ_off_PC_e (Z80Context* ctx);
+static void JR_Z_off_PC_e (Z80Context* ctx);
+static void LD_off_BC_A (Z80Context* ctx);
+static void LD_off_DE_A (Z80Context* ctx);
+static void LD_off_HL_A (Z80Context* ctx);
+static void LD_off_HL_B (Z80Context* ctx);
+static void LD_off_HL_C (Z80Context* ctx);
+static void LD_off_HL_D (Z80Context* ctx);
+static void LD_off_HL_E (Z80Context* ctx);
+static void LD_off_HL_H (Z80Context* ctx);
+static void LD_off_HL_L (Z80Context* ctx);
+static void LD_off_HL_n (Z80Context* ctx);
+static void LD_off_IX_d_A (Z80Context* ctx);
+static void LD_off_IX_d_B (Z80Context* ctx);
+static void LD_off_IX_d_C (Z80Context* ctx);
+static void LD_off_IX_d_D (Z80Context* ctx);
+static void LD_off_IX_d_E (Z80Context* ctx);
+static void LD_off_IX_d_H (Z80Context* ctx);
+static void LD_off_IX_d_L (Z80Context* ctx);
+static void LD_off_IX_d_n (Z80Context* ctx);
+static void LD_off_IY_d_A (Z80Context* ctx);
+static void LD_off_IY_d_B (Z80Context* ctx);
+static void LD_off_IY_d_C (Z80Context* ctx);
+static void LD_off_IY_d_D (Z80Context* ctx);
+static void LD_off_IY_d_E (Z80Context* ctx);
+static void LD_off_IY_d_H (Z80Context* ctx);
+static void LD_off_IY_d_L (Z80Context* ctx);
+static void LD_off_IY_d_n (Z80Context* ctx);
+static void LD_off_nn_A (Z80Context* ctx);
+static void LD_off_nn_BC (Z80Context* ctx);
+static void LD_off_nn_DE (Z80Context* ctx);
+static void LD_off_nn_HL (Z80Context* ctx);
+static void LD_off_nn_IX (Z80Context* ctx);
+static void LD_off_nn_IY (Z80Context* ctx);
+static void LD_off_nn_SP (Z80Context* ctx);
+static void LD_A_off_BC (Z80Context* ctx);
+static void LD_A_off_DE (Z80Context* ctx);
+static void LD_A_off_HL (Z80Context* ctx);
+static void LD_A_off_IX_d (Z80Context* ctx);
+static void LD_A_off_IY_d (Z80Context* ctx);
+static void LD_A_off_nn (Z80Context* ctx);
+static void LD_A_A (Z80Context* ctx);
+static void LD_A_B (Z80Context* ctx);
+static void LD_A_C (Z80Context* ctx);
+static void LD_A_D (Z80Context* ctx);
+static void LD_A_E (Z80Context* ctx);
+static void LD_A_H (Z80Context* ctx);
+static void LD_A_I (Z80Context* ctx);
+static void LD_A_IXh (Z80Context* ctx);
+static void LD_A_IXl (Z80Context* ctx);
+static void LD_A_IYh (Z80Context* ctx);
+static void LD_A_IYl (Z80Context* ctx);
+static void LD_A_L (Z80Context* ctx);
+static void LD_A_n (Z80Context* ctx);
+static void LD_A_R (Z80Context* ctx);
+static void LD_A_RES_0_off_IX_d (Z80Context* ctx);
+static void LD_A_RES_0_off_IY_d (Z80Context* ctx);
+static void LD_A_RES_1_off_IX_d (Z80Context* ctx);
+static void LD_A_RES_1_off_IY_d (Z80Context* ctx);
+static void LD_A_RES_2_off_IX_d (Z80Context* ctx);
+static void LD_A_RES_2_off_IY_d (Z80Context* ctx);
+static void LD_A_RES_3_off_IX_d (Z80Context* ctx);
+static void LD_A_RES_3_off_IY_d (Z80Context* ctx);
+static void LD_A_RES_4_off_IX_d (Z80Context* ctx);
+static void LD_A_RES_4_off_IY_d (Z80Context* ctx);
+static void LD_A_RES_5_off_IX_d (Z80Context* ctx);
+static void LD_A_RES_5_off_IY_d (Z80Context* ctx);
+static void LD_A_RES_6_off_IX_d (Z80Context* ctx);
+static void LD_A_RES_6_off_IY_d (Z80Context* ctx);
+static void LD_A_RES_7_off_IX_d (Z80Context* ctx);
+static void LD_A_RES_7_off_IY_d (Z80Context* ctx);
+static void LD_A_RL_off_IX_d (Z80Context* ctx);
+static void LD_A_RL_off_IY_d (Z80Context* ctx);
+static void LD_A_RLC_off_IX_d (Z80Context* ctx);
+static void LD_A_RLC_off_IY_d (Z80Context* ctx);
+static void LD_A_RR_off_IX_d (Z80Context* ctx);
+static void LD_A_RR_off_IY_d (Z80Context* ctx);
+static void LD_A_RRC_off_IX_d (Z80Context* ctx);
+static void LD_A_RRC_off_IY_d (Z80Context* ctx);
+static void LD_A_SET_0_off_IX_d (Z80Context* ctx);
+static void LD_A_SET_0_off_IY_d (Z80Context* ctx);
+static void LD_A_SET_1_off_IX_d (Z80Context* ctx);
+static void LD_A_SET_1_off_IY_d (Z80Context* ctx);
+static void LD_A_SET_2_off_IX_d (Z80Context* ctx);
+static void LD_A_SET_2_off_IY_d (Z80Context* ctx);
+static void LD_A_SET_3_off_IX_d (Z80Context* ctx);
+static void LD_A_SET_3_off_IY_d (Z80Context* ctx);
+static void LD_A_SET_4_off_IX_d (Z80Context* ctx);
+static void LD_A_SET_4_off_IY_d (Z80Context* ctx);
+static void LD_A_SET_5_off_IX_d (Z80Context* ctx);
+static void LD_A_SET_5_off_IY_d (Z80Context* ctx);
+static void LD_A_SET_6_off_IX_d (Z80Context* ctx);
+static void LD_A_SET_6_off_IY_d (Z80Context* ctx);
+static void LD_A_SET_7_off_IX_d (Z80Context* ctx);
+static void LD_A_SET_7_off_IY_d (Z80Context* ctx);
+static void LD_A_SLA_off_IX_d (Z80Context* ctx);
+static void LD_A_SLA_off_IY_d (Z80Context* ctx);
+static void LD_A_SLL_off_IX_d (Z80Context* ctx);
+static void LD_A_SLL_off_IY_d (Z80Context* ctx);
+static void LD_A_SRA_off_IX_d (Z80Context* ctx);
+static void LD_A_SRA_off_IY_d (Z80Context* ctx);
+static void LD_A_SRL_off_IX_d (Z80Context* ctx);
+static void LD_A_SRL_off_IY_d (Z80Context* ctx);
+static void LD_B_off_HL (Z80Context* ctx);
+static void LD_B_off_IX_d (Z80Context* ctx);
+static void LD_B_off_IY_d (Z80Context* ctx);
+static void LD_B_A (Z80Context* ctx);
+static void LD_B_B (Z80Context* ctx);
+static void LD_B_C (Z80Context* ctx);
+static void LD_B_D (Z80Context* ctx);
+static void LD_B_E (Z80Context* ctx);
+static void LD_B_H (Z80Context* ctx);
+static void LD_B_IXh (Z80Context* ctx);
+static void LD_B_IXl (Z80Context* ctx);
+static void LD_B_IYh (Z80Context* ctx);
+static void LD_B_IYl (Z80Context* ctx);
+static void LD_B_L (Z80Context* ctx);
+static void LD_B_n (Z80Context* ctx);
+static void LD_B_RES_0_off_IX_d (Z80Context* ctx);
+static void LD_B_RES_0_off_IY_d (Z80Context* ctx);
+static void LD_B_RES_1_off_IX_d (Z80Context* ctx);
+static void LD_B_RES_1_off_IY_d (Z80Context* ctx);
+static void LD_B_RES_2_off_IX_d (Z80Context* ctx);
+static void LD_B_RES_2_off_IY_d (Z80Context* ctx);
+static void LD_B_RES_3_off_IX_d (Z80Context* ctx);
+static void LD_B_RES_3_off_IY_d (Z80Context* ctx);
+static void LD_B_RES_4_off_IX_d (Z80Context* ctx);
+static void LD_B_RES_4_off_IY_d (Z80Context* ctx);
+static void LD_B_RES_5_off_IX_d (Z80Context* ctx);
+static void LD_B_RES_5_off_IY_d (Z80Context* ctx);
+static void LD_B_RES_6_off_IX_d (Z80Context* ctx);
+static void LD_B_RES_6_off_IY_d (Z80Context* ctx);
+static void LD_B_RES_7_off_IX_d (Z80Context* ctx);
+static void LD_B_RES_7_off_IY_d (Z80Context* ctx);
+static void LD_B_RL_off_IX_d (Z80Context* ctx);
+static void LD_B_RL_off_IY_d (Z80Context* ctx);
+static void LD_B_RLC_off_IX_d (Z80Context* ctx);
+static void LD_B_RLC_off_IY_d (Z80Context* ctx);
+static void LD_B_RR_off_IX_d (Z80Context* ctx);
+static void LD_B_RR_off_IY_d (Z80Context* ctx);
+static void LD_B_RRC_off_IX_d (Z80Context* ctx);
+static void LD_B_RRC_off_IY_d (Z80Context* ctx);
+static void LD_B_SET_0_off_IX_d (Z80Context* ctx);
+static void LD_B_SET_0_off_IY_d (Z80Context* ctx);
+static void LD_B_SET_1_off_IX_d (Z80Context* ctx);
+static void LD_B_SET_1_off_IY_d (Z80Context* ctx);
+static void LD_B_SET_2_off_IX_d (Z80Context* ctx);
+static void LD_B_SET_2_off_IY_d (Z80Context* ctx);
+static void LD_B_SET_3_off_IX_d (Z80Context* ctx);
+static void LD_B_SET_3_off_IY_d (Z80Context* ctx);
+static void LD_B_SET_4_off_IX_d (Z80Context* ctx);
+static void LD_B_SET_4_off_IY_d (Z80Context* ctx);
+static void LD_B_SET_5_off_IX_d (Z80Context* ctx);
+static void LD_B_SET_5_off_IY_d (Z80Context* ctx);
+static void LD_B_SET_6_off_IX_d (Z80Context* ctx);
+static void LD_B_SET_6_off_IY_d (Z80Context* ctx);
+static void LD_B_SET_7_off_IX_d (Z80Context* ctx);
+static void LD_B_SET_7_off_IY_d (Z80Context* ctx);
+static void LD_B_SLA_off_IX_d (Z80Context* ctx);
+static void LD_B_SLA_off_IY_d (Z80Context* ctx);
+static void LD_B_SLL_off_IX_d (Z80Context* ctx);
+static void LD_B_SLL_off_IY_d (Z80Context* ctx);
+static void LD_B_SRA_off_IX_d (Z80Context* ctx);
+static void LD_B_SRA_off_IY_d (Z80Context* ctx);
+static void LD_B_SRL_off_IX_d (Z80Context* ctx);
+static void LD_B_SRL_off_IY_d (Z80Context* ctx);
+static void LD_BC_off_nn (Z80Context* ctx);
+static void LD_BC_nn (Z80Context* ctx);
+static void LD_C_off_HL (Z80Context* ctx);
+static void LD_C_off_IX_d (Z80Context* ctx);
+static void LD_C_off_IY_d (Z80Context* ctx);
+static void LD_C_A (Z80Context* ctx);
+static void LD_C_B (Z80Context* ctx);
+static void LD_C_C (Z80Context* ctx);
+static void LD_C_D (Z80Context* ctx);
+static void LD_C_E (Z80Context* ctx);
+static void LD_C_H (Z80Context* ctx);
+static void LD_C_IXh (Z80Context* ctx);
+static void LD_C_IXl (Z80Context* ctx);
+static void LD_C_IYh (Z80Context* ctx);
+static void LD_C_IYl (Z80Context* ctx);
+static void LD_C_L (Z80Context* ctx);
+static void LD_C_n (Z80Context* ctx);
+static void LD_C_RES_0_off_IX_d (Z80Context* ctx);
+static void LD_C_RES_0_off_IY_d (Z80Context* ctx);
+static void LD_C_RES_1_off_IX_d (Z80Context* ctx);
+static void LD_C_RES_1_off_IY_d (Z80Context* ctx);
+static void LD_C_RES_2_off_IX_d (Z80Context* ctx);
+static void LD_C_RES_2_off_IY_d (Z80Context* ctx);
+static void LD_C_RES_3_off_IX_d (Z80Context* ctx);
+static void LD_C_RES_3_off_IY_d (Z80Context* ctx);
+static void LD_C_RES_4_off_IX_d (Z80Context* ctx);
+static void LD_C_RES_4_off_IY_d (Z80Context* ctx);
+static void LD_C_RES_5_off_IX_d (Z80Context* ctx);
+static void LD_C_RES_5_off_IY_d (Z80Context* ctx);
+static void LD_C_RES_6_off_IX_d (Z80Context* ctx);
+static void LD_C_RES_6_off_IY_d (Z80Context* ctx);
+static void LD_C_RES_7_off_IX_d (Z80Context* ctx);
+static void LD_C_RES_7_off_IY_d (Z80Context* ctx);
+static void LD_C_RL_off_IX_d (Z80Context* ctx);
+static void LD_C_RL_off_IY_d (Z80Context* ctx);
+static void LD_C_RLC_off_IX_d (Z80Context* ctx);
+static void LD_C_RLC_off_IY_d (Z80Context* ctx);
+static void LD_C_RR_off_IX_d (Z80Context* ctx);
+static void LD_C_RR_off_IY_d (Z80Context* ctx);
+static void LD_C_RRC_off_IX_d (Z80Context* ctx);
+static void LD_C_RRC_off_IY_d (Z80Context* ctx);
+static void LD_C_SET_0_off_IX_d (Z80Context* ctx);
+static void LD_C_SET_0_off_IY_d (Z80Context* ctx);
+static void LD_C_SET_1_off_IX_d (Z80Context* ctx);
+static void LD_C_SET_1_off_IY_d (Z80Context* ctx);
+static void LD_C_SET_2_off_IX_d (Z80Context* ctx);
+static void LD_C_SET_2_off_IY_d (Z80Context* ctx);
+static void LD_C_SET_3_off_IX_d (Z80Context* ctx);
+static void LD_C_SET_3_off_IY_d (Z80Context* ctx);
+static void LD_C_SET_4_off_IX_d (Z80Context* ctx);
+static void LD_C_SET_4_off_IY_d (Z80Context* ctx);
+static void LD_C_SET_5_off_IX_d (Z80Context* ctx);
+static void LD_C_SET_5_off_IY_d (Z80Context* ctx);
+static void LD_C_SET_6_off_IX_d (Z80Context* ctx);
+static void LD_C_SET_6_off_IY_d (Z80Context* ctx);
+static void LD_C_SET_7_off_IX_d (Z80Context* ctx);
+static void LD_C_SET_7_off_IY_d (Z80Context* ctx);
+static void LD_C_SLA_off_IX_d (Z80Context* ctx);
+static void LD_C_SLA_off_IY_d (Z80Context* ctx);
+static void LD_C_SLL_off_IX_d (Z80Context* ctx);
+static void LD_C_SLL_off_IY_d (Z80Context* ctx);
+static void LD_C_SRA_off_IX_d (Z80Context* ctx);
+static void LD_C_SRA_off_IY_d (Z80Context* ctx);
+static void LD_C_SRL_off_IX_d (Z80Context* ctx);
+static void LD_C_SRL_off_IY_d (Z80Context* ctx);
+static void LD_D_off_HL (Z80Context* ctx);
+static void LD_D_off_IX_d (Z80Context* ctx);
+static void LD_D_off_IY_d (Z80Context* ctx);
+static void LD_D_A (Z80Context* ctx);
+static void LD_D_B (Z80Context* ctx);
+static void LD_D_C (Z80Context* ctx);
+static void LD_D_D (Z80Context* ctx);
+static void LD_D_E (Z80Context* ctx);
+static void LD_D_H (Z80Context* ctx);
+static void LD_D_IXh (Z80Context* ctx);
+static void LD_D_IXl (Z80Context* ctx);
+static void LD_D_IYh (Z80Context* ctx);
+static void LD_D_IYl (Z80Context* ctx);
+static void LD_D_L (Z80Context* ctx);
+static void LD_D_n (Z80Context* ctx);
+static void LD_D_RES_0_off_IX_d (Z80Context* ctx);
+static void LD_D_RES_0_off_IY_d (Z80Context* ctx);
+static void LD_D_RES_1_off_IX_d (Z80Context* ctx);
+static void LD_D_RES_1_off_IY_d (Z80Context* ctx);
+static void LD_D_RES_2_off_IX_d (Z80Context* ctx);
+static void LD_D_RES_2_off_IY_d (Z80Context* ctx);
+static void LD_D_RES_3_off_IX_d (Z80Context* ctx);
+static void LD_D_RES_3_off_IY_d (Z80Context* ctx);
+static void LD_D_RES_4_off_IX_d (Z80Context* ctx);
+static void LD_D_RES_4_off_IY_d (Z80Context* ctx);
+static void LD_D_RES_5_off_IX_d (Z80Context* ctx);
+static void LD_D_RES_5_off_IY_d (Z80Context* ctx);
+static void LD_D_RES_6_off_IX_d (Z80Context* ctx);
+static void LD_D_RES_6_off_IY_d (Z80Context* ctx);
+static void LD_D_RES_7_off_IX_d (Z80Context* ctx);
+static void LD_D_RES_7_off_IY_d (Z80Context* ctx);
+static void LD_D_RL_off_IX_d (Z80Context* ctx);
+static void LD_D_RL_off_IY_d (Z80Context* ctx);
+static void LD_D_RLC_off_IX_d (Z80Context* ctx);
+static void LD_D_RLC_off_IY_d (Z80Context* ctx);
+static void LD_D_RR_off_IX_d (Z80Context* ctx);
+static void LD_D_RR_off_IY_d (Z80Context* ctx);
+static void LD_D_RRC_off_IX_d (Z80Context* ctx);
+static void LD_D_RRC_off_IY_d (Z80Context* ctx);
+static void LD_D_SET_0_off_IX_d (Z80Context* ctx);
+static void LD_D_SET_0_off_IY_d (Z80Context* ctx);
+static void LD_D_SET_1_off_IX_d (Z80Context* ctx);
+static void LD_D_SET_1_off_IY_d (Z80Context* ctx);
+static void LD_D_SET_2_off_IX_d (Z80Context* ctx);
+static void LD_D_SET_2_off_IY_d (Z80Context* ctx);
+static void LD_D_SET_3_off_IX_d (Z80Context* ctx);
+static void LD_D_SET_3_off_IY_d (Z80Context* ctx);
+static void LD_D_SET_4_off_IX_d (Z80Context* ctx);
+static void LD_D_SET_4_off_IY_d (Z80Context* ctx);
+static void LD_D_SET_5_off_IX_d (Z80Context* ctx);
+static void LD_D_SET_5_off_IY_d (Z80Context* ctx);
+static void LD_D_SET_6_off_IX_d (Z80Context* ctx);
+static void LD_D_SET_6_off_IY_d (Z80Context* ctx);
+static void LD_D_SET_7_off_IX_d (Z80Context* ctx);
+static void LD_D_SET_7_off_IY_d (Z80Context* ctx);
+static void LD_D_SLA_off_IX_d (Z80Context* ctx);
+static void LD_D_SLA_off_IY_d (Z80Context* ctx);
+static void LD_D_SLL_off_IX_d (Z80Context* ctx);
+static void LD_D_SLL_off_IY_d (Z80Context* ctx);
+static void LD_D_SRA_off_IX_d (Z80Context* ctx);
+static void LD_D_SRA_off_IY_d (Z80Context* ctx);
+static void LD_D_SRL_off_IX_d (Z80Context* ctx);
+static void LD_D_SRL_off_IY_d (Z80Context* ctx);
+static void LD_DE_off_nn (Z80Context* ctx);
+static void LD_DE_nn (Z80Context* ctx);
+static void LD_E_off_HL (Z80Context* ctx);
+static void LD_E_off_IX_d (Z80Context* ctx);
+static void LD_E_off_IY_d (Z80Context* ctx);
+static void LD_E_A (Z80Context* ctx);
+static void LD_E_B (Z80Context* ctx);
+static void LD_E_C (Z80Context* ctx);
+static void LD_E_D (Z80Context* ctx);
+static void LD_E_E (Z80Context* ctx);
+static void LD_E_H (Z80Context* ctx);
+static void LD_E_IXh (Z80Context* ctx);
+static void LD_E_IXl (Z80Context* ctx);
+static void LD_E_IYh (Z80Context* ctx);
+static void LD_E_IYl (Z80Context* ctx);
+static void LD_E_L (Z80Context* ctx);
+static void LD_E_n (Z80Context* ctx);
+static void LD_E_RES_0_off_IX_d (Z80Context* ctx);
+static void LD_E_RES_0_off_IY_d (Z80Context* ctx);
+static void LD_E_RES_1_off_IX_d (Z80Context* ctx);
+static void LD_E_RES_1_off_IY_d (Z80Context* ctx);
+static void LD_E_RES_2_off_IX_d (Z80Context* ctx);
+static void LD_E_RES_2_off_IY_d (Z80Context* ctx);
+static void LD_E_RES_3_off_IX_d (Z80Context* ctx);
+static void LD_E_RES_3_off_IY_d (Z80Context* ctx);
+static void LD_E_RES_4_off_IX_d (Z80Context* ctx);
+static void LD_E_RES_4_off_IY_d (Z80Context* ctx);
+static void LD_E_RES_5_off_IX_d (Z80Context* ctx);
+static void LD_E_RES_5_off_IY_d (Z80Context* ctx);
+static void LD_E_RES_6_off_IX_d (Z80Context* ctx);
+static void LD_E_RES_6_off_IY_d (Z80Context* ctx);
+static void LD_E_RES_7_off_IX_d (Z80Context* ctx);
+static void LD_E_RES_7_off_IY_d (Z80Context* ctx);
+static void LD_E_RL_off_IX_d (Z80Context* ctx);
+static void LD_E_RL_off_IY_d (Z80Context* ctx);
+static void LD_E_RLC_off_IX_d (Z80Context* ctx);
+static void LD_E_RLC_off_IY_d (Z80Context* ctx);
+static void LD_E_RR_off_IX_d (Z80Context* ctx);
+static void LD_E_RR_off_IY_d (Z80Context* ctx);
+static void LD_E_RRC_off_IX_d (Z80Context* ctx);
+static void LD_E_RRC_off_IY_d (Z80Context* ctx);
+static void LD_E_SET_0_off_IX_d (Z80Context* ctx);
+static void LD_E_SET_0_off_IY_d (Z80Context* ctx);
+static void LD_E_SET_1_off_IX_d (Z80Context* ctx);
+static void LD_E_SET_1_off_IY_d (Z80Context* ctx);
+static void LD_E_SET_2_off_IX_d (Z80Context* ctx);
+static void LD_E_SET_2_off_IY_d (Z80Context* ctx);
+static void LD_E_SET_3_off_IX_d (Z80Context* ctx);
+static void LD_E_SET_3_off_IY_d (Z80Context* ctx);
+static void LD_E_SET_4_off_IX_d (Z80Context* ctx);
+static void LD_E_SET_4_off_IY_d (Z80Context* ctx);
+static void LD_E_SET_5_off_IX_d (Z80Context* ctx);
+static void LD_E_SET_5_off_IY_d (Z80Context* ctx);
+static void LD_E_SET_6_off_IX_d (Z80Context* ctx);
+static void LD_E_SET_6_off_IY_d (Z80Context* ctx);
+static void LD_E_SET_7_off_IX_d (Z80Context* ctx);
+static void LD_E_SET_7_off_IY_d (Z80Context* ctx);
+static void LD_E_SLA_off_IX_d (Z80Context* ctx);
+static void LD_E_SLA_off_IY_d (Z80Context* ctx);
+static void LD_E_SLL_off_IX_d (Z80Context* ctx);
+static void LD_E_SLL_off_IY_d (Z80Context* ctx);
+static void LD_E_SRA_off_IX_d (Z80Context* ctx);
+static void LD_E_SRA_off_IY_d (Z80Context* ctx);
+static void LD_E_SRL_off_IX_d (Z80Context* ctx);
+static void LD_E_SRL_off_IY_d (Z80Context* ctx);
+static void LD_H_off_HL (Z80Context* ctx);
+static void LD_H_off_IX_d (Z80Context* ctx);
+static void LD_H_off_IY_d (Z80Context* ctx);
+static void LD_H_A (Z80Context* ctx);
+static void LD_H_B (Z80Context* ctx);
+static void LD_H_C (Z80Context* ctx);
+static void LD_H_D (Z80Context* ctx);
+static void LD_H_E (Z80Context* ctx);
+static void LD_H_H (Z80Context* ctx);
+static void LD_H_L (Z80Context* ctx);
+static void LD_H_n (Z80Context* ctx);
+static void LD_H_RES_0_off_IX_d (Z80Context* ctx);
+static void LD_H_RES_0_off_IY_d (Z80Context* ctx);
+static void LD_H_RES_1_off_IX_d (Z80Context* ctx);
+static void LD_H_RES_1_off_IY_d (Z80Context* ctx);
+static void LD_H_RES_2_off_IX_d (Z80Context* ctx);
+static void LD_H_RES_2_off_IY_d (Z80Context* ctx);
+static void LD_H_RES_3_off_IX_d (Z80Context* ctx);
+static void LD_H_RES_3_off_IY_d (Z80Context* ctx);
+static void LD_H_RES_4_off_IX_d (Z80Context* ctx);
+static void LD_H_RES_4_off_IY_d (Z80Context* ctx);
+static void LD_H_RES_5_off_IX_d (Z80Context* ctx);
+static void LD_H_RES_5_off_IY_d (Z80Context* ctx);
+static void LD_H_RES_6_off_IX_d (Z80Context* ctx);
+static void LD_H_RES_6_off_IY_d (Z80Context* ctx);
+static void LD_H_RES_7_off_IX_d (Z80Context* ctx);
+static void LD_H_RES_7_off_IY_d (Z80Context* ctx);
+static void LD_H_RL_off_IX_d (Z80Context* ctx);
+static void LD_H_RL_off_IY_d (Z80Context* ctx);
+static void LD_H_RLC_off_IX_d (Z80Context* ctx);
+static void LD_H_RLC_off_IY_d (Z80Context* ctx);
+static void LD_H_RR_off_IX_d (Z80Context* ctx);
+static void LD_H_RR_off_IY_d (Z80Context* ctx);
+static void LD_H_RRC_off_IX_d (Z80Context* ctx);
+static void LD_H_RRC_off_IY_d (Z80Context* ctx);
+static void LD_H_SET_0_off_IX_d (Z80Context* ctx);
+static void LD_H_SET_0_off_IY_d (Z80Context* ctx);
+static void LD_H_SET_1_off_IX_d (Z80Context* ctx);
+static void LD_H_SET_1_off_IY_d (Z80Context* ctx);
+static void LD_H_SET_2_off_IX_d (Z80Context* ctx);
+static void LD_H_SET_2_off_IY_d (Z80Context* ctx);
+static void LD_H_SET_3_off_IX_d (Z80Context* ctx);
+static void LD_H_SET_3_off_IY_d (Z80Context* ctx);
+static void LD_H_SET_4_off_IX_d (Z80Context* ctx);
+static void LD_H_SET_4_off_IY_d (Z80Context* ctx);
+static void LD_H_SET_5_off_IX_d (Z80Context* ctx);
+static void LD_H_SET_5_off_IY_d (Z80Context* ctx);
+static void LD_H_SET_6_off_IX_d (Z80Context* ctx);
+static void LD_H_SET_6_off_IY_d (Z80Context* ctx);
+static void LD_H_SET_7_off_IX_d (Z80Context* ctx);
+static void LD_H_SET_7_off_IY_d (Z80Context* ctx);
+static void LD_H_SLA_off_IX_d (Z80Context* ctx);
+static void LD_H_SLA_off_IY_d (Z80Context* ctx);
+static void LD_H_SLL_off_IX_d (Z80Context* ctx);
+static void LD_H_SLL_off_IY_d (Z80Context* ctx);
+static void LD_H_SRA_off_IX_d (Z80Context* ctx);
+static void LD_H_SRA_off_IY_d (Z80Context* ctx);
+static void LD_H_SRL_off_IX_d (Z80Context* ctx);
+static void LD_H_SRL_off_IY_d (Z80Context* ctx);
+static void LD_HL_off_nn (Z80Context* ctx);
+static void LD_HL_nn (Z80Context* ctx);
+static void LD_I_A (Z80Context* ctx);
+static void LD_IX_off_nn (Z80Context* ctx);
+static void LD_IX_nn (Z80Context* ctx);
+static void LD_IXh_A (Z80Context* ctx);
+static void LD_IXh_B (Z80Context* ctx);
+static void LD_IXh_C (Z80Context* ctx);
+static void LD_IXh_D (Z80Context* ctx);
+static void LD_IXh_E (Z80Context* ctx);
+static void LD_IXh_IXh (Z80Context* ctx);
+static void LD_IXh_IXl (Z80Context* ctx);
+static void LD_IXh_n (Z80Context* ctx);
+static void LD_IXl_A (Z80Context* ctx);
+static void LD_IXl_B (Z80Context* ctx);
+static void LD_IXl_C (Z80Context* ctx);
+static void LD_IXl_D (Z80Context* ctx);
+static void LD_IXl_E (Z80Context* ctx);
+static void LD_IXl_IXh (Z80Context* ctx);
+static void LD_IXl_IXl (Z80Context* ctx);
+static void LD_IXl_n (Z80Context* ctx);
+static void LD_IY_off_nn (Z80Context* ctx);
+static void LD_IY_nn (Z80Context* ctx);
+static void LD_IYh_A (Z80Context* ctx);
+static void LD_IYh_B (Z80Context* ctx);
+static void LD_IYh_C (Z80Context* ctx);
+static void LD_IYh_D (Z80Context* ctx);
+static void LD_IYh_E (Z80Context* ctx);
+static void LD_IYh_IYh (Z80Context* ctx);
+static void LD_IYh_IYl (Z80Context* ctx);
+static void LD_IYh_n (Z80Context* ctx);
+static void LD_IYl_A (Z80Context* ctx);
+static void LD_IYl_B (Z80Context* ctx);
+static void LD_IYl_C (Z80Context* ctx);
+static void LD_IYl_D (Z80Context* ctx);
+static void LD_IYl_E (Z80Context* ctx);
+static void LD_IYl_IYh (Z80Context* ctx);
+static void LD_IYl_IYl (Z80Context* ctx);
+static void LD_IYl_n (Z80Context* ctx);
+static void LD_L_off_HL (Z80Context* ctx);
+static void LD_L_off_IX_d (Z80Context* ctx);
+static void LD_L_off_IY_d (Z80Context* ctx);
+static void LD_L_A (Z80Context* ctx);
+static void LD_L_B (Z80Context* ctx);
+static void LD_L_C (Z80Context* ctx);
+static void LD_L_D (Z80Context* ctx);
+static void LD_L_E (Z80Context* ctx);
+static void LD_L_H (Z80Context* ctx);
+static void LD_L_L (Z80Context* ctx);
+static void LD_L_n (Z80Context* ctx);
+static void LD_L_RES_0_off_IX_d (Z80Context* ctx);
+static void LD_L_RES_0_off_IY_d (Z80Context* ctx);
+static void LD_L_RES_1_off_IX_d (Z80Context* ctx);
+static void LD_L_RES_1_off_IY_d (Z80Context* ctx);
+static void LD_L_RES_2_off_IX_d (Z80Context* ctx);
+static void LD_L_RES_2_off_IY_d (Z80Context* ctx);
+static void LD_L_RES_3_off_IX_d (Z80Context* ctx);
+static void LD_L_RES_3_off_IY_d (Z80Context* ctx);
+static void LD_L_RES_4_off_IX_d (Z80Context* ctx);
+static void LD_L_RES_4_off_IY_d (Z80Context* ctx);
+static void LD_L_RES_5_off_IX_d (Z80Context* ctx);
+static void LD_L_RES_5_off_IY_d (Z80Context* ctx);
+static void LD_L_RES_6_off_IX_d (Z80Context* ctx);
+static void LD_L_RES_6_off_IY_d (Z80Context* ctx);
+static void LD_L_RES_7_off_IX_d (Z80Context* ctx);
+static void LD_L_RES_7_off_IY_d (Z80Context* ctx);
+static void LD_L_RL_off_IX_d (Z80Context* ctx);
+static void LD_L_RL_off_IY_d (Z80Context* ctx);
+static void LD_L_RLC_off_IX_d (Z80Context* ctx);
+static void LD_L_RLC_off_IY_d (Z80Context* ctx);
+static void LD_L_RR_off_IX_d (Z80Context* ctx);
+static void LD_L_RR_off_IY_d (Z80Context* ctx);
+static void LD_L_RRC_off_IX_d (Z80Context* ctx);
+static void LD_L_RRC_off_IY_d (Z80Context* ctx);
+static void LD_L_SET_0_off_IX_d (Z80Context* ctx);
+static void LD_L_SET_0_off_IY_d (Z80Context* ctx);
+static void LD_L_SET_1_off_IX_d (Z80Context* ctx);
+static void LD_L_SET_1_off_IY_d (Z80Context* ctx);
+static void LD_L_SET_2_off_IX_d (Z80Context* ctx);
+static void LD_L_SET_2_off_IY_d (Z80Context* ctx);
+static void LD_L_SET_3_off_IX_d (Z80Context* ctx);
+static void LD_L_SET_3_off_IY_d (Z80Context* ctx);
+static void LD_L_SET_4_off_IX_d (Z80Context* ctx);
+static void LD_L_SET_4_off_IY_d (Z80Context* ctx);
+static void LD_L_SET_5_off_IX_d (Z80Context* ctx);
+static void LD_L_SET_5_off_IY_d (Z80Context* ctx);
+static void LD_L_SET_6_off_IX_d (Z80Context* ctx);
+static void LD_L_SET_6_off_IY_d (Z80Context* ctx);
+static void LD_L_SET_7_off_IX_d (Z80Context* ctx);
+static void LD_L_SET_7_off_IY_d (Z80Context* ctx);
+static void LD_L_SLA_off_IX_d (Z80Context* ctx);
+static void LD_L_SLA_off_IY_d (Z80Context* ctx);
+static void LD_L_SLL_off_IX_d (Z80Context* ctx);
+static void LD_L_SLL_off_IY_d (Z80Context* ctx);
+static void LD_L_SRA_off_IX_d (Z80Context* ctx);
+static void LD_L_SRA_off_IY_d (Z80Context* ctx);
+static void LD_L_SRL_off_IX_d (Z80Context* ctx);
+static void LD_L_SRL_off_IY_d (Z80Context* ctx);
+static void LD_R_A (Z80Context* ctx);
+static void LD_SP_off_nn (Z80Context* ctx);
+static void LD_SP_HL (Z80Context* ctx);
+static void LD_SP_IX (Z80Context* ctx);
+static void LD_SP_IY (Z80Context* ctx);
+static void LD_SP_nn (Z80Context* ctx);
+static void LDD (Z80Context* ctx);
+static void LDDR (Z80Context* ctx);
+static void LDI (Z80Context* ctx);
+static void LDIR (Z80Context* ctx);
+static void NEG (Z80Context* ctx);
+static void NOP (Z80Context* ctx);
+static void OR_off_HL (Z80Context* ctx);
+static void OR_off_IX_d (Z80Context* ctx);
+static void OR_off_IY_d (Z80Context* ctx);
+static void OR_A (Z80Context* ctx);
+static void OR_B (Z80Context* ctx);
+static void OR_C (Z80Context* ctx);
+static void OR_D (Z80Context* ctx);
+static void OR_E (Z80Context* ctx);
+static void OR_H (Z80Context* ctx);
+static void OR_IXh (Z80Context* ctx);
+static void OR_IXl (Z80Context* ctx);
+static void OR_IYh (Z80Context* ctx);
+static void OR_IYl (Z80Context* ctx);
+static void OR_L (Z80Context* ctx);
+static void OR_n (Z80Context* ctx);
+static void OTDR (Z80Context* ctx);
+static void OTIR (Z80Context* ctx);
+static void OUT_off_C_0 (Z80Context* ctx);
+static void OUT_off_C_A (Z80Context* ctx);
+static void OUT_off_C_B (Z80Context* ctx);
+static void OUT_off_C_C (Z80Context* ctx);
+static void OUT_off_C_D (Z80Context* ctx);
+static void OUT_off_C_E (Z80Context* ctx);
+static void OUT_off_C_H (Z80Context* ctx);
+static void OUT_off_C_L (Z80Context* ctx);
+static void OUT_off_n_A (Z80Context* ctx);
+static void OUTD (Z80Context* ctx);
+static void OUTI (Z80Context* ctx);
+static void POP_AF (Z80Context* ctx);
+static void POP_BC (Z80Context* ctx);
+static void POP_DE (Z80Context* ctx);
+static void POP_HL (Z80Context* ctx);
+static void POP_IX (Z80Context* ctx);
+static void POP_IY (Z80Context* ctx);
+static void PUSH_AF (Z80Context* ctx);
+static void PUSH_BC (Z80Context* ctx);
+static void PUSH_DE (Z80Context* ctx);
+static void PUSH_HL (Z80Context* ctx);
+static void PUSH_IX (Z80Context* ctx);
+static void PUSH_IY (Z80Context* ctx);
+static void RES_0_off_HL (Z80Context* ctx);
+static void RES_0_off_IX_d (Z80Context* ctx);
+static void RES_0_off_IY_d (Z80Context* ctx);
+static void RES_0_A (Z80Context* ctx);
+static void RES_0_B (Z80Context* ctx);
+static void RES_0_C (Z80Context* ctx);
+static void RES_0_D (Z80Context* ctx);
+static void RES_0_E (Z80Context* ctx);
+static void RES_0_H (Z80Context* ctx);
+static void RES_0_L (Z80Context* ctx);
+static void RES_1_off_HL (Z80Context* ctx);
+static void RES_1_off_IX_d (Z80Context* ctx);
+static void RES_1_off_IY_d (Z80Context* ctx);
+static void RES_1_A (Z80Context* ctx);
+static void RES_1_B (Z80Context* ctx);
+static void RES_1_C (Z80Context* ctx);
+static void RES_1_D (Z80Context* ctx);
+static void RES_1_E (Z80Context* ctx);
+static void RES_1_H (Z80Context* ctx);
+static void RES_1_L (Z80Context* ctx);
+static void RES_2_off_HL (Z80Context* ctx);
+static void RES_2_off_IX_d (Z80Context* ctx);
+static void RES_2_off_IY_d (Z80Context* ctx);
+static void RES_2_A (Z80Context* ctx);
+static void RES_2_B (Z80Context* ctx);
+static void RES_2_C (Z80Context* ctx);
+static void RES_2_D (Z80Context* ctx);
+static void RES_2_E (Z80Context* ctx);
+static void RES_2_H (Z80Context* ctx);
+static void RES_2_L (Z80Context* ctx);
+static void RES_3_off_HL (Z80Context* ctx);
+static void RES_3_off_IX_d (Z80Context* ctx);
+static void RES_3_off_IY_d (Z80Context* ctx);
+static void RES_3_A (Z80Context* ctx);
+static void RES_3_B (Z80Context* ctx);
+static void RES_3_C (Z80Context* ctx);
+static void RES_3_D (Z80Context* ctx);
+static void RES_3_E (Z80Context* ctx);
+static void RES_3_H (Z80Context* ctx);
+static void RES_3_L (Z80Context* ctx);
+static void RES_4_off_HL (Z80Context* ctx);
+static void RES_4_off_IX_d (Z80Context* ctx);
+static void RES_4_off_IY_d (Z80Context* ctx);
+static void RES_4_A (Z80Context* ctx);
+static void RES_4_B (Z80Context* ctx);
+static void RES_4_C (Z80Context* ctx);
+static void RES_4_D (Z80Context* ctx);
+static void RES_4_E (Z80Context* ctx);
+static void RES_4_H (Z80Context* ctx);
+static void RES_4_L (Z80Context* ctx);
+static void RES_5_off_HL (Z80Context* ctx);
+static void RES_5_off_IX_d (Z80Context* ctx);
+static void RES_5_off_IY_d (Z80Context* ctx);
+static void RES_5_A (Z80Context* ctx);
+static void RES_5_B (Z80Context* ctx);
+static void RES_5_C (Z80Context* ctx);
+static void RES_5_D (Z80Context* ctx);
+static void RES_5_E (Z80Context* ctx);
+static void RES_5_H (Z80Context* ctx);
+static void RES_5_L (Z80Context* ctx);
+static void RES_6_off_HL (Z80Context* ctx);
+static void RES_6_off_IX_d (Z80Context* ctx);
+static void RES_6_off_IY_d (Z80Context* ctx);
+static void RES_6_A (Z80Context* ctx);
+static void RES_6_B (Z80Context* ctx);
+static void RES_6_C (Z80Context* ctx);
+static void RES_6_D (Z80Context* ctx);
+static void RES_6_E (Z80Context* ctx);
+static void RES_6_H (Z80Context* ctx);
+static void RES_6_L (Z80Context* ctx);
+static void RES_7_off_HL (Z80Context* ctx);
+static void RES_7_off_IX_d (Z80Context* ctx);
+static void RES_7_off_IY_d (Z80Context* ctx);
+static void RES_7_A (Z80Context* ctx);
+static void RES_7_B (Z80Context* ctx);
+static void RES_7_C (Z80Context* ctx);
+static void RES_7_D (Z80Context* ctx);
+static void RES_7_E (Z80Context* ctx);
+static void RES_7_H (Z80Context* ctx);
+static void RES_7_L (Z80Context* ctx);
+static void RET (Z80Context* ctx);
+static void RET_C (Z80Context* ctx);
+static void RET_M (Z80Context* ctx);
+static void RET_NC (Z80Context* ctx);
+static void RET_NZ (Z80Context* ctx);
+static void RET_P (Z80Context* ctx);
+static void RET_PE (Z80Context* ctx);
+static void RET_PO (Z80Context* ctx);
+static void RET_Z (Z80Context* ctx);
+static void RETI (Z80Context* ctx);
+static void RETN (Z80Context* ctx);
+static void RL_off_HL (Z80Context* ctx);
+static void RL_off_IX_d (Z80Context* ctx);
+static void RL_off_IY_d (Z80Context* ctx);
+static void RL_A (Z80Context* ctx);
+static void RL_B (Z80Context* ctx);
+static void RL_C (Z80Context* ctx);
+static void RL_D (Z80Context* ctx);
+static void RL_E (Z80Context* ctx);
+static void RL_H (Z80Context* ctx);
+static void RL_L (Z80Context* ctx);
+static void RLA (Z80Context* ctx);
+static void RLC_off_HL (Z80Context* ctx);
+static void RLC_off_IX_d (Z80Context* ctx);
+static void RLC_off_IY_d (Z80Context* ctx);
+static void RLC_A (Z80Context* ctx);
+static void RLC_B (Z80Context* ctx);
+static void RLC_C (Z80Context* ctx);
+static void RLC_D (Z80Context* ctx);
+static void RLC_E (Z80Context* ctx);
+static void RLC_H (Z80Context* ctx);
+static void RLC_L (Z80Context* ctx);
+static void RLCA (Z80Context* ctx);
+static void RLD (Z80Context* ctx);
+static void RR_off_HL (Z80Context* ctx);
+static void RR_off_IX_d (Z80Context* ctx);
+static void RR_off_IY_d (Z80Context* ctx);
+static void RR_A (Z80Context* ctx);
+static void RR_B (Z80Context* ctx);
+static void RR_C (Z80Context* ctx);
+static void RR_D (Z80Context* ctx);
+static void RR_E (Z80Context* ctx);
+static void RR_H (Z80Context* ctx);
+static void RR_L (Z80Context* ctx);
+static void RRA (Z80Context* ctx);
+static void RRC_off_HL (Z80Context* ctx);
+static void RRC_off_IX_d (Z80Context* ctx);
+static void RRC_off_IY_d (Z80Context* ctx);
+static void RRC_A (Z80Context* ctx);
+static void RRC_B (Z80Context* ctx);
+static void RRC_C (Z80Context* ctx);
+static void RRC_D (Z80Context* ctx);
+static void RRC_E (Z80Context* ctx);
+static void RRC_H (Z80Context* ctx);
+static void RRC_L (Z80Context* ctx);
+static void RRCA (Z80Context* ctx);
+static void RRD (Z80Context* ctx);
+static void RST_0H (Z80Context* ctx);
+static void RST_10H (Z80Context* ctx);
+static void RST_18H (Z80Context* ctx);
+static void RST_20H (Z80Context* ctx);
+static void RST_28H (Z80Context* ctx);
+static void RST_30H (Z80Context* ctx);
+static void RST_38H (Z80Context* ctx);
+static void RST_8H (Z80Context* ctx);
+static void SBC_A_off_HL (Z80Context* ctx);
+static void SBC_A_off_IX_d (Z80Context* ctx);
+static void SBC_A_off_IY_d (Z80Context* ctx);
+static void SBC_A_A (Z80Context* ctx);
+static void SBC_A_B (Z80Context* ctx);
+static void SBC_A_C (Z80Context* ctx);
+static void SBC_A_D (Z80Context* ctx);
+static void SBC_A_E (Z80Context* ctx);
+static void SBC_A_H (Z80Context* ctx);
+static void SBC_A_IXh (Z80Context* ctx);
+static void SBC_A_IXl (Z80Context* ctx);
+static void SBC_A_IYh (Z80Context* ctx);
+static void SBC_A_IYl (Z80Context* ctx);
+static void SBC_A_L (Z80Context* ctx);
+static void SBC_A_n (Z80Context* ctx);
+static void SBC_HL_BC (Z80Context* ctx);
+static void SBC_HL_DE (Z80Context* ctx);
+static void SBC_HL_HL (Z80Context* ctx);
+static void SBC_HL_SP (Z80Context* ctx);
+static void SCF (Z80Context* ctx);
+static void SET_0_off_HL (Z80Context* ctx);
+static void SET_0_off_IX_d (Z80Context* ctx);
+static void SET_0_off_IY_d (Z80Context* ctx);
+static void SET_0_A (Z80Context* ctx);
+static void SET_0_B (Z80Context* ctx);
+static void SET_0_C (Z80Context* ctx);
+static void SET_0_D (Z80Context* ctx);
+static void SET_0_E (Z80Context* ctx);
+static void SET_0_H (Z80Context* ctx);
+static void SET_0_L (Z80Context* ctx);
+static void SET_1_off_HL (Z80Context* ctx);
+static void SET_1_off_IX_d (Z80Context* ctx);
+static void SET_1_off_IY_d (Z80Context* ctx);
+static void SET_1_A (Z80Context* ctx);
+static void SET_1_B (Z80Context* ctx);
+static void SET_1_C (Z80Context* ctx);
+static void SET_1_D (Z80Context* ctx);
+static void SET_1_E (Z80Context* ctx);
+static void SET_1_H (Z80Context* ctx);
+static void SET_1_L (Z80Context* ctx);
+static void SET_2_off_HL (Z80Context* ctx);
+static void SET_2_off_IX_d (Z80Context* ctx);
+static void SET_2_off_IY_d (Z80Context* ctx);
+static void SET_2_A (Z80Context* ctx);
+static void SET_2_B (Z80Context* ctx);
+static void SET_2_C (Z80Context* ctx);
+static void SET_2_D (Z80Context* ctx);
+static void SET_2_E (Z80Context* ctx);
+static void SET_2_H (Z80Context* ctx);
+static void SET_2_L (Z80Context* ctx);
+static void SET_3_off_HL (Z80Context* ctx);
+static void SET_3_off_IX_d (Z80Context* ctx);
+static void SET_3_off_IY_d (Z80Context* ctx);
+static void SET_3_A (Z80Context* ctx);
+static void SET_3_B (Z80Context* ctx);
+static void SET_3_C (Z80Context* ctx);
+static void SET_3_D (Z80Context* ctx);
+static void SET_3_E (Z80Context* ctx);
+static void SET_3_H (Z80Context* ctx);
+static void SET_3_L (Z80Context* ctx);
+static void SET_4_off_HL (Z80Context* ctx);
+static void SET_4_off_IX_d (Z80Context* ctx);
+static void SET_4_off_IY_d (Z80Context* ctx);
+static void SET_4_A (Z80Context* ctx);
+static void SET_4_B (Z80Context* ctx);
+static void SET_4_C (Z80Context* ctx);
+static void SET_4_D (Z80Context* ctx);
+static void SET_4_E (Z80Context* ctx);
+static void SET_4_H (Z80Context* ctx);
+static void SET_4_L (Z80Context* ctx);
+static void SET_5_off_HL (Z80Context* ctx);
+static void SET_5_off_IX_d (Z80Context* ctx);
+static void SET_5_off_IY_d (Z80Context* ctx);
+static void SET_5_A (Z80Context* ctx);
+static void SET_5_B (Z80Context* ctx);
+static void SET_5_C (Z80Context* ctx);
+static void SET_5_D (Z80Context* ctx);
+static void SET_5_E (Z80Context* ctx);
+static void SET_5_H (Z80Context* ctx);
+static void SET_5_L (Z80Context* ctx);
+static void SET_6_off_HL (Z80Context* ctx);
+static void SET_6_off_IX_d (Z80Context* ctx);
+static void SET_6_off_IY_d (Z80Context* ctx);
+static void SET_6_A (Z80Context* ctx);
+static void SET_6_B (Z80Context* ctx);
+static void SET_6_C (Z80Context* ctx);
+static void SET_6_D (Z80Context* ctx);
+static void SET_6_E (Z80Context* ctx);
+static void SET_6_H (Z80Context* ctx);
+static void SET_6_L (Z80Context* ctx);
+static void SET_7_off_HL (Z80Context* ctx);
+static void SET_7_off_IX_d (Z80Context* ctx);
+static void SET_7_off_IY_d (Z80Context* ctx);
+static void SET_7_A (Z80Context* ctx);
+static void SET_7_B (Z80Context* ctx);
+static void SET_7_C (Z80Context* ctx);
+static void SET_7_D (Z80Context* ctx);
+static void SET_7_E (Z80Context* ctx);
+static void SET_7_H (Z80Context* ctx);
+static void SET_7_L (Z80Context* ctx);
+static void SLA_off_HL (Z80Context* ctx);
+static void SLA_off_IX_d (Z80Context* ctx);
+static void SLA_off_IY_d (Z80Context* ctx);
+static void SLA_A (Z80Context* ctx);
+static void SLA_B (Z80Context* ctx);
+static void SLA_C (Z80Context* ctx);
+static void SLA_D (Z80Context* ctx);
+static void SLA_E (Z80Context* ctx);
+static void SLA_H (Z80Context* ctx);
+static void SLA_L (Z80Context* ctx);
+static void SLL_off_HL (Z80Context* ctx);
+static void SLL_off_IX_d (Z80Context* ctx);
+static void SLL_off_IY_d (Z80Context* ctx);
+static void SLL_A (Z80Context* ctx);
+static void SLL_B (Z80Context* ctx);
+static void SLL_C (Z80Context* ctx);
+static void SLL_D (Z80Context* ctx);
+static void SLL_E (Z80Context* ctx);
+static void SLL_H (Z80Context* ctx);
+static void SLL_L (Z80Context* ctx);
+static void SRA_off_HL (Z80Context* ctx);
+static void SRA_off_IX_d (Z80Context* ctx);
+static void SRA_off_IY_d (Z80Context* ctx);
+static void SRA_A (Z80Context* ctx);
+static void SRA_B (Z80Context* ctx);
+static void SRA_C (Z80Context* ctx);
+static void SRA_D (Z80Context* ctx);
+static void SRA_E (Z80Context* ctx);
+static void SRA_H (Z80Context* ctx);
+static void SRA_L (Z80Context* ctx);
+static void SRL_off_HL (Z80Context* ctx);
+static void SRL_off_IX_d (Z80Context* ctx);
+static void SRL_off_IY_d (Z80Context* ctx);
+static void SRL_A (Z80Context* ctx);
+static void SRL_B (Z80Context* ctx);
+static void SRL_C (Z80Context* ctx);
+static void SRL_D (Z80Context* ctx);
+static void SRL_E (Z80Context* ctx);
+static void SRL_H (Z80Context* ctx);
+static void SRL_L (Z80Context* ctx);
+static void SUB_A_off_HL (Z80Context* ctx);
+static void SUB_A_off_IX_d (Z80Context* ctx);
+static void SUB_A_off_IY_d (Z80Context* ctx);
+static void SUB_A_A (Z80Context* ctx);
+static void SUB_A_B (Z80Context* ctx);
+static void SUB_A_C (Z80Context* ctx);
+static void SUB_A_D (Z80Context* ctx);
+static void SUB_A_E (Z80Context* ctx);
+static void SUB_A_H (Z80Context* ctx);
+static void SUB_A_IXh (Z80Context* ctx);
+static void SUB_A_IXl (Z80Context* ctx);
+static void SUB_A_IYh (Z80Context* ctx);
+static void SUB_A_IYl (Z80Context* ctx);
+static void SUB_A_L (Z80Context* ctx);
+static void SUB_A_n (Z80Context* ctx);
+static void XOR_off_HL (Z80Context* ctx);
+static void XOR_off_IX_d (Z80Context* ctx);
+static void XOR_off_IY_d (Z80Context* ctx);
+static void XOR_A (Z80Context* ctx);
+static void XOR_B (Z80Context* ctx);
+static void XOR_C (Z80Context* ctx);
+static void XOR_D (Z80Context* ctx);
+static void XOR_E (Z80Context* ctx);
+static void XOR_H (Z80Context* ctx);
+static void XOR_IXh (Z80Context* ctx);
+static void XOR_IXl (Z80Context* ctx);
+static void XOR_IYh (Z80Context* ctx);
+static void XOR_IYl (Z80Context* ctx);
+static void XOR_L (Z80Context* ctx);
+static void XOR_n (Z80Context* ctx);
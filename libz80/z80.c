@@ -650,6 +650,135 @@ static void doDAA(Z80Context * ctx) {
   adjustFlags(ctx, BR.A);
 }
  
+
+/* ---------------------------------------------------------
+ *  Block instructions
+ * --------------------------------------------------------- 
+ */
+
+/* The data movement and flags of INI/IND */
+static void doINI (Z80Context* ctx, byte val, int dir)
+{
+	write8(ctx, WR.HL, val);
+	WR.HL += dir;
+	BR.B = doIncDec(ctx, BR.B, ID_DEC);
+	VALFLAG(F_N, (val & 0x80) != 0);
+	int flagval = val + ((BR.C + dir) & 0xff);
+	VALFLAG(F_H, flagval > 0xff);
+	VALFLAG(F_C, flagval > 0xff);
+	VALFLAG(F_PV, parityBit[(flagval & 7) ^ BR.B]);
+}
+
+
+/* The flags of OUTI/OUTD once B and HL are updated */
+static void doOUTIFlags (Z80Context* ctx, byte value)
+{
+	int flag_value = value + BR.L;
+	VALFLAG(F_N, value & 0x80);
+	VALFLAG(F_H, flag_value > 0xff);
+	VALFLAG(F_C, flag_value > 0xff);
+	VALFLAG(F_PV, parityBit[(flag_value & 7) ^ BR.B]);
+	adjustFlags(ctx, BR.B);
+}
+
+
+/* Called by a repeating block instruction which has wound PC back to
+ * go again. If the fast path is on and nothing needs to see the CPU
+ * stop, charge the opcode fetch and carry on with the next iteration
+ * in the core. written is the last address stored to (or -1) so that
+ * code which overwrites its own opcode is still handled properly. */
+static int blockRepeat (Z80Context* ctx, int written)
+{
+	if (!ctx->fastBlock)
+		return 0;
+	if (ctx->tstates >= ctx->tlimit)
+		return 0;
+	if (ctx->nmi_req || (ctx->int_req && ctx->IFF1))
+		return 0;
+	if (written >= 0 && (ushort)(written - ctx->PC) < 2)
+		return 0;
+	INCR;
+	INCR;
+	ctx->tstates += 8;
+	ctx->PC += 2;
+	return 1;
+}
+
+
+/* How many iterations, this one included, would be started before the
+ * budget runs out. Each costs 21 t-states and the check is made 13 into
+ * the last; the fetch already charged can take us up to 7 past it */
+static unsigned blockCount (Z80Context* ctx, unsigned max)
+{
+	unsigned n = 1 + (ctx->tlimit + 7 - ctx->tstates) / 21;
+	return n < max ? n : max;
+}
+
+
+/* Offer the rest of an INIR/INDR to the board. Returns 0 if it didn't
+ * take any and the iteration should be done the slow way. */
+static int blockIn (Z80Context* ctx, int dir)
+{
+	byte buf[256];
+	unsigned n, i;
+
+	if (ctx->ioBlockIn == NULL)
+		return 0;
+	n = blockCount(ctx, BR.B);
+	/* Don't go writing over our own opcode */
+	for (i = 0; i < n; i++)
+		if ((ushort)(WR.HL + dir * (int)i - (ctx->PC - 2)) < 2)
+			return 0;
+	n = ctx->ioBlockIn(ctx->ioParam, WR.BC, buf, n);
+	for (i = 0; i < n; i++)
+	{
+		if (i)
+		{
+			ctx->tstates += 5 + 8;
+			INCR;
+			INCR;
+		}
+		ctx->tstates += 5;
+		doINI(ctx, buf[i], dir);
+	}
+	return n != 0;
+}
+
+
+/* Offer the rest of an OTIR/OTDR to the board. It is asked how many
+ * bytes it will take first, so memory is only read for a run that is
+ * going out. */
+static int blockOut (Z80Context* ctx, int dir)
+{
+	byte buf[256];
+	unsigned n, i;
+
+	if (ctx->ioBlockOut == NULL)
+		return 0;
+	n = blockCount(ctx, BR.B);
+	/* B is decremented before the first byte goes out */
+	n = ctx->ioBlockOut(ctx->ioParam, WR.BC - 0x100, NULL, n);
+	if (n == 0)
+		return 0;
+	for (i = 0; i < n; i++)
+		buf[i] = ctx->memRead(ctx->memParam, WR.HL + dir * (int)i);
+	ctx->ioBlockOut(ctx->ioParam, WR.BC - 0x100, buf, n);
+	for (i = 0; i < n; i++)
+	{
+		if (i)
+		{
+			ctx->tstates += 5 + 8;
+			INCR;
+			INCR;
+		}
+		ctx->tstates += 8;
+		BR.B = doIncDec(ctx, BR.B, ID_DEC);
+		WR.HL += dir;
+		doOUTIFlags(ctx, buf[i]);
+	}
+	return n != 0;
+}
+
 #include "codegen/opcodes_impl.c"
 
 
@@ -764,7 +893,7 @@ static void do_int(Z80Context* ctx)
 }
 
 
-void Z80Execute (Z80Context* ctx)
+static void execute (Z80Context* ctx)
 {
 	if (ctx->nmi_req)
 		do_nmi(ctx);
@@ -778,11 +907,21 @@ void Z80Execute (Z80Context* ctx)
 }
 
 
+/* A single instruction leaves the block fast path no budget so
+   repeats still come back one iteration at a time */
+void Z80Execute (Z80Context* ctx)
+{
+	ctx->tlimit = 0;
+	execute(ctx);
+}
+
+
 unsigned Z80ExecuteTStates(Z80Context* ctx, unsigned tstates)
 {
 	ctx->tstates = 0;
+	ctx->tlimit = tstates;
 	while (ctx->tstates < tstates)
-		Z80Execute(ctx);
+		execute(ctx);
 	return ctx->tstates;
 }
 
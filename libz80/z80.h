@@ -40,6 +40,14 @@ typedef byte (*Z80DataIn) 	(int param, ushort address);
 typedef void (*Z80DataOut)	(int param, ushort address, byte data);
 
 
+/** Function types for block I/O. Given up to len bytes of an INIR/INDR
+ * or OTIR/OTDR, return how many were moved (0 to decline). Block out is
+ * first called with buf NULL to ask how many of len bytes it will take,
+ * then with exactly that many, all of which it must take. */
+typedef unsigned (*Z80BlockIn)	(int param, ushort address, byte *buf, unsigned len);
+typedef unsigned (*Z80BlockOut)	(int param, ushort address, const byte *buf, unsigned len);
+
+
 /** 
  * A Z80 register set.
  * An union is used since we want independent access to the high and low bytes of the 16-bit registers.
@@ -98,6 +106,17 @@ typedef struct
 	Z80DataIn	ioRead;
 	Z80DataOut	ioWrite;
 	int			ioParam;
+
+	/* Optional block instruction fast path. With fastBlock set the
+	 * repeating block instructions loop inside the core rather than
+	 * being fetched again for each byte, stopping when an interrupt
+	 * is due or the Z80ExecuteTStates budget is used. The trace hook
+	 * sees only the first iteration. If set, the block I/O functions
+	 * are offered runs of INIR/INDR/OTIR/OTDR bytes; the address is
+	 * that of the first byte. */
+	byte		fastBlock;
+	Z80BlockIn	ioBlockIn;
+	Z80BlockOut	ioBlockOut;
 	
 	byte		halted;
 	unsigned	tstates;
@@ -136,6 +155,10 @@ typedef struct
 
 	byte exec_int_vector;
 
+	/* Z80ExecuteTStates budget for the block instruction fast path */
+
+	unsigned tlimit;
+
 	void (*trace)(unsigned int memparam);
 
 } Z80Context;
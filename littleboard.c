@@ -476,6 +476,26 @@ static void scsi_write(uint8_t addr, uint8_t val)
 	ncr5380_write(ncr, addr, val);
 }
 
+/*
+ *	Block I/O from the CPU. The NCR5380 pseudo DMA port can take a whole
+ *	INIR/OTIR worth at a go
+ */
+static unsigned io_block_in(int unused, uint16_t addr, uint8_t *buf, unsigned len)
+{
+	if ((addr & 0xFF) != 0x28 || ncr == NULL || (trace & (TRACE_IO | TRACE_SCSI)))
+		return 0;
+	return ncr5380_dma_read(ncr, buf, len);
+}
+
+static unsigned io_block_out(int unused, uint16_t addr, const uint8_t *buf, unsigned len)
+{
+	if ((addr & 0xFF) != 0x28 || ncr == NULL || (trace & (TRACE_IO | TRACE_SCSI)))
+		return 0;
+	if (buf == NULL)
+		return ncr5380_dma_room(ncr, len);
+	return ncr5380_dma_write(ncr, buf, len);
+}
+
 static void pp_out(uint8_t val)
 {
 }
@@ -752,6 +772,9 @@ int main(int argc, char *argv[])
 	Z80RESET(&cpu_z80);
 	cpu_z80.ioRead = io_read;
 	cpu_z80.ioWrite = io_write;
+	cpu_z80.ioBlockIn = io_block_in;
+	cpu_z80.ioBlockOut = io_block_out;
+	cpu_z80.fastBlock = 1;
 	cpu_z80.memRead = mem_read;
 	cpu_z80.memWrite = mem_write;
 	cpu_z80.trace = z80_trace;
@@ -171,6 +171,16 @@ unsigned int  m68k_read_pcrelative_8(unsigned int address);
 unsigned int  m68k_read_pcrelative_16(unsigned int address);
 unsigned int  m68k_read_pcrelative_32(unsigned int address);
 
+/* Instruction stream regions (see M68K_FETCH_REGIONS in m68kconf.h).
+ * Immediate and PC-relative reads in [base, base + size) are read from
+ * mem, which holds the bytes in 68K (big endian) order. The region must
+ * be plain memory with no side effects on read. Writes by the CPU still
+ * go through m68k_write_memory_xx() so the host must write to the same
+ * buffer. Passing mem as NULL removes the region.
+ */
+void m68k_set_fetch_region(unsigned int slot, unsigned int base, unsigned int size, const unsigned char *mem);
+void m68k_clear_fetch_regions(void);
+
 /* Memory access for the disassembler */
 unsigned int m68k_read_disassembler_8  (unsigned int address);
 unsigned int m68k_read_disassembler_16 (unsigned int address);
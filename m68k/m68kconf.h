@@ -136,6 +136,15 @@ extern void cpu_instr_callback(void);
 #define M68K_EMULATE_PREFETCH       OPT_ON
 
 
+/* If ON, immediate and PC-relative reads that fall inside a region given
+ * to m68k_set_fetch_region() come straight from host memory instead of
+ * going through m68k_read_memory_xx(). Only used if M68K_SEPARATE_READS
+ * is off.
+ */
+#define M68K_FETCH_REGIONS          OPT_ON
+#define M68K_FETCH_REGION_MAX       4
+
+
 /* If ON, the CPU will generate address error exceptions if it tries to
  * access a word or longword at an odd address.
  * NOTE: This is only emulated properly for 68000 mode.
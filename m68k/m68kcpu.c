@@ -76,6 +76,11 @@ uint    m68ki_aerr_address;
 uint    m68ki_aerr_write_mode;
 uint    m68ki_aerr_fc;
 
+#if M68K_FETCH_REGIONS
+m68ki_fetch_region m68ki_fetch[M68K_FETCH_REGION_MAX];
+uint               m68ki_fetch_count;
+#endif /* M68K_FETCH_REGIONS */
+
 /* Used by shift & rotate instructions */
 uint8 m68ki_shift_8_table[65] =
 {
@@ -562,6 +567,32 @@ void m68k_set_instr_hook_callback(void  (*callback)(void))
 	CALLBACK_INSTR_HOOK = callback ? callback : default_instr_hook_callback;
 }
 
+void m68k_set_fetch_region(unsigned int slot, unsigned int base, unsigned int size, const unsigned char *mem)
+{
+#if M68K_FETCH_REGIONS
+	if(slot >= M68K_FETCH_REGION_MAX)
+		return;
+	m68ki_fetch[slot].base = base;
+	m68ki_fetch[slot].size = mem ? size : 0;
+	m68ki_fetch[slot].mem = mem;
+
+	/* Only scan as far as the last region in use */
+	m68ki_fetch_count = M68K_FETCH_REGION_MAX;
+	while(m68ki_fetch_count && m68ki_fetch[m68ki_fetch_count - 1].size == 0)
+		m68ki_fetch_count--;
+#endif /* M68K_FETCH_REGIONS */
+}
+
+void m68k_clear_fetch_regions(void)
+{
+#if M68K_FETCH_REGIONS
+	uint i;
+
+	for(i = 0; i < M68K_FETCH_REGION_MAX; i++)
+		m68k_set_fetch_region(i, 0, 0, NULL);
+#endif /* M68K_FETCH_REGIONS */
+}
+
 #include <stdio.h>
 /* Set the CPU type. */
 void m68k_set_cpu_type(unsigned int cpu_type)
@@ -35,6 +35,7 @@
 
 #include "m68k.h"
 #include <limits.h>
+#include <stddef.h>
 
 #if M68K_EMULATE_ADDRESS_ERROR
 #include <setjmp.h>
@@ -409,12 +410,21 @@
 
 
 #if !M68K_SEPARATE_READS
+#if M68K_FETCH_REGIONS
+#define m68k_read_immediate_16(A) m68ki_read_fetch_16(A)
+#define m68k_read_immediate_32(A) m68ki_read_fetch_32(A)
+
+#define m68k_read_pcrelative_8(A) m68ki_read_fetch_8(A)
+#define m68k_read_pcrelative_16(A) m68ki_read_fetch_16(A)
+#define m68k_read_pcrelative_32(A) m68ki_read_fetch_32(A)
+#else
 #define m68k_read_immediate_16(A) m68ki_read_program_16(A)
 #define m68k_read_immediate_32(A) m68ki_read_program_32(A)
 
 #define m68k_read_pcrelative_8(A) m68ki_read_program_8(A)
 #define m68k_read_pcrelative_16(A) m68ki_read_program_16(A)
 #define m68k_read_pcrelative_32(A) m68ki_read_program_32(A)
+#endif /* M68K_FETCH_REGIONS */
 #endif /* M68K_SEPARATE_READS */
 
 
@@ -862,10 +872,29 @@ extern uint           m68ki_aerr_address;
 extern uint           m68ki_aerr_write_mode;
 extern uint           m68ki_aerr_fc;
 
+#if M68K_FETCH_REGIONS
+typedef struct
+{
+	uint base;
+	uint size;
+	const uint8* mem;
+} m68ki_fetch_region;
+
+extern m68ki_fetch_region m68ki_fetch[M68K_FETCH_REGION_MAX];
+extern uint               m68ki_fetch_count;
+#endif /* M68K_FETCH_REGIONS */
+
 /* Read data immediately after the program counter */
 INLINE uint m68ki_read_imm_16(void);
 INLINE uint m68ki_read_imm_32(void);
 
+#if M68K_FETCH_REGIONS
+/* Read from the instruction stream, using a fetch region if possible */
+INLINE uint m68ki_read_fetch_8 (uint address);
+INLINE uint m68ki_read_fetch_16(uint address);
+INLINE uint m68ki_read_fetch_32(uint address);
+#endif /* M68K_FETCH_REGIONS */
+
 /* Read data with specific function code */
 INLINE uint m68ki_read_8_fc  (uint address, uint fc);
 INLINE uint m68ki_read_16_fc (uint address, uint fc);
@@ -1068,6 +1097,54 @@ INLINE uint m68ki_read_32_fc(uint address, uint fc)
 	return m68k_read_memory_32(ADDRESS_68K(address));
 }
 
+#if M68K_FETCH_REGIONS
+/* The region lookup is a short linear scan: boards have one or two */
+INLINE const uint8* m68ki_fetch_ptr(uint address, uint len)
+{
+	m68ki_fetch_region* f = m68ki_fetch;
+	m68ki_fetch_region* e = m68ki_fetch + m68ki_fetch_count;
+	uint offset;
+
+	for(; f < e; f++)
+	{
+		offset = address - f->base;
+		if(offset < f->size && f->size - offset >= len)
+			return f->mem + offset;
+	}
+	return NULL;
+}
+
+INLINE uint m68ki_read_fetch_8(uint address)
+{
+	const uint8* p = m68ki_fetch_ptr(address, 1);
+
+	if(p == NULL)
+		return m68ki_read_program_8(address);
+	m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_PROGRAM); /* auto-disable (see m68kcpu.h) */
+	return p[0];
+}
+INLINE uint m68ki_read_fetch_16(uint address)
+{
+	const uint8* p = m68ki_fetch_ptr(address, 2);
+
+	if(p == NULL)
+		return m68ki_read_program_16(address);
+	m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_PROGRAM); /* auto-disable (see m68kcpu.h) */
+	m68ki_check_address_error(address, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM); /* auto-disable (see m68kcpu.h) */
+	return (p[0] << 8) | p[1];
+}
+INLINE uint m68ki_read_fetch_32(uint address)
+{
+	const uint8* p = m68ki_fetch_ptr(address, 4);
+
+	if(p == NULL)
+		return m68ki_read_program_32(address);
+	m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_PROGRAM); /* auto-disable (see m68kcpu.h) */
+	m68ki_check_address_error(address, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM); /* auto-disable (see m68kcpu.h) */
+	return ((uint)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+#endif /* M68K_FETCH_REGIONS */
+
 INLINE void m68ki_write_8_fc(uint address, uint fc, uint value)
 {
 	m68ki_set_fc(fc); /* auto-disable (see m68kcpu.h) */
@@ -141,6 +141,24 @@ int cpu_irq_ack(int level)
 	return M68K_INT_ACK_AUTOVECTOR;
 }
 
+/* RAM and ROM are plain memory so the CPU can fetch instructions from
+   them directly. Only the first copy of each is registered, the mirrors
+   go through cpu_read_*() as before. Called again when the map flips. */
+static void fetch_regions(void)
+{
+	if (trace & TRACE_MEM)
+		return;
+	m68k_clear_fetch_regions();
+	if (!flipped) {
+		m68k_set_fetch_region(0, 0x00000000, sizeof(rom), rom);
+		m68k_set_fetch_region(1, 0x04000000, sizeof(ram), ram);
+	} else {
+		m68k_set_fetch_region(0, 0x00000000, sizeof(ram), ram);
+		m68k_set_fetch_region(1, 0x04000000, sizeof(rom), rom);
+		m68k_set_fetch_region(2, 0x08000000, sizeof(ram), ram);
+	}
+}
+
 /* Read data from RAM, ROM, or a device */
 unsigned int do_cpu_read_byte(unsigned int address, unsigned int trap)
 {
@@ -158,8 +176,10 @@ unsigned int do_cpu_read_byte(unsigned int address, unsigned int trap)
 		if (address < 0x0C000000)
 			return ram[address & (sizeof(ram) - 1)];
 	}
-	if (address == 0xFFFF8000)
+	if (address == 0xFFFF8000 && !flipped) {
 		flipped = 1;
+		fetch_regions();
+	}
 	if ((address & 0xFFFFF000) == 0xFFFFF000) {
 		address &= 0xFF;
 		if (address == 0x0C)
@@ -241,8 +261,10 @@ void cpu_write_byte(unsigned int address, unsigned int value)
 			return;
 		}
 	}
-	if (address == 0xFFFF8000)
+	if (address == 0xFFFF8000 && !flipped) {
 		flipped = 1;
+		fetch_regions();
+	}
 	if ((address & 0xFFFFF000) == 0xFFFFF000) {
 		address &= 0xFF;
 		if (address == 0x0C) {
@@ -303,6 +325,7 @@ static void device_init(void)
 	irq_pending = 0;
 	ide_reset_begin(ide);
 	flipped = 0;
+	fetch_regions();
 }
 
 static struct termios saved_term, term;
@@ -686,6 +686,16 @@ void uart16x50_signal_change(struct uart16x50 *uart, uint8_t mcr)
 	/* Modem lines changed - don't care */
 }
 
+/* Once the boot overlay is gone RAM and ROM are plain memory so the CPU
+   can fetch instructions from them directly */
+static void fetch_regions(void)
+{
+	if (trace & TRACE_MEM)
+		return;
+	m68k_set_fetch_region(0, 0, memsize, ram);
+	m68k_set_fetch_region(1, 0x380000, sizeof(rom), rom);
+}
+
 /* Read data from RAM, ROM, or a device */
 unsigned int do_cpu_read_byte(unsigned int address, unsigned debug)
 {
@@ -694,6 +704,8 @@ unsigned int do_cpu_read_byte(unsigned int address, unsigned debug)
 		if (debug == 0) {
 			u27 <<= 1;
 			u27 |= 1;
+			if (u27 & 0x80)
+				fetch_regions();
 		}
 		return rom[address & 0x1FFFF];
 	}
@@ -800,6 +812,8 @@ void cpu_write_byte(unsigned int address, unsigned int value)
 	if (!(u27 & 0x80)) {
 		u27 <<= 1;
 		u27 |= 1;
+		if (u27 & 0x80)
+			fetch_regions();
 		return;
 	}
 	u27 <<= 1;
@@ -915,6 +929,7 @@ static void device_init(void)
 	uart16x50_reset(uart);
 	uart16x50_attach(uart, &console);
 	u27 = 0;
+	m68k_clear_fetch_regions();
 }
 
 static struct termios saved_term, term;
@@ -211,6 +211,55 @@ static uint8_t do_ncr5380_read(struct ncr5380 *ncr, unsigned reg)
 	return 0xFF;
 }
 
+/*
+ *	Block forms of the PDMA port for a board that can see the CPU doing
+ *	a block I/O loop on it. They move as much as the target will take in
+ *	the current data phase and return the count, the caller finishes off
+ *	any remainder through ncr5380_read/write as normal.
+ */
+unsigned ncr5380_dma_read(struct ncr5380 *ncr, uint8_t *buf, unsigned len)
+{
+	unsigned n;
+
+	if (!ncr->dma_rx)
+		return 0;
+	n = sasi_read_burst(ncr->bus, buf, len);
+	if (ncr->trace)
+		fprintf(stderr, "ncr5380: dma read %u of %u\n", n, len);
+	ncr5380_activity(ncr);
+	ncr_phase_check(ncr);
+	return n;
+}
+
+/* How many of len bytes a DMA write would take */
+unsigned ncr5380_dma_room(struct ncr5380 *ncr, unsigned len)
+{
+	if (!ncr->dma_tx)
+		return 0;
+	ncr_phase_check(ncr);
+	if (!ncr->dma_tx)
+		return 0;
+	return sasi_write_room(ncr->bus, len);
+}
+
+unsigned ncr5380_dma_write(struct ncr5380 *ncr, const uint8_t *buf, unsigned len)
+{
+	unsigned n;
+
+	if (!ncr->dma_tx)
+		return 0;
+	ncr_phase_check(ncr);
+	if (!ncr->dma_tx)
+		return 0;
+	n = sasi_write_burst(ncr->bus, buf, len);
+	if (n)
+		ncr->last_data = buf[n - 1];
+	if (ncr->trace)
+		fprintf(stderr, "ncr5380: dma write %u of %u\n", n, len);
+	ncr5380_activity(ncr);
+	return n;
+}
+
 uint8_t ncr5380_read(struct ncr5380 *ncr, unsigned reg)
 {
 	uint8_t r = do_ncr5380_read(ncr, reg);
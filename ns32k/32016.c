@@ -52,6 +52,79 @@ static unsigned ns32016_irq;
 uint8_t FunctionLookup[256];
 static const uint32_t IndexLKUP[8] = { 0x0, 0x1, 0x4, 0x5, 0x8, 0x9, 0xC, 0xD };	// See Page 2-3 of the manual!
 
+/*
+ *	Decoded instruction cache. The format decode and the displacements
+ *	and immediates of the general operands are kept per instruction
+ *	address so that executing it again only has to do the address
+ *	arithmetic. Entries are dropped when anything writes over their bytes.
+ */
+
+#define DC_SIZE		4096		/* Entries, must be a power of two */
+#define DC_MASK		(DC_SIZE - 1)
+#define DC_MAXLEN	32		/* Longest instruction we cache */
+#define DC_MAXVAL	6		/* Displacements/immediate words */
+#define DC_EMPTY	0xFFFFFFFFu
+
+struct DecodedInstruction {
+	uint32_t pc;
+	uint32_t next;			/* PC after the operands */
+	uint32_t opcode;
+	uint32_t Function;
+	uint32_t OpSize;
+	uint32_t WriteIndex;
+	uint8_t ResultSize;		/* WriteSize as decode left it */
+	RegLKU Regs[2];
+	uint32_t val[DC_MAXVAL];	/* In the order decode consumed them */
+};
+
+static struct DecodedInstruction dcache[DC_SIZE];
+static uint8_t dc_page[65536];		/* 256 byte pages holding cached code */
+static struct DecodedInstruction *dc_fill;	/* Entry being recorded */
+static struct DecodedInstruction *dc_hit;	/* Entry being replayed */
+static unsigned dc_pos;
+
+static void FlushDecoded(void)
+{
+	unsigned i;
+	for (i = 0; i < DC_SIZE; i++)
+		dcache[i].pc = DC_EMPTY;
+	memset(dc_page, 0, sizeof(dc_page));
+}
+
+static void InvalidateDecoded(uint32_t addr)
+{
+	struct DecodedInstruction *e;
+	uint32_t k;
+
+	for (k = 0; k < DC_MAXLEN; k++) {
+		e = &dcache[(addr - k) & DC_MASK];
+		if (e->pc == addr - k && addr < e->next)
+			e->pc = DC_EMPTY;
+	}
+}
+
+/* Record (or replay) one decoded value from the instruction stream */
+static void DecodeRecord(uint32_t v)
+{
+	if (dc_fill == NULL)
+		return;
+	if (dc_pos == DC_MAXVAL)
+		dc_fill = NULL;		/* Too complex, don't cache */
+	else
+		dc_fill->val[dc_pos++] = v;
+}
+
+static int32_t DecodeDisplacement(void)
+{
+	int32_t v;
+
+	if (dc_hit)
+		return (int32_t) dc_hit->val[dc_pos++];
+	v = GetDisplacement(&pc);
+	DecodeRecord((uint32_t) v);
+	return v;
+}
+
 void ns32016_ShowRegs(uint32_t Option)
 {
 	if (Option & BIT(0)) {
@@ -142,6 +215,8 @@ static uint32_t read_n(uint32_t addr, uint32_t size)
 
 static void write_x8(uint32_t addr, uint8_t val)
 {
+	if (dc_page[(addr >> 8) & 0xFFFF])
+		InvalidateDecoded(addr);
 	ns32016_write8(addr, val);
 }
 
@@ -239,6 +314,8 @@ void ns32016_reset_addr(uint32_t StartAddress)
 	for (Index = 0; Index < 256; Index++)
 		FunctionLookup[Index] = GetFunction(Index);
 
+	FlushDecoded();
+
 	pc = StartAddress;
 	psr = 0;
 
@@ -258,6 +335,11 @@ uint32_t ns32016_get_pc(void)
 	return pc;
 }
 
+void ns32016_flush_decoded(void)
+{
+	FlushDecoded();
+}
+
 uint32_t ns32016_get_startpc(void)
 {
 	return startpc;
@@ -511,11 +593,24 @@ static void GetGenPhase2(RegLKU gen, int c)
 		if (gen.OpType == Immediate) {
 			MultiReg temp3;
 
+			gentype[c] = OpImmediate;
+			if (dc_hit) {
+				if (OpSize.Op[c] == sz64) {
+					Immediate64.u64 = ((uint64_t) dc_hit->val[dc_pos]) << 32;
+					Immediate64.u64 |= dc_hit->val[dc_pos + 1];
+					dc_pos += 2;
+				} else
+					genaddr[c] = dc_hit->val[dc_pos++];
+				return;
+			}
+
 			if (OpSize.Op[c] == sz64) {
 				temp3.u32 = SWAP32(read_x32(pc));
 				Immediate64.u64 = (((uint64_t) temp3.u32) << 32);
 				temp3.u32 = SWAP32(read_x32(pc + 4));
 				Immediate64.u64 |= temp3.u32;
+				DecodeRecord((uint32_t) (Immediate64.u64 >> 32));
+				DecodeRecord((uint32_t) Immediate64.u64);
 			} else {
 				// Why can't they just decided on an endian and then stick to it?
 				temp3.u32 = SWAP32(read_x32(pc));
@@ -525,17 +620,17 @@ static void GetGenPhase2(RegLKU gen, int c)
 					genaddr[c] = temp3.u16;
 				else
 					genaddr[c] = temp3.u32;
+				DecodeRecord(genaddr[c]);
 			}
 
 			pc += OpSize.Op[c];
-			gentype[c] = OpImmediate;
 			return;
 		}
 
 		gentype[c] = Memory;
 
 		if (gen.OpType <= R7_Offset) {
-			genaddr[c] = (uint32_t) ((int) r[gen.Whole & 7] + GetDisplacement(&pc));
+			genaddr[c] = (uint32_t) ((int) r[gen.Whole & 7] + DecodeDisplacement());
 			return;
 		}
 
@@ -560,35 +655,35 @@ static void GetGenPhase2(RegLKU gen, int c)
 
 		switch (gen.OpType) {
 		case FrameRelative:
-			temp = (uint32_t) GetDisplacement(&pc);
-			temp2 = (uint32_t) GetDisplacement(&pc);
+			temp = (uint32_t) DecodeDisplacement();
+			temp2 = (uint32_t) DecodeDisplacement();
 			genaddr[c] = read_x32(fp + temp);
 			genaddr[c] += temp2;
 			break;
 
 		case StackRelative:
-			temp = (uint32_t) GetDisplacement(&pc);
-			temp2 = (uint32_t) GetDisplacement(&pc);
+			temp = (uint32_t) DecodeDisplacement();
+			temp2 = (uint32_t) DecodeDisplacement();
 			genaddr[c] = read_x32(GET_SP() + temp);
 			genaddr[c] += temp2;
 			break;
 
 		case StaticRelative:
-			temp = (uint32_t) GetDisplacement(&pc);
-			temp2 = (uint32_t) GetDisplacement(&pc);
+			temp = (uint32_t) DecodeDisplacement();
+			temp2 = (uint32_t) DecodeDisplacement();
 			genaddr[c] = read_x32(sb + temp);
 			genaddr[c] += temp2;
 			break;
 
 		case Absolute:
-			genaddr[c] = (uint32_t) GetDisplacement(&pc);
+			genaddr[c] = (uint32_t) DecodeDisplacement();
 			break;
 
 		case External:
 			temp = read_x32(mod + 4);
-			temp += (uint32_t) ((GetDisplacement(&pc)) * 4);
+			temp += (uint32_t) ((DecodeDisplacement()) * 4);
 			temp2 = read_x32(temp);
-			genaddr[c] = temp2 + (uint32_t) GetDisplacement(&pc);
+			genaddr[c] = temp2 + (uint32_t) DecodeDisplacement();
 			break;
 
 		case TopOfStack:
@@ -597,19 +692,19 @@ static void GetGenPhase2(RegLKU gen, int c)
 			break;
 
 		case FpRelative:
-			genaddr[c] = (uint32_t) GetDisplacement(&pc) + fp;
+			genaddr[c] = (uint32_t) DecodeDisplacement() + fp;
 			break;
 
 		case SpRelative:
-			genaddr[c] = (uint32_t) GetDisplacement(&pc) + GET_SP();
+			genaddr[c] = (uint32_t) DecodeDisplacement() + GET_SP();
 			break;
 
 		case SbRelative:
-			genaddr[c] = (uint32_t) GetDisplacement(&pc) + sb;
+			genaddr[c] = (uint32_t) DecodeDisplacement() + sb;
 			break;
 
 		case PcRelative:
-			genaddr[c] = (uint32_t) GetDisplacement(&pc) + startpc;
+			genaddr[c] = (uint32_t) DecodeDisplacement() + startpc;
 			break;
 
 		default:
@@ -1075,8 +1170,11 @@ void ns32016_exec(int cycles)
 
 
 	while (cycles > 0) {
+		struct DecodedInstruction *e;
+
 		cycles -= 8;
 		CLEAR_TRAP();
+		dc_fill = NULL;
 
 		WriteSize = szVaries;	// The size a result may be written as
 		WriteIndex = 1;	// Default to writing operand 0
@@ -1096,13 +1194,33 @@ void ns32016_exec(int cycles)
 			ns32016_disassemble(pc, tracebuf + 1, sizeof(tracebuf) - 1);
 			fprintf(stderr, "%s\n", tracebuf);
 		}
-		opcode = read_x32(pc);
-
 		if (pc == PR.BPC) {
 			SET_TRAP(BreakPointHit);
 			goto DoTrap;
 		}
 
+		e = &dcache[pc & DC_MASK];
+		if (e->pc == pc) {
+			/* Seen it before: only the address arithmetic to do */
+			opcode = e->opcode;
+			Function = e->Function;
+			OpSize.Whole = e->OpSize;
+			WriteIndex = e->WriteIndex;
+			WriteSize = e->ResultSize;
+			Regs[0] = e->Regs[0];
+			Regs[1] = e->Regs[1];
+			dc_hit = e;
+			dc_pos = 0;
+			GetGenPhase2(Regs[0], 0);
+			GetGenPhase2(Regs[1], 1);
+			if (Function <= RETT)
+				temp = (uint32_t) DecodeDisplacement();
+			dc_hit = NULL;
+			pc = e->next;
+			goto Execute;
+		}
+
+		opcode = read_x32(pc);
 		Function = FunctionLookup[opcode & 0xFF];
 
 		//if ((Function >> 4) < (FormatCount + 1)) // always true
@@ -1329,13 +1447,36 @@ void ns32016_exec(int cycles)
 			break;
 		}
 
+		/* Anything that trapped during decode is never cached */
+		if (TrapFlags == 0 && startpc != DC_EMPTY) {
+			dc_fill = e;
+			dc_pos = 0;
+			e->pc = DC_EMPTY;
+			e->opcode = opcode;
+			e->Function = Function;
+			e->OpSize = OpSize.Whole;
+			e->WriteIndex = WriteIndex;
+			e->ResultSize = WriteSize;
+			e->Regs[0] = Regs[0];
+			e->Regs[1] = Regs[1];
+		}
+
 		GetGenPhase2(Regs[0], 0);
 		GetGenPhase2(Regs[1], 1);
 
 		if (Function <= RETT) {
-			temp = (uint32_t) GetDisplacement(&pc);
+			temp = (uint32_t) DecodeDisplacement();
+		}
+
+		if (dc_fill && TrapFlags == 0 && pc - startpc <= DC_MAXLEN) {
+			e->next = pc;
+			e->pc = startpc;
+			dc_page[(startpc >> 8) & 0xFFFF] = 1;
+			dc_page[((pc - 1) >> 8) & 0xFFFF] = 1;
 		}
+		dc_fill = NULL;
 
+Execute:
 		if (TrapFlags) {
 		      DoTrap:
 		      	/* TODO: a proper trap handler */
@@ -1938,6 +2079,8 @@ void ns32016_exec(int cycles)
 				}
 
 				nscfg.lsb = (uint8_t) (opcode >> 15);	// Only sets the bottom 8 bits of which the lower 4 are used!
+				/* Decode depends on whether the FPU is present */
+				FlushDecoded();
 				continue;
 			}
 			// No break due to continue
@@ -14,6 +14,8 @@ extern void ns32016_close(void);
 extern void ns32016_build_matrix(void);
 extern void ns32016_set_irq(unsigned mask);
 extern void ns32016_trace(unsigned onoff);
+/* Call if memory changes other than through ns32016_write8 (banking, DMA) */
+extern void ns32016_flush_decoded(void);
 /*
  *	Platform provided
  */
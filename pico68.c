@@ -135,6 +135,19 @@ int cpu_irq_ack(int level)
 	return M68K_INT_ACK_AUTOVECTOR;
 }
 
+/* RAM and ROM are plain memory so the CPU can fetch instructions from
+   them directly. The 32K ROM appears twice in the bottom 64K and the
+   128K RAM starts half way through, wrapping at 0x20000. */
+static void fetch_regions(void)
+{
+	if (trace & TRACE_MEM)
+		return;
+	m68k_set_fetch_region(0, 0x00000, sizeof(rom), rom);
+	m68k_set_fetch_region(1, 0x08000, sizeof(rom), rom);
+	m68k_set_fetch_region(2, 0x10000, 0x10000, ram + 0x10000);
+	m68k_set_fetch_region(3, 0x20000, 0x10000, ram);
+}
+
 /* Read data from RAM, ROM, or a device */
 unsigned int do_cpu_read_byte(unsigned int address, unsigned int trap)
 {
@@ -234,6 +247,7 @@ void cpu_instr_callback(void)
 static void device_init(void)
 {
 	irq_pending = 0;
+	fetch_regions();
 }
 
 static struct termios saved_term, term;
@@ -216,6 +216,26 @@ static uint8_t io_read(uint16_t addr, uint8_t debug)
 	return(result);
 }
 
+/* Point the CPU page table at the RAM behind one 16K bank slot. The 64K
+   space repeats in every 65C816 bank. The top 4K holds the I/O page so
+   is always left to read65c816/write65c816, as is everything when memory
+   tracing is on. */
+static void map_bank(unsigned int slot)
+{
+	uint8_t block = bankreg[slot];
+	uint8_t *p = NULL;
+	unsigned int bank, page;
+
+	if (trace & TRACE_MEM)
+		return;
+	for (page = slot * 4; page < slot * 4 + 4 && page < 15; page++) {
+		if (block < sizeof(ram) / BANK_SIZE)
+			p = ram + (block << 14) + ((page & 3) << 12);
+		for (bank = 0; bank < 256; bank++)
+			CPU_mapPage((bank << 16) | (page << 12), p, p);
+	}
+}
+
 static void io_write(uint16_t addr, uint8_t val)
 {
 	if (trace & TRACE_IO)
@@ -224,15 +244,19 @@ static void io_write(uint16_t addr, uint8_t val)
 	switch(addr) {
 	case IO_BANK_0:
 		bankreg[0] = val;
+		map_bank(0);
 		break;
 	case IO_BANK_1:
 		bankreg[1] = val;
+		map_bank(1);
 		break;
 	case IO_BANK_2:
 		bankreg[2] = val;
+		map_bank(2);
 		break;
 	case IO_BANK_3:
 		bankreg[3] = val;
+		map_bank(3);
 		break;
 	case IO_SERIAL_0_OUT:
 		write(1, &val, 1);
@@ -455,6 +479,10 @@ int main(int argc, char *argv[])
 	bankreg[1] = 1;
 	bankreg[2] = 2;
 	bankreg[3] = 3;
+	map_bank(0);
+	map_bank(1);
+	map_bank(2);
+	map_bank(3);
 
 	hd_fd = open(diskpath, O_RDWR);
 	if (hd_fd == -1) {
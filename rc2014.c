@@ -43,10 +43,12 @@
 #include "serialdevice.h"
 #include "ttycon.h"
 #include "vtcon.h"
+#include "serlink.h"
 #include "16x50.h"
 #include "acia.h"
 #include "z80sio.h"
 #include "amd9511.h"
+#include "capture.h"
 #include "ef9345.h"
 #include "ef9345_render.h"
 #define GDB_BACKEND_Z80
@@ -110,6 +112,7 @@ static uint8_t have_cpld_serial;
 static uint8_t have_im2;
 static uint8_t have_16x50;
 static uint8_t have_copro;
+static uint8_t copro_threaded;
 static uint8_t have_tms;
 static uint8_t have_ef9345;
 static uint8_t have_kio_ext;	/* Extreme config KIO at C0-DF */
@@ -135,6 +138,8 @@ static struct tms9918a_renderer *vdprend;
 static struct amd9511 *amd9511;
 static struct ef9345 *ef9345;
 static struct ef9345_renderer *ef9345rend;
+static struct capture *cap;
+static struct serial_device *sio_link;
 static struct tft_dumb *tft;
 static struct tft_renderer *tftrend;
 static struct uart16x50 *uart;
@@ -1078,6 +1083,50 @@ static void my_ide_write(uint16_t addr, uint8_t val)
 	ide_write8(ide0, addr, val);
 }
 
+/*
+ *	INIR/OTIR on the IDE data port at 0x10 on the standard I/O map can
+ *	be done without going back through the CPU for each byte
+ */
+static int ide_block_port(uint16_t addr)
+{
+	if (ide != 1 || extreme || (trace & (TRACE_IO | TRACE_IDE)))
+		return 0;
+	switch (cpuboard) {
+	case CPUBOARD_Z80:
+	case CPUBOARD_SC108:
+	case CPUBOARD_PDOG128:
+	case CPUBOARD_PDOG512:
+	case CPUBOARD_ZRC:
+	case CPUBOARD_SC720:
+	case CPUBOARD_SC707:
+	case CPUBOARD_TP128:
+		return (addr & 0xFF) == 0x10;
+	}
+	return 0;
+}
+
+static unsigned io_block_in(int unused, uint16_t addr, uint8_t *buf, unsigned len)
+{
+	unsigned n;
+	if (!ide_block_port(addr))
+		return 0;
+	for (n = 0; n < len; n++)
+		*buf++ = ide_read8(ide0, 0);
+	return len;
+}
+
+static unsigned io_block_out(int unused, uint16_t addr, const uint8_t *buf, unsigned len)
+{
+	unsigned n;
+	if (!ide_block_port(addr))
+		return 0;
+	if (buf == NULL)
+		return len;
+	for (n = 0; n < len; n++)
+		ide_write8(ide0, 0, *buf++);
+	return len;
+}
+
 struct rtc *rtc;
 
 /*
@@ -2059,8 +2108,12 @@ static uint8_t io_read_2014(uint16_t addr)
 		return fdc_read(addr & 7);
 	if (addr == 0x46 && ef9345 && (ef_latch & 0xF0) == 0x20 && !extreme)
 		return ef9345_read(ef9345, ef_latch);
-	if ((addr == 0x42 || addr == 0x43) && amd9511)
+	if ((addr == 0x42 || addr == 0x43) && amd9511) {
+		/* Data reads wait for a busy APU */
+		if (addr == 0x42)
+			cpu_z80.tstates += amd9511_pause(amd9511);
 		return amd9511_read(amd9511, addr);
+	}
 	if ((addr >= 0xA0 && addr <= 0xA7) && acia && acia_narrow == 1)
 		return acia_read(acia, addr & 1);
 	if ((addr >= 0x80 && addr <= 0x87) && acia && acia_narrow == 2)
@@ -2158,8 +2211,10 @@ static void io_write_2014(uint16_t addr, uint8_t val, uint8_t known)
 		ef9345_write(ef9345, ef_latch, val);
 	else if (addr >= 0x48 && addr < 0x50)
 		fdc_write(addr & 7, val);
-	else if ((addr == 0x42 || addr == 0x43) && amd9511)
+	else if ((addr == 0x42 || addr == 0x43) && amd9511) {
+		cpu_z80.tstates += amd9511_pause(amd9511);
 		amd9511_write(amd9511, addr, val);
+	}
 	else if (addr >= 0x40 && addr <= 0x41)
 		propgfx_write(addr & 1, val);
 	else if ((addr >= 0xA0 && addr <= 0xA7) && acia && acia_narrow == 1)
@@ -2870,7 +2925,7 @@ static void exit_cleanup(void)
 
 static void usage(void)
 {
-	fprintf(stderr, "rc2014: [-a] [-A] [-b] [-c] [-f] [-i idepath] [-R] [-m mainboard] [-r rompath] [-e rombank] [-s] [-w] [-d debug]\n");
+	fprintf(stderr, "rc2014: [-a] [-A] [-b] [-c] [-f] [-i idepath] [-R] [-m mainboard] [-r rompath] [-e rombank] [-s] [-t] [-w] [-d debug] [-y screenpattern] [-Y dumpframes] [-V capture.png|capture.rgb] [-L linkfile]\n");
 	exit(EXIT_FAILURE);
 }
 
@@ -2893,6 +2948,10 @@ int main(int argc, char *argv[])
 	int have_sn = 0;
 	char *gdb_bind = NULL;
 	bool gdb_stopped = false;
+	unsigned vt_dump_frames = 0;
+	unsigned vt_frames = 0;
+	char *cappath = NULL;
+	char *linkpath = NULL;
 
 #define INDEV_ACIA	1
 #define INDEV_SIO	2
@@ -2904,7 +2963,7 @@ int main(int argc, char *argv[])
 	while (p < ramrom + sizeof(ramrom))
 		*p++= rand();
 
-	while ((opt = getopt(argc, argv, "1579Aabcd:e:EfF:G:i:I:km:nN:pPr:sRS:Tuw8CZz:XS")) != -1) {
+	while ((opt = getopt(argc, argv, "1579Aabcd:e:EfF:G:i:I:kL:m:nN:pPr:sRS:tTuV:w8CZz:XSy:Y:")) != -1) {
 		switch (opt) {
 		case 'a':
 			have_acia = 1;
@@ -3157,6 +3216,10 @@ int main(int argc, char *argv[])
 		case 'C':
 			have_copro = 1;
 			break;
+		case 't':
+			/* Co-processor on its own thread, not lockstep */
+			copro_threaded = 1;
+			break;
 		case 'F':
 			if (pathb) {
 				fprintf(stderr, "rc2014: too many floppy disks specified.\n");
@@ -3191,6 +3254,21 @@ int main(int argc, char *argv[])
 		case '7':
 			have_sn = 1;
 			break;
+		case 'y':
+			if (vt_wait_for(optarg)) {
+				fprintf(stderr, "rc2014: invalid screen pattern '%s'.\n", optarg);
+				exit(1);
+			}
+			break;
+		case 'Y':
+			vt_dump_frames = atoi(optarg);
+			break;
+		case 'V':
+			cappath = optarg;
+			break;
+		case 'L':
+			linkpath = optarg;
+			break;
 		default:
 			usage();
 		}
@@ -3217,6 +3295,10 @@ int main(int argc, char *argv[])
 			indev = INDEV_ACIA;
 		}
 	}
+	if (linkpath && sio2 == 0) {
+		fprintf(stderr, "rc2014: -L needs an SIO.\n");
+		exit(EXIT_FAILURE);
+	}
 	if (rom == 0 && bank512 == 0) {
 		fprintf(stderr, "rc2014: no ROM\n");
 		exit(EXIT_FAILURE);
@@ -3303,6 +3385,7 @@ int main(int argc, char *argv[])
 	if (have_copro) {
 		copro = z180copro_create();
 		z180copro_trace(copro, (trace >> 17) & 3);
+		z180copro_set_threaded(copro, copro_threaded);
 	}
 
 	if (ide == 1 ) {
@@ -3394,7 +3477,12 @@ int main(int argc, char *argv[])
 			sio_attach(sio, 0, &console);
 		else
 			sio_attach(sio, 0, vt_create("SIOA", CON_VT52));
-		sio_attach(sio, 1, vt_create("SIOB", CON_VT52));
+		/* Port B can be cabled to another emulator */
+		if (linkpath) {
+			sio_link = serlink_create(linkpath);
+			sio_attach(sio, 1, sio_link);
+		} else
+			sio_attach(sio, 1, vt_create("SIOB", CON_VT52));
 	}
 	if (have_ctc)
 		ctc_init();
@@ -3445,6 +3533,20 @@ int main(int argc, char *argv[])
 	if (have_sn)
 		sn = sn76489_create();
 
+	/* Frame capture from the video card, for use without a UI */
+	if (cappath) {
+		if (vdp)
+			cap = capture_create(cappath, 256, 192);
+		else if (ef9345)
+			cap = capture_create(cappath, 492, 280);
+		else {
+			fprintf(stderr, "rc2014: -V needs a TMS9918A or EF9345.\n");
+			exit(1);
+		}
+		if (cap == NULL)
+			exit(1);
+	}
+
 	fdc = fdc_new();
 
 	lib765_register_error_function(fdc_log);
@@ -3517,6 +3619,9 @@ int main(int argc, char *argv[])
 	Z80RESET(&cpu_z80);
 	cpu_z80.ioRead = io_read;
 	cpu_z80.ioWrite = io_write;
+	cpu_z80.ioBlockIn = io_block_in;
+	cpu_z80.ioBlockOut = io_block_out;
+	cpu_z80.fastBlock = 1;
 	cpu_z80.memRead = mem_read;
 	cpu_z80.memWrite = mem_write;
 	cpu_z80.trace = z80_trace;
@@ -3554,6 +3659,8 @@ int main(int argc, char *argv[])
 				}
 				if (ef9345)
 					ef9345_cycles(ef9345, 200);
+				if (amd9511)
+					amd9511_tick(amd9511, tstates);
 				if (copro)
 					z180copro_run(copro);
 				if (ps2)
@@ -3608,10 +3715,14 @@ int main(int argc, char *argv[])
 		if (vdp) {
 			tms9918a_rasterize(vdp);
 			tms9918a_render(vdprend);
+			if (cap)
+				capture_frame(cap, tms9918a_get_raster(vdp), 256);
 		}
 		if (ef9345) {
 			ef9345_rasterize(ef9345);
 			ef9345_render(ef9345rend);
+			if (cap && !vdp)
+				capture_frame(cap, ef9345_get_raster(ef9345), 492);
 		}
 		if (tft) {
 			tft_rasterize(tft);
@@ -3621,6 +3732,15 @@ int main(int argc, char *argv[])
 			w5100_process(wiz);
 		if (have_sc737)
 			sc737_tick();
+		/* Scripted testing against the terminal screens */
+		if (vt_dump_frames && ++vt_frames == vt_dump_frames) {
+			vt_frames = 0;
+			vt_dump(stderr);
+		}
+		if (vt_matched()) {
+			vt_dump(stderr);
+			emulator_done = 1;
+		}
 		/* Do 20ms of I/O and delays */
 		if (!fast)
 			nanosleep(&tc, NULL);
@@ -3634,6 +3754,9 @@ int main(int argc, char *argv[])
 	if (gdb) {
 		gdb_server_free(gdb);
 	}
+	capture_free(cap);
+	if (sio_link)
+		serlink_free(sio_link);
 	if (cpuboard == 3 && save) {
 		lseek(fd, 0L, SEEK_SET);
 		if (write(fd, ramrom, 0x8000 * 4) != 0x8000 * 4) {
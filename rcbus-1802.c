@@ -593,10 +593,7 @@ int main(int argc, char *argv[])
 		int i;
 		/* 36400 T states for base rcbus - varies for others */
 		for (i = 0; i < 100; i++) {
-			/* TODO: need to loop for the desired tstates */
-			cpu.mcycles = 0;
-			while(cpu.mcycles < mcycles)
-				cp1802_run(&cpu);
+			cp1802_execute(&cpu, mcycles);
 			if (acia)
 				acia_timer(acia);
 			if (uart)
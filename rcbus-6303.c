@@ -509,8 +509,8 @@ int main(int argc, char *argv[])
 		unsigned int i;
 		/* 36400 T states for base rcbus - varies for others */
 		for (i = 0; i < 100; i++) {
-			while(cycles < clockrate)
-				cycles += m6800_execute(&cpu);
+			if (cycles < clockrate)
+				cycles += m6800_run(&cpu, clockrate - cycles);
 			cycles -= clockrate;
 		}
 		/* Drive the internal serial */
@@ -428,8 +428,8 @@ int main(int argc, char *argv[])
 	while (!done) {
 		unsigned int i, j;
 		for (i = 0; i < 100; i++) {
-			while (cycles < clockrate)
-				cycles += m6800_execute(&cpu);
+			if (cycles < clockrate)
+				cycles += m6800_run(&cpu, clockrate - cycles);
 			m6840_tick(ptm, cycles);
 			for (j = 0; j < cycles; j++)
 				m6840_external_clock(ptm, 2);
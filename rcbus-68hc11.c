@@ -669,8 +669,8 @@ int main(int argc, char *argv[])
 		/* 36400 T states for base rcbus - varies for others */
 		for (j = 0; j < 10; j++) {
 			for (i = 0; i < 10; i++) {
-				while(cycles < clockrate)
-					cycles += m68hc11_execute(&cpu);
+				if (cycles < clockrate)
+					cycles += m68hc11_run(&cpu, clockrate - cycles);
 				cycles -= clockrate;
 			}
 			/* Drive the internal serial */
@@ -30,6 +30,12 @@
  *	set, but is new enough that it does all the error management internally
  *	so all the error and sparing commands are no-ops.
  *
+ *	Reads and writes are staged through a buffer big enough for the
+ *	largest transfer so a multi-sector command costs one pread or one
+ *	pwrite. sasi_read_burst and sasi_write_burst let a controller with
+ *	a (pseudo) DMA path move a run of data phase bytes at once rather
+ *	than a byte per handshake.
+ *
  *	TODO:
  *	- all the phase error handling
  *	- delays
@@ -48,6 +54,8 @@
 
 #define CHECK_CONDITION	0x02
 
+#define MAX_XFER	256	/* Largest transfer in sectors */
+
 struct sasi_bus;
 
 struct sasi_disk
@@ -65,6 +73,12 @@ struct sasi_disk
 	uint8_t dbuf[516];	/* Good enough for 512 bytes + ecc */
 	uint8_t sensebuf[4];
 
+	uint8_t *data;		/* Current data phase buffer */
+	uint8_t *xbuf;		/* Multi-sector staging buffer */
+	uint32_t xlba;		/* First sector in xbuf */
+	unsigned int xcount;	/* Sectors valid (read) or queued (write) */
+	unsigned int xwrite;	/* xbuf holds queued writes */
+
 	unsigned int dptr;
 	unsigned int dlen;
 	unsigned int cmd_len;
@@ -100,6 +114,24 @@ static int do_read(struct sasi_disk *sd)
 	return 0;
 }
 
+/*
+ *	Fetch the whole of a read into the staging buffer. A short read
+ *	leaves xcount covering just the sectors we got, the per sector
+ *	path then reports the failure at the right LBA.
+ */
+static void do_read_multi(struct sasi_disk *sd)
+{
+	ssize_t r;
+
+	sd->xlba = sd->lba;
+	sd->xcount = 0;
+	sd->xwrite = 0;
+	r = pread(sd->fd, sd->xbuf, sd->count * sd->sectorsize,
+		(off_t)sd->lba * sd->sectorsize);
+	if (r > 0)
+		sd->xcount = r / sd->sectorsize;
+}
+
 static int do_write(struct sasi_disk *sd)
 {
 	if (lseek(sd->fd, sd->lba * sd->sectorsize, SEEK_SET) < 0)
@@ -109,6 +141,19 @@ static int do_write(struct sasi_disk *sd)
 	return 0;
 }
 
+/* Write out any sectors queued in the staging buffer */
+static int do_write_flush(struct sasi_disk *sd)
+{
+	size_t len = sd->xcount * sd->sectorsize;
+
+	if (!sd->xwrite || len == 0)
+		return 0;
+	sd->xcount = 0;
+	if (pwrite(sd->fd, sd->xbuf, len, (off_t)sd->xlba * sd->sectorsize) != len)
+		return -1;
+	return 0;
+}
+
 
 /*
  *	Complete a command and initiate sending of the status
@@ -125,6 +170,7 @@ static void sasi_data_out(struct sasi_disk *sd, unsigned int length)
 {
 	sd->bus->control &= ~(SASI_CD | SASI_IO | SASI_MSG);
 	sd->bus->control |= SASI_REQ;
+	sd->data = sd->dbuf;
 	sd->dptr = 0;
 	sd->dlen = length;
 }
@@ -133,6 +179,7 @@ static void sasi_data_in(struct sasi_disk *sd, unsigned int length)
 {
 	sd->bus->control &= ~(SASI_CD|SASI_MSG);
 	sd->bus->control |= SASI_IO | SASI_REQ;
+	sd->data = sd->dbuf;
 	sd->dptr = 0;
 	sd->dlen = length;
 }
@@ -178,6 +225,14 @@ static void sasi_read_block(struct sasi_disk *sd)
 		sasi_status_in(sd, 0);
 		return;
 	}
+	/* Staged by the command, or the long form with ECC bytes */
+	if (!sd->ecc && sd->lba - sd->xlba < sd->xcount) {
+		sasi_data_in(sd, sd->sectorsize);
+		sd->data = sd->xbuf + (sd->lba - sd->xlba) * sd->sectorsize;
+		sd->lba++;
+		sd->count--;
+		return;
+	}
 	if (do_read(sd) < 0) {
 		sasi_sense_with_lba(sd, 0x14);	/* Target sector not found */
 		sasi_status_in(sd, CHECK_CONDITION);
@@ -194,6 +249,10 @@ static void sasi_read_command(struct sasi_disk *sd, uint32_t lba,
 	sd->lba = lba;
 	sd->count = count;
 	sd->ecc = ecc;
+	sd->xcount = 0;
+	sd->xwrite = 0;
+	if (!ecc)
+		do_read_multi(sd);
 	sasi_read_block(sd);
 }
 
@@ -201,25 +260,39 @@ static void sasi_read_command(struct sasi_disk *sd, uint32_t lba,
 static void sasi_write_block(struct sasi_disk *sd)
 {
 	if (sd->lba == sd->blocks) {
+		/* Anything before the end still gets written */
+		do_write_flush(sd);
 		sasi_sense_with_lba(sd, 0x21);
 		sasi_status_in(sd, CHECK_CONDITION);
 		return;
 	}
-	/* Write the data received */
-	if (do_write(sd)) {
-		sasi_sense_with_lba(sd, 0x14);	/* Target sector not found */
-		sasi_status_in(sd, CHECK_CONDITION);
-		return;
-	}
+	/* Write the data received. The short form is queued in the
+	   staging buffer and written in one go at the end */
+	if (sd->ecc) {
+		if (do_write(sd)) {
+			sasi_sense_with_lba(sd, 0x14);	/* Target sector not found */
+			sasi_status_in(sd, CHECK_CONDITION);
+			return;
+		}
+	} else
+		sd->xcount++;
 	sd->lba++;
 	sd->count--;
 	/* And done */
 	if (sd->count == 0) {
+		if (do_write_flush(sd)) {
+			sd->lba = sd->xlba;
+			sasi_sense_with_lba(sd, 0x14);
+			sasi_status_in(sd, CHECK_CONDITION);
+			return;
+		}
 		sasi_sense_clear(sd);
 		sasi_status_in(sd, 0);
 		return;
 	}
 	sasi_data_out(sd, sd->sectorsize + 4 * sd->ecc);
+	if (!sd->ecc)
+		sd->data = sd->xbuf + sd->xcount * sd->sectorsize;
 }
 
 /*
@@ -232,7 +305,12 @@ static void sasi_write_command(struct sasi_disk *sd, uint32_t lba,
 	sd->lba = lba;
 	sd->count = count;
 	sd->ecc = ecc;
+	sd->xlba = lba;
+	sd->xcount = 0;
+	sd->xwrite = !ecc;
 	sasi_data_out(sd, sd->sectorsize + 4 * sd->ecc);
+	if (!ecc)
+		sd->data = sd->xbuf;
 }
 
 /*
@@ -420,6 +498,9 @@ static void sasi_device_select(struct sasi_disk *sd)
 
 static void sasi_device_begin(struct sasi_disk *sd)
 {
+	/* A write the host walked away from still goes to disk before the
+	   next command can reuse the staging buffer */
+	do_write_flush(sd);
 	/* We expect a command */
 	sd->bus->control &= ~(SASI_IO | SASI_MSG);
 	sd->bus->control |= SASI_CD | SASI_BSY;
@@ -429,6 +510,8 @@ static void sasi_device_begin(struct sasi_disk *sd)
 
 static void sasi_device_reset(struct sasi_disk *sd)
 {
+	/* Don't lose sectors of a write the host gave up on */
+	do_write_flush(sd);
 }
 
 /*
@@ -447,7 +530,7 @@ static void sasi_disk_ack_read(struct sasi_disk *sd)
 
 static uint8_t sasi_disk_read(struct sasi_disk *sd)
 {
-	return sd->dbuf[sd->dptr];
+	return sd->data[sd->dptr];
 }
 
 /*
@@ -499,7 +582,7 @@ static void sasi_disk_ack_mesg(struct sasi_disk *sd)
  */
 static void sasi_disk_write(struct sasi_disk *sd, uint8_t r)
 {
-	sd->dbuf[sd->dptr++] = r;
+	sd->data[sd->dptr++] = r;
 	if (sd->dptr == sd->dlen)
 		sasi_command_execute_out(sd);
 }
@@ -626,6 +709,73 @@ uint8_t sasi_read_data(struct sasi_bus *bus)
 	return r;
 }
 
+/*
+ *	Block transfer for a controller doing DMA or pseudo DMA. Moves up to
+ *	len bytes for as long as the target stays in the data in phase, as
+ *	if each had been handshaked in turn, and returns how many were moved.
+ *	Anything left over is down to the caller to do the slow way.
+ */
+unsigned sasi_read_burst(struct sasi_bus *bus, uint8_t *buf, unsigned len)
+{
+	struct sasi_disk *sd = bus->selected;
+	unsigned n = 0;
+
+	while (n < len && bus->state == BUS_TRANSFER &&
+		(bus->control & (SASI_MSG | SASI_CD | SASI_IO)) == SASI_IO) {
+		unsigned c;
+		if (sd->dptr >= sd->dlen)
+			break;
+		c = sd->dlen - sd->dptr;
+		if (c > len - n)
+			c = len - n;
+		memcpy(buf + n, sd->data + sd->dptr, c);
+		n += c;
+		sd->dptr += c;
+		if (sd->dptr == sd->dlen)
+			sasi_command_execute_in(sd);
+	}
+	return n;
+}
+
+/* And the same for the data out phase */
+unsigned sasi_write_burst(struct sasi_bus *bus, const uint8_t *buf, unsigned len)
+{
+	struct sasi_disk *sd = bus->selected;
+	unsigned n = 0;
+
+	while (n < len && bus->state == BUS_TRANSFER &&
+		(bus->control & (SASI_MSG | SASI_CD | SASI_IO)) == 0) {
+		unsigned c;
+		if (sd->dptr >= sd->dlen)
+			break;
+		c = sd->dlen - sd->dptr;
+		if (c > len - n)
+			c = len - n;
+		memcpy(sd->data + sd->dptr, buf + n, c);
+		n += c;
+		sd->dptr += c;
+		bus->data_val = buf[n - 1];
+		if (sd->dptr == sd->dlen)
+			sasi_command_execute_out(sd);
+	}
+	return n;
+}
+
+/* How much of len sasi_write_burst can take without the target acting on
+   it first */
+unsigned sasi_write_room(struct sasi_bus *bus, unsigned len)
+{
+	struct sasi_disk *sd = bus->selected;
+
+	if (bus->state != BUS_TRANSFER ||
+		(bus->control & (SASI_MSG | SASI_CD | SASI_IO)) != 0 ||
+		sd->dptr >= sd->dlen)
+		return 0;
+	if (len > sd->dlen - sd->dptr)
+		len = sd->dlen - sd->dptr;
+	return len;
+}
+
 static void sasi_bus_exit_reset(struct sasi_bus *bus)
 {
 	int i;
@@ -703,6 +853,8 @@ void sasi_disk_attach(struct sasi_bus *bus, unsigned int lun, const char *path,
 	struct sasi_disk *sd = alloc(sizeof(struct sasi_disk));
 	sd->bus = bus;
 	sd->sectorsize = sectorsize;
+	sd->xbuf = alloc(MAX_XFER * sectorsize);
+	sd->data = sd->dbuf;
 	sd->fd = open(path, O_RDWR);
 	if (sd->fd == -1) {
 		perror(path);
@@ -718,7 +870,9 @@ void sasi_disk_attach(struct sasi_bus *bus, unsigned int lun, const char *path,
 
 static void sasi_disk_free(struct sasi_disk *sd)
 {
+	do_write_flush(sd);
 	close(sd->fd);
+	free(sd->xbuf);
 	free(sd);
 }
 
@@ -15,6 +15,9 @@ void sasi_bus_control(struct sasi_bus *bus, unsigned val);
 uint8_t sasi_read_bus(struct sasi_bus *bus);
 void sasi_ack_bus(struct sasi_bus *bus);
 unsigned sasi_bus_state(struct sasi_bus *bus);
+unsigned sasi_read_burst(struct sasi_bus *bus, uint8_t *buf, unsigned len);
+unsigned sasi_write_burst(struct sasi_bus *bus, const uint8_t *buf, unsigned len);
+unsigned sasi_write_room(struct sasi_bus *bus, unsigned len);
 
 #define SCSI_ATN	0x100
 
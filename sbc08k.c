@@ -227,12 +227,24 @@ void duart_signal_change(struct duart *d, uint8_t opr)
 {
 }
 
+/* Once the first eight fetches have come from ROM, RAM and ROM are plain
+   memory so the CPU can fetch instructions from them directly. The ROM
+   lives in the top of ram[] */
+static void fetch_regions(void)
+{
+	if (trace & TRACE_MEM)
+		return;
+	m68k_set_fetch_region(0, 0, ramtop, ram);
+	m68k_set_fetch_region(1, 0xE0000, 0x10000, ram + 0xE0000);
+}
+
 /* Read data from RAM, ROM, or a device */
 unsigned int do_cpu_read_byte(unsigned int address)
 {
 	address &= 0xFFFFF;
 	if (rcount < 8) {
-		rcount++;
+		if (++rcount == 8)
+			fetch_regions();
 		return ram[(address & 0x3FFFF) + 0xE0000];
 	}
 	if (address < ramtop)
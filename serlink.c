@@ -0,0 +1,228 @@
+/*
+ *	A serial cable between two emulator instances.
+ *
+ *	Rather than a pipe or socket, which costs a system call for every
+ *	byte polled or moved, the two ends share a small file mapped into
+ *	both processes holding a ring for each direction. Each ring has one
+ *	writer and one reader so the head and tail indices are all the
+ *	locking needed, and a poll of the port is a couple of memory loads.
+ *
+ *	Whoever creates the file is end A, whoever opens the existing file
+ *	is end B. Once B has joined both ends have it mapped, so B removes
+ *	the name straight away. If A exits first, by any route that runs
+ *	atexit handlers, it marks the link closed so B can't join and
+ *	removes the name itself. Only a file left behind by an emulator
+ *	that was killed outright has to be removed by hand.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "serialdevice.h"
+#include "serlink.h"
+
+#define RING_SIZE	4096	/* Power of two */
+#define LINK_MAGIC	0x4C4E4B31
+
+/* link_shm.joined */
+#define LINK_WAITING	0
+#define LINK_JOINED	1
+#define LINK_CLOSED	2	/* End A gave up before anyone joined */
+
+struct ring {
+	_Atomic uint32_t head;	/* Written by the sender */
+	_Atomic uint32_t tail;	/* Written by the receiver */
+	uint8_t data[RING_SIZE];
+};
+
+struct link_shm {
+	uint32_t magic;
+	_Atomic uint32_t joined;
+	struct ring ring[2];	/* A to B, B to A */
+};
+
+struct serlink {
+	struct serial_device dev;
+	struct link_shm *shm;
+	struct ring *tx;
+	struct ring *rx;
+	char *path;		/* Set on end A until B joins or A closes */
+	struct serlink *next;
+};
+
+static struct serlink *serlink_list;	/* End A links to tidy on exit */
+
+static uint8_t serlink_get(struct serial_device *dev)
+{
+	struct serlink *sl = dev->private;
+	struct ring *r = sl->rx;
+	uint32_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+	uint8_t c;
+
+	if (tail == atomic_load_explicit(&r->head, memory_order_acquire))
+		return 0xFF;
+	c = r->data[tail % RING_SIZE];
+	atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+	return c;
+}
+
+static void serlink_put(struct serial_device *dev, uint8_t c)
+{
+	struct serlink *sl = dev->private;
+	struct ring *r = sl->tx;
+	uint32_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+
+	/* Like a real line with no flow control the byte is lost if the
+	   far end isn't keeping up */
+	if (head - atomic_load_explicit(&r->tail, memory_order_acquire) == RING_SIZE)
+		return;
+	r->data[head % RING_SIZE] = c;
+	atomic_store_explicit(&r->head, head + 1, memory_order_release);
+}
+
+static unsigned serlink_ready(struct serial_device *dev)
+{
+	struct serlink *sl = dev->private;
+	unsigned r = 0;
+
+	if (atomic_load_explicit(&sl->rx->head, memory_order_acquire) !=
+		atomic_load_explicit(&sl->rx->tail, memory_order_relaxed))
+		r |= 1;
+	if (atomic_load_explicit(&sl->tx->head, memory_order_relaxed) -
+		atomic_load_explicit(&sl->tx->tail, memory_order_acquire) != RING_SIZE)
+		r |= 2;
+	return r;
+}
+
+/* On end A remove the name unless end B has joined, in which case B has
+   already removed it and it may since have been reused */
+static void serlink_unname(struct serlink *sl)
+{
+	uint32_t expect = LINK_WAITING;
+
+	if (sl->path == NULL)
+		return;
+	if (atomic_compare_exchange_strong(&sl->shm->joined, &expect, LINK_CLOSED))
+		unlink(sl->path);
+	free(sl->path);
+	sl->path = NULL;
+}
+
+static void serlink_exit(void)
+{
+	struct serlink *sl;
+
+	for (sl = serlink_list; sl; sl = sl->next)
+		serlink_unname(sl);
+}
+
+static struct link_shm *serlink_map(int fd, const char *path)
+{
+	struct link_shm *shm;
+
+	shm = mmap(NULL, sizeof(struct link_shm), PROT_READ | PROT_WRITE,
+		MAP_SHARED, fd, 0);
+	close(fd);
+	if (shm == MAP_FAILED) {
+		perror(path);
+		exit(1);
+	}
+	return shm;
+}
+
+struct serial_device *serlink_create(const char *path)
+{
+	struct serlink *sl;
+	struct stat st;
+	static unsigned registered;
+	unsigned end = 0;
+	uint32_t expect = LINK_WAITING;
+	char *tmp;
+	int fd;
+
+	sl = malloc(sizeof(struct serlink));
+	tmp = malloc(strlen(path) + 8);
+	if (sl == NULL || tmp == NULL) {
+		fprintf(stderr, "Out of memory.\n");
+		exit(1);
+	}
+	memset(sl, 0, sizeof(struct serlink));
+
+	/* Set end A's file up under a temporary name and then link it into
+	   place, so end B can never see it part built. The file is zero
+	   filled so the rings start out empty */
+	sprintf(tmp, "%s.XXXXXX", path);
+	fd = mkstemp(tmp);
+	if (fd == -1 || ftruncate(fd, sizeof(struct link_shm)) == -1) {
+		perror(tmp);
+		exit(1);
+	}
+	sl->shm = serlink_map(fd, tmp);
+	sl->shm->magic = LINK_MAGIC;
+	if (link(tmp, path) == 0) {
+		sl->path = strdup(path);
+		sl->next = serlink_list;
+		serlink_list = sl;
+		if (!registered++)
+			atexit(serlink_exit);
+	} else if (errno == EEXIST) {
+		munmap(sl->shm, sizeof(struct link_shm));
+		end = 1;
+		fd = open(path, O_RDWR);
+		if (fd == -1 || fstat(fd, &st) == -1) {
+			perror(path);
+			exit(1);
+		}
+		if (st.st_size != sizeof(struct link_shm)) {
+			fprintf(stderr, "%s: not a serial link.\n", path);
+			exit(1);
+		}
+		sl->shm = serlink_map(fd, path);
+		if (sl->shm->magic != LINK_MAGIC ||
+			!atomic_compare_exchange_strong(&sl->shm->joined, &expect, LINK_JOINED)) {
+			fprintf(stderr, "%s: link not available.\n", path);
+			exit(1);
+		}
+		/* Both ends hold the mapping now, the name is no longer needed */
+		unlink(path);
+	} else {
+		perror(path);
+		exit(1);
+	}
+	unlink(tmp);
+	free(tmp);
+
+	sl->tx = &sl->shm->ring[end];
+	sl->rx = &sl->shm->ring[!end];
+
+	sl->dev.name = "Link";
+	sl->dev.private = sl;
+	sl->dev.get = serlink_get;
+	sl->dev.put = serlink_put;
+	sl->dev.ready = serlink_ready;
+	return &sl->dev;
+}
+
+void serlink_free(struct serial_device *dev)
+{
+	struct serlink *sl = dev->private;
+	struct serlink **p;
+
+	serlink_unname(sl);
+	for (p = &serlink_list; *p; p = &(*p)->next) {
+		if (*p == sl) {
+			*p = sl->next;
+			break;
+		}
+	}
+	munmap(sl->shm, sizeof(struct link_shm));
+	free(sl);
+}
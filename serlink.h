@@ -0,0 +1,11 @@
+#ifndef SERLINK_H
+#define SERLINK_H
+
+/*
+ *	Serial link between two emulator processes through a shared memory
+ *	file. The first to open the path gets one end, the second the other.
+ */
+extern struct serial_device *serlink_create(const char *path);
+extern void serlink_free(struct serial_device *dev);
+
+#endif
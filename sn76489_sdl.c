@@ -54,15 +54,10 @@ struct sn76489 *sn76489_create(void)
 
 void play_buffer(void *userdata, unsigned char *stream, int len)
 {
-    static size_t total_sample_count = 0;
     Sint16 *audio_buffer = (Sint16*)stream;
     int bytes_per_sample = CHANNELS * sizeof(Sint16);
     int samples_to_write = len / bytes_per_sample;
-    for (int i=0; i<samples_to_write; i++)
-    {
-        *audio_buffer++ = SNG_calc(sng);
-        total_sample_count ++;
-    }
+    SNG_calc_block(sng, audio_buffer, samples_to_write);
 }
 
 uint8_t sn76489_ready(struct sn76489 *sn)
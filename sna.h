@@ -4,9 +4,17 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "libz80/z80.h"
+#include "ay8912.h"
+
+/* Machine the snapshot is taken from / restored into. */
+#define SNA_MODEL_48K       0
+#define SNA_MODEL_128K      1
+#define SNA_MODEL_PLUS3     2
 
 /*
  * Context passed to load_sna() containing all external state it needs.
+ * The .z80/.szx code (snapshot.c) also uses p3latch, ula, ay and model;
+ * the pointers may be NULL if the machine has no such state.
  * SNA format refs:
  *   https://sinclair.wiki.zxnet.co.uk/wiki/SNA_format
  *   https://worldofspectrum.net/zx-modules/fileformats/snaformat.html
@@ -19,6 +27,10 @@ typedef struct {
     void       (*mem_write)(int, uint16_t, uint8_t);
     uint8_t    (*mem_read)(int, uint16_t);
     void       (*recalc_mmu)(void);
+    uint8_t     *p3latch;               /* 1FFD on the +3 */
+    uint8_t     *ula;                   /* Last OUT to 0xFE */
+    ay8912_t    *ay;
+    unsigned     model;                 /* SNA_MODEL_xxx */
 } sna_context_t;
 
 #ifdef __cplusplus
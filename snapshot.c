@@ -0,0 +1,762 @@
+/*
+ * snapshot.c – .z80 and .szx snapshot loaders/savers for the ZX Spectrum
+ * emulator.
+ *
+ * Both formats carry full 128K/+3 state (7FFD, 1FFD, AY registers) which
+ * .sna cannot, and both store RAM as separate 16K pages that are restored
+ * straight into the ram[] bank arrays rather than through mem_write.
+ *
+ * .z80:  v1 is a 48K image, optionally ED ED RLE compressed. v2/v3 have
+ *        PC=0 in the base header, an extended header and then one block
+ *        per 16K page. We always save v3 (with the 1FFD byte).
+ * .szx:  "ZXST" header followed by tagged blocks. RAMP pages may be zlib
+ *        compressed. Build with -DNO_ZLIB to drop the zlib dependency; the
+ *        saver then stores pages uncompressed and the loader rejects
+ *        compressed pages.
+ *
+ * Format refs:
+ *   https://worldofspectrum.net/zx-modules/fileformats/z80format.html
+ *   https://www.spectaculator.com/docs/zx-state/intro.shtml
+ */
+
+#include "snapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#ifndef NO_ZLIB
+#include <zlib.h>
+#endif
+
+/* RAM bank index helper (must match spectrum.c layout) */
+#define SNAP_RAM(x)  ((x) + 8)
+
+#define SZX_ID(a, b, c, d) \
+    ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+static unsigned rd16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t rd32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void wr16(uint8_t *p, unsigned v)
+{
+    p[0] = v;
+    p[1] = v >> 8;
+}
+
+static void wr32(uint8_t *p, uint32_t v)
+{
+    wr16(p, v);
+    wr16(p + 2, v >> 16);
+}
+
+static uint8_t *snap_slurp(const char *filename, long *len)
+{
+    FILE *f = fopen(filename, "rb");
+    uint8_t *buf;
+
+    if (!f) {
+        fprintf(stderr, "No se pudo abrir snapshot: %s\n", filename);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    *len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc(*len > 0 ? *len : 1);
+    if (buf == NULL || fread(buf, 1, *len, f) != (size_t)*len) {
+        fprintf(stderr, "Error leyendo snapshot: %s\n", filename);
+        free(buf);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    return buf;
+}
+
+static bool snap_close(FILE *f, const char *filename)
+{
+    bool ok = !ferror(f);
+    if (fclose(f))
+        ok = false;
+    if (!ok)
+        fprintf(stderr, "Error escribiendo snapshot: %s\n", filename);
+    return ok;
+}
+
+/*
+ * Paging, border and ULA state shared by both formats, applied once RAM
+ * and registers are in place. A 48K snapshot on a 128K/+3 gets paging
+ * locked with the 48K BASIC ROM selected, which is what the 48K mode of
+ * those machines does.
+ */
+static void snap_finish(const sna_context_t *ctx, bool is128, uint8_t m7ffd,
+                        uint8_t m1ffd, uint8_t border, uint8_t fe)
+{
+    if (!is128) {
+        m7ffd = ctx->model == SNA_MODEL_48K ? 0 : 0x30;
+        m1ffd = 0x04;
+    }
+    *ctx->mlatch = m7ffd;
+    if (ctx->p3latch)
+        *ctx->p3latch = ctx->model == SNA_MODEL_PLUS3 ? m1ffd : 0;
+    *ctx->border_color = border & 7;
+    if (ctx->ula)
+        *ctx->ula = fe;
+    ctx->recalc_mmu();
+}
+
+/*
+ * Both loaders decode RAM into these pages and the registers into a copy
+ * of the CPU, and only touch the machine once the whole file has checked
+ * out. A corrupt snapshot then leaves the running program as it was.
+ */
+static uint8_t snap_pages[8][16384];
+
+static void snap_commit_ram(const sna_context_t *ctx, unsigned loaded)
+{
+    unsigned i;
+
+    for (i = 0; i < 8; i++)
+        if (loaded & (1 << i))
+            memcpy(ctx->ram[SNAP_RAM(i)], snap_pages[i], 16384);
+}
+
+/* Register writes go through the PSG so envelope/tone state follows. */
+static void snap_set_ay(const sna_context_t *ctx, uint8_t cur, const uint8_t *regs)
+{
+    unsigned r;
+
+    if (ctx->ay == NULL)
+        return;
+    for (r = 0; r < 16; r++) {
+        ay8912_select_reg(ctx->ay, r);
+        ay8912_write_data(ctx->ay, regs[r]);
+    }
+    ay8912_select_reg(ctx->ay, cur & 0x0F);
+}
+
+static void snap_get_ay(const sna_context_t *ctx, uint8_t *cur, uint8_t *regs)
+{
+    unsigned r;
+
+    if (ctx->ay == NULL)
+        return;
+    *cur = ay8912_selected(ctx->ay);
+    for (r = 0; r < 16; r++)
+        regs[r] = ay8912_peek(ctx->ay, r);
+}
+
+static void snap_report(const char *what, const char *filename, const sna_context_t *ctx)
+{
+    printf("Snapshot %s cargado: %s  (7FFD=0x%02X)\n", what, filename, *ctx->mlatch);
+    printf("PC=0x%04X  SP=0x%04X  Border=%d  IM=%d\n",
+           ctx->cpu->PC, ctx->cpu->R1.wr.SP, *ctx->border_color, ctx->cpu->IM);
+}
+
+/*
+ *  .z80
+ */
+
+/*
+ * Expand ED ED nn bb runs from src into exactly len bytes at dst. Returns
+ * the number of source bytes used, or -1 if the data is short or a run
+ * overflows the page.
+ */
+static long z80_unrle(const uint8_t *src, size_t slen, uint8_t *dst, size_t len)
+{
+    size_t s = 0, d = 0;
+
+    while (d < len && s < slen) {
+        if (s + 4 <= slen && src[s] == 0xED && src[s + 1] == 0xED) {
+            unsigned n = src[s + 2];
+            if (n > len - d)
+                return -1;
+            memset(dst + d, src[s + 3], n);
+            d += n;
+            s += 4;
+        } else
+            dst[d++] = src[s++];
+    }
+    if (d < len)
+        return -1;
+    return s;
+}
+
+/*
+ * Compress with the ED ED scheme: runs of five or more, and any pair of
+ * EDs, become ED ED nn bb. The byte after a lone ED is never the start of
+ * a run, or the decoder would see ED ED. dst needs room for 2 * len.
+ */
+static size_t z80_rle(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t s = 0, d = 0;
+
+    while (s < len) {
+        uint8_t b = src[s];
+        size_t n = 1;
+        while (s + n < len && n < 255 && src[s + n] == b)
+            n++;
+        if (n >= 5 || (b == 0xED && n >= 2)) {
+            dst[d++] = 0xED;
+            dst[d++] = 0xED;
+            dst[d++] = n;
+            dst[d++] = b;
+            s += n;
+        } else {
+            dst[d++] = src[s++];
+            if (b == 0xED && s < len)
+                dst[d++] = src[s++];
+        }
+    }
+    return d;
+}
+
+/* RAM bank for a .z80 page number, or -1 for ROM/interface pages we skip */
+static int z80_page(unsigned page, bool is128)
+{
+    if (is128) {
+        if (page >= 3 && page <= 10)
+            return page - 3;
+        return -1;
+    }
+    switch(page) {
+    case 4:
+        return 2;
+    case 5:
+        return 0;
+    case 8:
+        return 5;
+    }
+    return -1;
+}
+
+/* Hardware mode byte to machine class. v2 and v3 number them differently. */
+static unsigned z80_model(unsigned version, unsigned hw)
+{
+    if (version == 2)
+        return (hw == 3 || hw == 4) ? SNA_MODEL_128K : SNA_MODEL_48K;
+    switch(hw) {
+    case 7:
+    case 8:
+    case 13:
+        return SNA_MODEL_PLUS3;
+    case 4:
+    case 5:
+    case 6:
+    case 9:
+    case 10:
+    case 12:
+        return SNA_MODEL_128K;
+    }
+    return SNA_MODEL_48K;
+}
+
+bool load_z80(const char *filename, const sna_context_t *ctx)
+{
+    Z80Context next = *ctx->cpu;
+    Z80Context *cpu = &next;
+    const char *err = NULL;
+    uint8_t *buf;
+    const uint8_t *h;
+    long len;
+    long off;
+    unsigned version = 1;
+    unsigned ext = 0;
+    unsigned model = SNA_MODEL_48K;
+    uint8_t flags;
+    uint8_t m7ffd = 0, m1ffd = 0;
+    unsigned loaded = 0;
+
+    buf = snap_slurp(filename, &len);
+    if (buf == NULL)
+        return false;
+    h = buf;
+    if (len < 30) {
+        err = "Archivo .z80 incompleto (header)";
+        goto bad;
+    }
+    /* PC of zero in the base header means an extended (v2/v3) header */
+    if (rd16(h + 6) == 0) {
+        if (len < 32 || (ext = rd16(h + 30)) + 32 > (unsigned long)len) {
+            err = "Archivo .z80 incompleto (header extendido)";
+            goto bad;
+        }
+        if (ext == 23)
+            version = 2;
+        else if (ext == 54 || ext == 55)
+            version = 3;
+        else {
+            err = "Versión de .z80 desconocida";
+            goto bad;
+        }
+        model = z80_model(version, h[34]);
+    }
+    if (model != SNA_MODEL_48K && ctx->model == SNA_MODEL_48K) {
+        err = "Snapshot .z80 de 128K: hace falta una ROM de 128K/+3";
+        goto bad;
+    }
+
+    /* Compatibility: 255 in byte 12 means 1 */
+    flags = h[12] == 0xFF ? 1 : h[12];
+
+    cpu->R1.wr.AF = (h[0] << 8) | h[1];
+    cpu->R1.wr.BC = rd16(h + 2);
+    cpu->R1.wr.HL = rd16(h + 4);
+    cpu->PC       = rd16(h + 6);
+    cpu->R1.wr.SP = rd16(h + 8);
+    cpu->I        = h[10];
+    cpu->R        = (h[11] & 0x7F) | ((flags & 1) << 7);
+    cpu->R1.wr.DE = rd16(h + 13);
+    cpu->R2.wr.BC = rd16(h + 15);
+    cpu->R2.wr.DE = rd16(h + 17);
+    cpu->R2.wr.HL = rd16(h + 19);
+    cpu->R2.wr.AF = (h[21] << 8) | h[22];
+    cpu->R1.wr.IY = rd16(h + 23);
+    cpu->R1.wr.IX = rd16(h + 25);
+    cpu->IFF1     = h[27] ? 1 : 0;
+    cpu->IFF2     = h[28] ? 1 : 0;
+    cpu->IM       = h[29] & 3;
+    cpu->halted   = 0;
+
+    if (version == 1) {
+        static uint8_t ram48k[49152];
+        if (flags & 0x20) {
+            if (z80_unrle(buf + 30, len - 30, ram48k, sizeof(ram48k)) < 0) {
+                err = "Archivo .z80 corrupto (RAM 48K)";
+                goto bad;
+            }
+        } else if (len - 30 < (long)sizeof(ram48k)) {
+            err = "Archivo .z80 incompleto (RAM 48K)";
+            goto bad;
+        } else
+            memcpy(ram48k, buf + 30, sizeof(ram48k));
+        memcpy(snap_pages[5], ram48k, 16384);
+        memcpy(snap_pages[2], ram48k + 0x4000, 16384);
+        memcpy(snap_pages[0], ram48k + 0x8000, 16384);
+        loaded = (1 << 5) | (1 << 2) | (1 << 0);
+    } else {
+        cpu->PC = rd16(h + 32);
+        m7ffd = h[35];
+        if (ext == 55)
+            m1ffd = h[86];
+        off = 32 + ext;
+        while (off + 3 <= len) {
+            unsigned blen = rd16(buf + off);
+            int bank = z80_page(buf[off + 2], model != SNA_MODEL_48K);
+            const uint8_t *src = buf + off + 3;
+            /* 0xFFFF: stored uncompressed (v3) */
+            long need = blen == 0xFFFF ? 16384 : blen;
+
+            if (need > len - off - 3) {
+                err = "Archivo .z80 incompleto (bloque de memoria)";
+                goto bad;
+            }
+            if (bank >= 0) {
+                if (blen == 0xFFFF)
+                    memcpy(snap_pages[bank], src, 16384);
+                else if (z80_unrle(src, blen, snap_pages[bank], 16384) < 0) {
+                    err = "Archivo .z80 corrupto (bloque de memoria)";
+                    goto bad;
+                }
+                loaded |= 1 << bank;
+            }
+            off += 3 + need;
+        }
+    }
+
+    /* Everything checked out: now load the machine */
+    *ctx->cpu = next;
+    snap_commit_ram(ctx, loaded);
+    if (version != 1 && model != SNA_MODEL_48K)
+        snap_set_ay(ctx, h[38], h + 39);
+    snap_finish(ctx, model != SNA_MODEL_48K, m7ffd, m1ffd, (flags >> 1) & 7, (flags >> 1) & 7);
+    free(buf);
+
+    snap_report(version == 1 ? ".z80 (v1)" : version == 2 ? ".z80 (v2)" : ".z80 (v3)",
+                filename, ctx);
+    return true;
+
+bad:
+    fprintf(stderr, "%s: %s\n", err, filename);
+    free(buf);
+    return false;
+}
+
+bool save_z80(const char *filename, const sna_context_t *ctx)
+{
+    static uint8_t pack[2 * 16384];
+    Z80Context *cpu = ctx->cpu;
+    uint8_t h[87];
+    uint8_t blk[3];
+    unsigned i;
+    FILE *f;
+
+    memset(h, 0, sizeof(h));
+    h[0] = cpu->R1.wr.AF >> 8;
+    h[1] = cpu->R1.wr.AF;
+    wr16(h + 2, cpu->R1.wr.BC);
+    wr16(h + 4, cpu->R1.wr.HL);
+    /* h[6..7] PC = 0: v2+ header follows */
+    wr16(h + 8, cpu->R1.wr.SP);
+    h[10] = cpu->I;
+    h[11] = cpu->R & 0x7F;
+    h[12] = ((cpu->R >> 7) & 1) | ((*ctx->border_color & 7) << 1);
+    wr16(h + 13, cpu->R1.wr.DE);
+    wr16(h + 15, cpu->R2.wr.BC);
+    wr16(h + 17, cpu->R2.wr.DE);
+    wr16(h + 19, cpu->R2.wr.HL);
+    h[21] = cpu->R2.wr.AF >> 8;
+    h[22] = cpu->R2.wr.AF;
+    wr16(h + 23, cpu->R1.wr.IY);
+    wr16(h + 25, cpu->R1.wr.IX);
+    h[27] = cpu->IFF1;
+    h[28] = cpu->IFF2;
+    h[29] = cpu->IM & 3;
+
+    /* v3 header with the 1FFD byte. T-state counter left at zero as the
+       emulator always resumes at the start of a frame. A halted CPU has
+       PC on the HALT so it simply executes it again. */
+    wr16(h + 30, 55);
+    wr16(h + 32, cpu->PC);
+    switch(ctx->model) {
+    case SNA_MODEL_48K:
+        h[34] = 0;
+        break;
+    case SNA_MODEL_128K:
+        h[34] = 4;
+        h[35] = *ctx->mlatch;
+        break;
+    default:
+        h[34] = 7;
+        h[35] = *ctx->mlatch;
+        if (ctx->p3latch)
+            h[86] = *ctx->p3latch;
+        break;
+    }
+    snap_get_ay(ctx, &h[38], h + 39);
+
+    f = fopen(filename, "wb");
+    if (!f) {
+        fprintf(stderr, "No se pudo crear snapshot: %s\n", filename);
+        return false;
+    }
+    fwrite(h, 1, sizeof(h), f);
+    for (i = 0; i < (ctx->model == SNA_MODEL_48K ? 3 : 8); i++) {
+        static const uint8_t page48[3] = { 4, 5, 8 };
+        static const uint8_t bank48[3] = { 2, 0, 5 };
+        const uint8_t *src;
+        size_t n;
+
+        if (ctx->model == SNA_MODEL_48K) {
+            blk[2] = page48[i];
+            src = ctx->ram[SNAP_RAM(bank48[i])];
+        } else {
+            blk[2] = i + 3;
+            src = ctx->ram[SNAP_RAM(i)];
+        }
+        n = z80_rle(src, 16384, pack);
+        if (n >= 16384) {
+            wr16(blk, 0xFFFF);
+            fwrite(blk, 1, 3, f);
+            fwrite(src, 1, 16384, f);
+        } else {
+            wr16(blk, n);
+            fwrite(blk, 1, 3, f);
+            fwrite(pack, 1, n, f);
+        }
+    }
+    return snap_close(f, filename);
+}
+
+/*
+ *  .szx
+ */
+
+/* chMachineId values that have no 128K paging */
+static bool szx_is48(unsigned machine)
+{
+    switch(machine) {
+    case 0:     /* 16K */
+    case 1:     /* 48K */
+    case 8:     /* TC2048 */
+    case 9:     /* TC2068 */
+    case 12:    /* TS2068 */
+    case 15:    /* 48K NTSC */
+        return true;
+    }
+    return false;
+}
+
+bool load_szx(const char *filename, const sna_context_t *ctx)
+{
+    Z80Context next = *ctx->cpu;
+    Z80Context *cpu = &next;
+    const char *err = NULL;
+    uint8_t *buf;
+    long len;
+    long off;
+    bool is128;
+    bool regs = false;
+    bool halted = false;
+    uint8_t m7ffd = 0, m1ffd = 0, border = 7, fe = 7;
+    const uint8_t *ay = NULL;
+    unsigned loaded = 0;
+
+    buf = snap_slurp(filename, &len);
+    if (buf == NULL)
+        return false;
+    if (len < 8 || memcmp(buf, "ZXST", 4)) {
+        err = "No es un archivo .szx";
+        goto bad;
+    }
+    is128 = !szx_is48(buf[6]);
+    if (is128 && ctx->model == SNA_MODEL_48K) {
+        err = "Snapshot .szx de 128K: hace falta una ROM de 128K/+3";
+        goto bad;
+    }
+
+    off = 8;
+    while (off + 8 <= len) {
+        uint32_t id = rd32(buf + off);
+        uint32_t size = rd32(buf + off + 4);
+        const uint8_t *b = buf + off + 8;
+
+        if (size > (unsigned long)(len - off - 8)) {
+            err = "Archivo .szx incompleto (bloque)";
+            goto bad;
+        }
+        switch(id) {
+        case SZX_ID('Z', '8', '0', 'R'):
+            if (size < 37) {
+                err = "Bloque Z80R inválido";
+                goto bad;
+            }
+            cpu->R1.wr.AF = rd16(b + 0);
+            cpu->R1.wr.BC = rd16(b + 2);
+            cpu->R1.wr.DE = rd16(b + 4);
+            cpu->R1.wr.HL = rd16(b + 6);
+            cpu->R2.wr.AF = rd16(b + 8);
+            cpu->R2.wr.BC = rd16(b + 10);
+            cpu->R2.wr.DE = rd16(b + 12);
+            cpu->R2.wr.HL = rd16(b + 14);
+            cpu->R1.wr.IX = rd16(b + 16);
+            cpu->R1.wr.IY = rd16(b + 18);
+            cpu->R1.wr.SP = rd16(b + 20);
+            cpu->PC       = rd16(b + 22);
+            cpu->I        = b[24];
+            cpu->R        = b[25];
+            cpu->IFF1     = b[26] ? 1 : 0;
+            cpu->IFF2     = b[27] ? 1 : 0;
+            cpu->IM       = b[28] & 3;
+            cpu->halted   = 0;
+            halted        = b[34] & 0x02;
+            regs = true;
+            break;
+        case SZX_ID('S', 'P', 'C', 'R'):
+            if (size < 4) {
+                err = "Bloque SPCR inválido";
+                goto bad;
+            }
+            border = b[0];
+            m7ffd = b[1];
+            m1ffd = b[2];
+            fe = b[3];
+            break;
+        case SZX_ID('R', 'A', 'M', 'P'):
+            if (size < 3) {
+                err = "Bloque RAMP inválido";
+                goto bad;
+            }
+            if (b[2] > 7)
+                break;
+            if (rd16(b) & 0x01) {
+#ifndef NO_ZLIB
+                uLongf dlen = 16384;
+                if (uncompress(snap_pages[b[2]], &dlen, b + 3, size - 3) != Z_OK ||
+                    dlen != 16384) {
+                    err = "Bloque RAMP corrupto";
+                    goto bad;
+                }
+#else
+                err = "Bloque RAMP comprimido (compilado sin zlib)";
+                goto bad;
+#endif
+            } else if (size - 3 == 16384)
+                memcpy(snap_pages[b[2]], b + 3, 16384);
+            else {
+                err = "Bloque RAMP inválido";
+                goto bad;
+            }
+            loaded |= 1 << b[2];
+            break;
+        case SZX_ID('A', 'Y', 0, 0):
+            if (size >= 18)
+                ay = b;
+            break;
+        }
+        off += 8 + size;
+    }
+    if (!regs) {
+        err = "Archivo .szx sin bloque Z80R";
+        goto bad;
+    }
+
+    /* Everything checked out: now load the machine */
+    cpu = ctx->cpu;
+    *cpu = next;
+    snap_commit_ram(ctx, loaded);
+    if (ay)
+        snap_set_ay(ctx, ay[1], ay + 2);
+    snap_finish(ctx, is128, m7ffd, m1ffd, border, fe);
+    /* ZXSTZF_HALTED: PC is past the HALT. libz80 keeps PC on the HALT
+       instead, so step back and let it execute again. */
+    if (halted && ctx->mem_read(0, cpu->PC - 1) == 0x76)
+        cpu->PC--;
+    free(buf);
+
+    snap_report(".szx", filename, ctx);
+    return true;
+
+bad:
+    fprintf(stderr, "%s: %s\n", err, filename);
+    free(buf);
+    return false;
+}
+
+static void szx_block(FILE *f, const char *id, uint32_t size)
+{
+    uint8_t b[8];
+
+    memcpy(b, id, 4);
+    wr32(b + 4, size);
+    fwrite(b, 1, 8, f);
+}
+
+bool save_szx(const char *filename, const sna_context_t *ctx)
+{
+    static const uint8_t pages48[3] = { 5, 2, 0 };
+#ifndef NO_ZLIB
+    static uint8_t pack[16384 + 1024];
+#endif
+    Z80Context *cpu = ctx->cpu;
+    uint8_t b[37];
+    unsigned i;
+    FILE *f;
+
+    f = fopen(filename, "wb");
+    if (!f) {
+        fprintf(stderr, "No se pudo crear snapshot: %s\n", filename);
+        return false;
+    }
+
+    /* Header: version 1.4, machine 48K / 128K / +3 */
+    memcpy(b, "ZXST", 4);
+    b[4] = 1;
+    b[5] = 4;
+    b[6] = ctx->model == SNA_MODEL_48K ? 1 : ctx->model == SNA_MODEL_128K ? 2 : 5;
+    b[7] = 0;
+    fwrite(b, 1, 8, f);
+
+    memset(b, 0, sizeof(b));
+    wr16(b + 0, cpu->R1.wr.AF);
+    wr16(b + 2, cpu->R1.wr.BC);
+    wr16(b + 4, cpu->R1.wr.DE);
+    wr16(b + 6, cpu->R1.wr.HL);
+    wr16(b + 8, cpu->R2.wr.AF);
+    wr16(b + 10, cpu->R2.wr.BC);
+    wr16(b + 12, cpu->R2.wr.DE);
+    wr16(b + 14, cpu->R2.wr.HL);
+    wr16(b + 16, cpu->R1.wr.IX);
+    wr16(b + 18, cpu->R1.wr.IY);
+    wr16(b + 20, cpu->R1.wr.SP);
+    /* A halted CPU has PC on the HALT and simply executes it again */
+    wr16(b + 22, cpu->PC);
+    b[24] = cpu->I;
+    b[25] = cpu->R;
+    b[26] = cpu->IFF1;
+    b[27] = cpu->IFF2;
+    b[28] = cpu->IM;
+    /* dwCyclesStart 0: we always resume at the start of a frame */
+    b[33] = ctx->model == SNA_MODEL_48K ? 32 : 36;
+    szx_block(f, "Z80R", 37);
+    fwrite(b, 1, 37, f);
+
+    memset(b, 0, 8);
+    b[0] = *ctx->border_color;
+    if (ctx->model != SNA_MODEL_48K)
+        b[1] = *ctx->mlatch;
+    if (ctx->model == SNA_MODEL_PLUS3 && ctx->p3latch)
+        b[2] = *ctx->p3latch;
+    b[3] = ctx->ula ? *ctx->ula : *ctx->border_color;
+    szx_block(f, "SPCR", 8);
+    fwrite(b, 1, 8, f);
+
+    if (ctx->ay) {
+        memset(b, 0, 18);
+        snap_get_ay(ctx, &b[1], b + 2);
+        szx_block(f, "AY\0\0", 18);
+        fwrite(b, 1, 18, f);
+    }
+
+    for (i = 0; i < (ctx->model == SNA_MODEL_48K ? 3 : 8); i++) {
+        unsigned page = ctx->model == SNA_MODEL_48K ? pages48[i] : i;
+        const uint8_t *src = ctx->ram[SNAP_RAM(page)];
+
+        b[2] = page;
+#ifndef NO_ZLIB
+        {
+            uLongf clen = sizeof(pack);
+            if (compress2(pack, &clen, src, 16384, Z_BEST_COMPRESSION) == Z_OK &&
+                clen < 16384) {
+                wr16(b, 0x01);          /* ZXSTRF_COMPRESSED */
+                szx_block(f, "RAMP", 3 + clen);
+                fwrite(b, 1, 3, f);
+                fwrite(pack, 1, clen, f);
+                continue;
+            }
+        }
+#endif
+        wr16(b, 0);
+        szx_block(f, "RAMP", 3 + 16384);
+        fwrite(b, 1, 3, f);
+        fwrite(src, 1, 16384, f);
+    }
+    return snap_close(f, filename);
+}
+
+/*
+ *  Dispatch on the file extension
+ */
+
+static bool snap_ext(const char *filename, const char *ext)
+{
+    size_t n = strlen(filename);
+    size_t e = strlen(ext);
+    return n > e && strcasecmp(filename + n - e, ext) == 0;
+}
+
+bool load_snapshot(const char *filename, const sna_context_t *ctx)
+{
+    if (snap_ext(filename, ".z80"))
+        return load_z80(filename, ctx);
+    if (snap_ext(filename, ".szx"))
+        return load_szx(filename, ctx);
+    return load_sna(filename, ctx);
+}
+
+bool save_snapshot(const char *filename, const sna_context_t *ctx)
+{
+    if (snap_ext(filename, ".z80"))
+        return save_z80(filename, ctx);
+    if (snap_ext(filename, ".szx"))
+        return save_szx(filename, ctx);
+    fprintf(stderr, "Solo se pueden guardar snapshots .z80 o .szx: %s\n", filename);
+    return false;
+}
@@ -0,0 +1,34 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include "sna.h"
+
+/*
+ * .z80 (v1-v3) and .szx snapshot support. Both use the sna_context_t
+ * from sna.h and restore RAM directly into the ctx->ram[] banks.
+ *
+ * .z80 format ref:
+ *   https://worldofspectrum.net/zx-modules/fileformats/z80format.html
+ * .szx format ref:
+ *   https://www.spectaculator.com/docs/zx-state/intro.shtml
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool load_z80(const char *filename, const sna_context_t *ctx);
+bool save_z80(const char *filename, const sna_context_t *ctx);
+bool load_szx(const char *filename, const sna_context_t *ctx);
+bool save_szx(const char *filename, const sna_context_t *ctx);
+
+/* Pick the format from the file extension (.z80, .szx, otherwise .sna). */
+bool load_snapshot(const char *filename, const sna_context_t *ctx);
+bool save_snapshot(const char *filename, const sna_context_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SNAPSHOT_H */
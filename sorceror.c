@@ -763,8 +763,13 @@ int main(int argc, char *argv[])
 	}
 
 	drivewire_init();
+	/* Flush the write behind on the way out */
+	atexit(drivewire_shutdown);
 	if (wirepath)
 		drivewire_attach(0, wirepath, 0);
+	/* Running flat out there is no time to hide the host disk in, so
+	   answer each request before the guest reads the reply */
+	drivewire_set_immediate(fast);
 
 	ui_init();
 
@@ -846,8 +851,10 @@ int main(int argc, char *argv[])
 		int l;
 		for (l = 0; l < 10; l++) {
 			int i;
-			for (i = 0; i < 10; i++)
+			for (i = 0; i < 10; i++) {
 				Z80ExecuteTStates(&cpu_z80, cycles);
+				drivewire_poll();
+			}
 			ui_event();
 			/* Do a small block of I/O and delays */
 			if (!fast)
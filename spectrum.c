@@ -7,6 +7,10 @@
  *
  *  Additions:
  *   - SNA loader (48K & 128K) fixed
+ *   - .z80 (v1-v3) and .szx snapshot load (-s) and save on exit (-S)
+ *   - Headless batch regression runner (-b list, see batch_run)
+ *   - Frame capture to PNG/raw video (-c) and audio capture to WAV (-w)
+ *   - DivMMC SD card (-M) and esxDOS RST 8 file calls from a host directory (-H)
  *   - Kempston joystick on port 0x1F (arrow keys + Ctrl/Space/Enter = FIRE)
  *   - TAP fast loader: injects CODE/SCREEN$ blocks to param1 address, no EAR/timing
  *   - TAP pulse player (ROM-accurate): pilot/sync/bits/pauses on EAR input
@@ -29,7 +33,9 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <string.h>
+#include <strings.h>
 #include <fcntl.h>
 #include <signal.h>
 #include <termios.h>
@@ -38,15 +44,20 @@
 #include <sys/types.h>
 #include <sys/select.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 #include <SDL2/SDL.h>
 #include "libz80/z80.h"
 #include "z80dis.h"
 #include "ide.h"
+#include "sdcard.h"
+#include "esxhost.h"
 #include "lib765/include/765.h"
 #include "sna.h"
+#include "snapshot.h"
 #include "event.h"
 #include "keymatrix.h"
 #include "ay8912.h"
+#include "capture.h"
 
 static SDL_Window *window;
 static SDL_Renderer *render;
@@ -1260,6 +1271,10 @@ static unsigned divide_mapped; /* 0 no, 1 yes */
 static unsigned divide_oe;
 static unsigned divide_pair;   /* Latches other half of wordstream for IDE */
 static unsigned divide;
+static unsigned divmmc;        /* DivIDE paging with an SD card on SPI */
+static uint8_t divmmc_spi;     /* Byte clocked in by the last transfer */
+static struct sdcard *sdcard;
+static struct esxhost *esx;    /* Host directory for esxDOS calls */
 
 static uint8_t divplus_latch;
 static unsigned divplus_128k = 1;
@@ -1273,6 +1288,29 @@ static unsigned model = ZX_48K_3;
 
 static volatile int emulator_done;
 static unsigned fast;
+
+/* Batch mode: the title this (forked) process boots headless */
+static const char *batch_title;
+static int batch_fd = -1;           /* Pipe back to the batch parent */
+static unsigned batch_frames = 500; /* 10 emulated seconds */
+static unsigned batch_frame;        /* Frames run so far */
+static unsigned batch_typing;       /* Type LOAD "" or pick the loader */
+static const char *batch_tape;      /* Tape to start once that is typed */
+static uint64_t batch_audio;        /* Hash of all audio generated */
+static uint64_t batch_loader;       /* Picture once the Loader is up */
+
+#define FNV_OFFSET  0xCBF29CE484222325ULL
+#define FNV_PRIME   0x100000001B3ULL
+
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    while (len--) {
+        h ^= *p++;
+        h *= FNV_PRIME;
+    }
+    return h;
+}
 //static unsigned int_recalc;
 /* static unsigned live_irq; */
 
@@ -1282,6 +1320,8 @@ static unsigned fast;
 #define TRACE_KEY   8
 #define TRACE_CPU   16
 #define TRACE_FDC   32
+#define TRACE_SD    64
+#define TRACE_ESX   128
 
 static int trace = 0;
 
@@ -1310,6 +1350,10 @@ static double   beeper_frac_acc     = 0.0;
 /* AY-3-8912 PSG (128K/+3 only; NULL on 48K). */
 static ay8912_t *ay = NULL;
 
+/* Frame and audio capture (-c / -w) */
+static struct capture *cap;
+static struct wavfile *wav;
+
 static int audio_init_sdl(int rate)
 {
     SDL_AudioSpec want;
@@ -1331,7 +1375,7 @@ static int audio_init_sdl(int rate)
 
 static inline void beeper_advance_to(uint64_t t_now)
 {
-    if (!audio_dev) return;
+    if (!audio_dev && !batch_title && !wav) return;
     if (t_now <= beeper_last_tstate) return;
 
     uint64_t dt = t_now - beeper_last_tstate;
@@ -1349,7 +1393,7 @@ static inline void beeper_advance_to(uint64_t t_now)
     tape_ear_level = get_current_ear_level_from_tape();
 	float tv = tape_ear_active ? (tape_ear_level ? tape_volume : -tape_volume) : 0.0f;
 
-	if (!fast)
+	if (!fast || batch_title || wav)
 	{
 			
 		enum { CHUNK = 4096 };
@@ -1357,10 +1401,11 @@ static inline void beeper_advance_to(uint64_t t_now)
 		while (nsamp > 0) {
 			int n = (nsamp > CHUNK) ? CHUNK : nsamp;
 			if (ay) {
-				/* 128K/+3: step the AY PSG once per sample and mix. */
+				/* 128K/+3: render the AY PSG for the chunk and mix. */
+				ay8912_calc_block(ay, buf, n);
 				for (int i = 0; i < n; ++i) {
 					float mixed = bv + tv +
-						(float)ay8912_calc(ay) * ay_volume / AY8912_MAX_OUTPUT;
+						(float)buf[i] * ay_volume / AY8912_MAX_OUTPUT;
 					if (mixed >  1.0f) mixed =  1.0f;
 					if (mixed < -1.0f) mixed = -1.0f;
 					buf[i] = (int16_t)(mixed * 32767.0f);
@@ -1372,7 +1417,12 @@ static inline void beeper_advance_to(uint64_t t_now)
 				int16_t val = (int16_t)(mixed * 32767.0f);
 				for (int i = 0; i < n; ++i) buf[i] = val;
 			}
-			SDL_QueueAudio(audio_dev, buf, n * (int)sizeof(int16_t));
+			if (wav)
+				wavfile_write(wav, buf, n);
+			if (batch_title)
+				batch_audio = fnv1a(batch_audio, buf, n * sizeof(int16_t));
+			else if (audio_dev && !fast)
+				SDL_QueueAudio(audio_dev, buf, n * (int)sizeof(int16_t));
 			nsamp -= n;
 		}
 	}
@@ -1436,8 +1486,18 @@ static void on_tape_ear_change(uint64_t t_abs, int new_level)
  * ───────────────────────────────────────────────────────────── */
 static inline uint8_t kempston_state_from_sdl(void)
 {
-    const Uint8 *ks = SDL_GetKeyboardState(NULL);
-    uint8_t v = 0;
+    static unsigned gen = ~0U;
+    static uint8_t v;
+    const Uint8 *ks;
+
+    if (batch_title)
+        return 0;
+    /* Keyboard state only changes when the UI has seen events */
+    if (gen == ui_generation())
+        return v;
+    gen = ui_generation();
+    ks = SDL_GetKeyboardState(NULL);
+    v = 0;
 
     if (ks[SDL_SCANCODE_RIGHT]) v |= 0x01; // Right
     if (ks[SDL_SCANCODE_LEFT])  v |= 0x02; // Left
@@ -1543,11 +1603,46 @@ static void mem_write(int unused, uint16_t addr, uint8_t val)
         ram[bank][addr & 0x3FFF] = val;
 }
 
+/*
+ * RST 8 with an esxDOS call code after it. If the host directory serves
+ * the call, step the stacked return address over the code byte and let
+ * the caller feed the CPU a RET.
+ */
+static unsigned esx_rst8(void)
+{
+    uint16_t sp = cpu_z80.R1.wr.SP;
+    uint16_t ret = do_mem_read(sp, 1) | (do_mem_read(sp + 1, 1) << 8);
+    unsigned dot = divide_mapped && ret < 0x4000;
+
+    if (!esxhost_call(esx, &cpu_z80, do_mem_read(ret, 1), dot))
+        return 0;
+    ret++;
+    mem_write(0, sp, ret);
+    mem_write(0, sp + 1, ret >> 8);
+    return 1;
+}
+
+static uint8_t esx_mem_read(uint16_t addr)
+{
+    return do_mem_read(addr, 1);
+}
+
+static void esx_mem_write(uint16_t addr, uint8_t val)
+{
+    mem_write(0, addr, val);
+}
+
 static uint8_t mem_read(int unused, uint16_t addr)
 {
     static uint8_t rstate;
     uint8_t r;
 
+    /* Served from the host: no DivIDE trap, execute a RET */
+    if (esx && addr == 0x0008 && cpu_z80.M1 && esx_rst8()) {
+        rstate = 0;
+        return 0xC9;
+    }
+
     /* DivIDE+ modes other than 00 don't autopage */
     if (cpu_z80.M1 && !(divplus_latch & 0xC0)) {
         /* Immediate map */
@@ -1851,6 +1946,61 @@ static void ula_write(uint8_t v)
     border_color = v & 7;
 }
 
+/*
+ *  Batch mode typing for tape and disk titles: LOAD "" on the 48K, or
+ *  ENTER on the first menu entry (Tape Loader / Loader) on the 128K/+3.
+ *  Keys are row << 3 | column in the keyboard[] matrix, 0xFF for none,
+ *  and each step is held for 5 frames then released for 10 so the ROM
+ *  sees a repeated key as a new press.
+ */
+#define BATCH_KEY(r, c)     ((r) << 3 | (c))
+#define BATCH_TYPE_AT       150     /* Boot time before typing */
+#define BATCH_STEP          15
+#define BATCH_SETTLE        10      /* Loader screen up, disk not read yet */
+
+static const uint8_t batch_keys_48k[][2] = {
+    { BATCH_KEY(6, 3), 0xFF },              /* J: LOAD */
+    { BATCH_KEY(7, 1), BATCH_KEY(5, 0) },   /* Symbol shift P: " */
+    { BATCH_KEY(7, 1), BATCH_KEY(5, 0) },
+    { BATCH_KEY(6, 0), 0xFF }               /* Enter */
+};
+
+static const uint8_t batch_keys_128k[][2] = {
+    { BATCH_KEY(6, 0), 0xFF }
+};
+
+static unsigned batch_script(const uint8_t (**keys)[2])
+{
+    if (is_48k_model()) {
+        *keys = batch_keys_48k;
+        return sizeof(batch_keys_48k) / sizeof(batch_keys_48k[0]);
+    }
+    *keys = batch_keys_128k;
+    return sizeof(batch_keys_128k) / sizeof(batch_keys_128k[0]);
+}
+
+static uint8_t batch_keys(uint8_t rows)
+{
+    const uint8_t (*keys)[2];
+    unsigned steps = batch_script(&keys);
+    unsigned step, i;
+    uint8_t r = 0;
+
+    if (!batch_typing || batch_frame < BATCH_TYPE_AT)
+        return 0;
+    if ((batch_frame - BATCH_TYPE_AT) % BATCH_STEP >= 5)
+        return 0;
+    step = (batch_frame - BATCH_TYPE_AT) / BATCH_STEP;
+    if (step >= steps)
+        return 0;
+    for (i = 0; i < 2; i++) {
+        uint8_t k = keys[step][i];
+        if (k != 0xFF && (rows & (1 << (k >> 3))))
+            r |= 1 << (k & 7);
+    }
+    return r;
+}
+
 static uint8_t ula_read(uint16_t addr)
 {
     uint8_t r = 0xA0;  /* Fixed bits */
@@ -1866,7 +2016,7 @@ static uint8_t ula_read(uint16_t addr)
 	r = (r & ~0x40) | ear_b6;
 
     /* Low 5 bits are keyboard matrix map */
-    r |= ~keymatrix_input(matrix, ~(addr >> 8)) & 0x1F;
+    r |= ~(keymatrix_input(matrix, ~(addr >> 8)) | batch_keys(~(addr >> 8))) & 0x1F;
     return r;
 }
 
@@ -1947,7 +2097,13 @@ static uint8_t io_read(int unused, uint16_t addr)
         if ((addr & 0xF002) == 0x3000)
             return fdc_read_data(fdc);
     }
-    if (divide) {
+    if (divmmc && (addr & 0xFF) == 0xEB) {
+        /* Reading returns the last byte and clocks the next one in */
+        r = divmmc_spi;
+        divmmc_spi = sd_spi_in(sdcard, 0xFF);
+        return r;
+    }
+    if (divide && !divmmc) {
         if ((addr & 0xE3) == 0xA3) {
             r = (addr >> 2) & 0x07;
             if (r) {
@@ -2013,7 +2169,18 @@ static void io_write(int unused, uint16_t addr, uint8_t val)
             ay8912_write_data(ay, val);
         }
     }
-    if (divide) {
+    if (divmmc) {
+        /* Only card 0 (bit 0, active low) is fitted */
+        if ((addr & 0xFF) == 0xE7) {
+            if (val & 1)
+                sd_spi_raise_cs(sdcard);
+            else
+                sd_spi_lower_cs(sdcard);
+        }
+        if ((addr & 0xFF) == 0xEB)
+            divmmc_spi = sd_spi_in(sdcard, val);
+    }
+    if (divide && !divmmc) {
         if ((addr & 0xE3) == 0xA3) {
             uint8_t r = (addr >> 2) & 0x07;
             if (r) {
@@ -2027,7 +2194,10 @@ static void io_write(int unused, uint16_t addr, uint8_t val)
                 divide_oe = 0;
             }
         }
-        if ((addr & 0xE3) == 0xE3) {
+    }
+    if (divide) {
+        /* DivMMC decodes the control port fully, E7 and EB are the SD */
+        if ((addr & 0xE3) == 0xE3 && (!divmmc || (addr & 0xFF) == 0xE3)) {
             /* MAPRAM cannot be cleared */
             val |= divide_latch & 0x40;
             divide_latch = val;
@@ -2191,7 +2361,7 @@ static void run_scanlines(unsigned lines, unsigned blank) {
         if (!blanked)
             drawline++;
     }
-    if (ui_event())
+    if (!batch_title && ui_event())
         emulator_done = 1;
 #if 0
 	if (int_recalc) {
@@ -2214,7 +2384,12 @@ static void run_scanlines(unsigned lines, unsigned blank) {
  *                F8 = Play/Pause tape pulses; F9 = Rewind tape
  * ───────────────────────────────────────────────────────────── */
 static void handle_hotkeys() {
-    SDL_PumpEvents();
+    static unsigned gen = ~0U;
+    /* ui_event() does the pumping: nothing can have changed unless it
+       saw some events */
+    if (gen == ui_generation())
+        return;
+    gen = ui_generation();
     const Uint8* ks = SDL_GetKeyboardState(NULL);
     static int prev_f6 = 0, prev_f7 = 0, prev_f8 = 0, prev_f9 = 0, prev_f12 = 0;
     int f6 = ks[SDL_SCANCODE_F6] ? 1 : 0;
@@ -2255,11 +2430,261 @@ static void handle_hotkeys() {
     prev_f6 = f6; prev_f7 = f7; prev_f8 = f8; prev_f9 = f9; prev_f12 = f12;
 }
 
+/* ─────────────────────────────────────────────────────────────
+ * Batch regression runner (-b list)
+ *
+ * Each title in the list (one path per line, # comments) is booted
+ * headless in its own forked process for -n emulated seconds at full
+ * speed. The child hashes the final framebuffer, the border colour and
+ * the whole audio stream and sends one line back down a pipe. The
+ * parent runs up to -j children at once, writes the report in list
+ * order to -o (or stdout) and compares it with a golden report from an
+ * earlier run (-g). Exit status is non-zero if any title failed to load
+ * or differs from the golden report.
+ * ───────────────────────────────────────────────────────────── */
+
+#define BATCH_NOBOOT    2   /* Child exit status for a disk that didn't boot */
+
+struct batch_job {
+    char *title;
+    pid_t pid;
+    int fd;
+    char result[64];
+};
+
+static bool batch_ext(const char *path, const char *ext)
+{
+    size_t n = strlen(path);
+    size_t e = strlen(ext);
+    return n > e && strcasecmp(path + n - e, ext) == 0;
+}
+
+/*
+ *  A disk with no boot sector or DISK file makes the +3 Loader fall back
+ *  to the tape, where the 48K ROM then sits in LD-BYTES waiting for an
+ *  edge that never comes.
+ */
+static bool batch_in_tape_loader(void)
+{
+    return model == ZX_PLUS3 && map[0] == ROM(3) &&
+           cpu_z80.PC >= 0x0556 && cpu_z80.PC < 0x0605;
+}
+
+/* Hash of the picture inside the border */
+static uint64_t batch_paper_hash(void)
+{
+    uint64_t h = FNV_OFFSET;
+    unsigned y;
+
+    for (y = BORDER; y < BORDER + 192; y++)
+        h = fnv1a(h, texturebits + y * WIDTH + BORDER, 256 * sizeof(uint32_t));
+    return h;
+}
+
+/* Called by the child at the end of the run */
+static void batch_report(void)
+{
+    char buf[64];
+    int n;
+
+    /* A disk that fell back to the tape, or never drew anything over the
+       Loader screen, didn't boot. That is a failure, not a result to
+       compare */
+    if (batch_ext(batch_title, ".dsk") &&
+        (batch_in_tape_loader() || batch_paper_hash() == batch_loader))
+        exit(BATCH_NOBOOT);
+    n = snprintf(buf, sizeof(buf), "%016llx %u %016llx",
+                 (unsigned long long)fnv1a(FNV_OFFSET, texturebits, sizeof(texturebits)),
+                 border_color, (unsigned long long)batch_audio);
+    if (write(batch_fd, buf, n) != n)
+        exit(1);
+    exit(0);
+}
+
+/*
+ *  End of a batch frame. Tapes are only started once the typing is done
+ *  so the ROM catches the start of the first pilot tone.
+ */
+static void batch_end_frame(void)
+{
+    const uint8_t (*keys)[2];
+
+    batch_frame++;
+    if (batch_frame == BATCH_TYPE_AT + BATCH_STEP * batch_script(&keys) + BATCH_SETTLE)
+        batch_loader = batch_paper_hash();
+    if (batch_tape && batch_frame == BATCH_TYPE_AT + BATCH_STEP * batch_script(&keys)) {
+        if (batch_ext(batch_tape, ".tzx")) {
+            if (!load_tzx(batch_tape))
+                exit(1);
+            tape.playing = true;
+        } else if (!load_tap(batch_tape))
+            exit(1);
+    }
+    if (batch_frame == batch_frames)
+        batch_report();
+}
+
+static char **batch_read_list(const char *path, unsigned *np)
+{
+    FILE *f = fopen(path, "r");
+    char **list = NULL;
+    char line[1024];
+    unsigned n = 0;
+
+    if (f == NULL) {
+        perror(path);
+        exit(1);
+    }
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = 0;
+        if (*line == 0 || *line == '#')
+            continue;
+        list = realloc(list, (n + 1) * sizeof(char *));
+        if (list == NULL || (list[n] = strdup(line)) == NULL) {
+            fprintf(stderr, "spectrum: out of memory.\n");
+            exit(1);
+        }
+        n++;
+    }
+    fclose(f);
+    *np = n;
+    return list;
+}
+
+/* Golden report lines are "frame border audio title" */
+static const char *batch_golden(char **golden, unsigned ngolden, const char *title)
+{
+    unsigned i;
+    for (i = 0; i < ngolden; i++) {
+        char *p = golden[i];
+        unsigned f = 0;
+        while (*p && f < 3)
+            if (*p++ == ' ')
+                f++;
+        if (f == 3 && strcmp(p, title) == 0)
+            return golden[i];
+    }
+    return NULL;
+}
+
+/* Only returns in a child process, with batch_title set */
+static void batch_run(const char *listpath, unsigned jobs, const char *goldpath,
+                      const char *outpath)
+{
+    struct batch_job *job;
+    char **list, **golden = NULL;
+    unsigned n, ngolden = 0;
+    unsigned next = 0, running = 0, done = 0;
+    unsigned differ = 0, added = 0, failed = 0;
+    FILE *out = stdout;
+    unsigned i;
+
+    list = batch_read_list(listpath, &n);
+    if (goldpath)
+        golden = batch_read_list(goldpath, &ngolden);
+    job = calloc(n ? n : 1, sizeof(struct batch_job));
+    if (job == NULL) {
+        fprintf(stderr, "spectrum: out of memory.\n");
+        exit(1);
+    }
+    for (i = 0; i < n; i++) {
+        job[i].title = list[i];
+        job[i].fd = -1;
+    }
+
+    while (done < n) {
+        int status;
+        pid_t pid;
+        int r;
+
+        while (running < jobs && next < n) {
+            int p[2];
+            fflush(stdout);
+            fflush(stderr);
+            if (pipe(p) == -1 || (pid = fork()) == -1) {
+                perror("spectrum: batch");
+                exit(1);
+            }
+            if (pid == 0) {
+                close(p[0]);
+                batch_fd = p[1];
+                batch_title = job[next].title;
+                /* The loaders are chatty; keep stderr for real problems */
+                if (freopen("/dev/null", "w", stdout) == NULL)
+                    exit(1);
+                return;
+            }
+            close(p[1]);
+            job[next].pid = pid;
+            job[next].fd = p[0];
+            running++;
+            next++;
+        }
+        pid = wait(&status);
+        if (pid == -1) {
+            perror("spectrum: wait");
+            exit(1);
+        }
+        for (i = 0; i < n; i++)
+            if (job[i].pid == pid && job[i].fd != -1)
+                break;
+        if (i == n)
+            continue;
+        r = read(job[i].fd, job[i].result, sizeof(job[i].result) - 1);
+        close(job[i].fd);
+        job[i].fd = -1;
+        running--;
+        done++;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == BATCH_NOBOOT)
+            strcpy(job[i].result, "noboot - -");
+        else if (r <= 0 || !WIFEXITED(status) || WEXITSTATUS(status))
+            strcpy(job[i].result, "error - -");
+        else
+            job[i].result[r] = 0;
+    }
+
+    if (outpath) {
+        out = fopen(outpath, "w");
+        if (out == NULL) {
+            perror(outpath);
+            exit(1);
+        }
+    }
+    for (i = 0; i < n; i++) {
+        const char *g = batch_golden(golden, ngolden, job[i].title);
+        fprintf(out, "%s %s\n", job[i].result, job[i].title);
+        if (strncmp(job[i].result, "error", 5) == 0) {
+            fprintf(stderr, "FAIL  %s: did not run\n", job[i].title);
+            failed++;
+        } else if (strncmp(job[i].result, "noboot", 6) == 0) {
+            fprintf(stderr, "FAIL  %s: did not boot from disk\n", job[i].title);
+            failed++;
+        } else if (goldpath == NULL)
+            continue;
+        else if (g == NULL) {
+            fprintf(stderr, "NEW   %s\n", job[i].title);
+            added++;
+        } else if (strncmp(g, job[i].result, strlen(job[i].result)) ||
+                   g[strlen(job[i].result)] != ' ') {
+            fprintf(stderr, "DIFF  %s\n", job[i].title);
+            differ++;
+        }
+    }
+    if (out != stdout)
+        fclose(out);
+    fprintf(stderr, "spectrum: %u titles, %u failed, %u differ, %u new.\n",
+            n, failed, differ, added);
+    exit((failed || differ) ? 1 : 0);
+}
+
 static void usage(void)
 {
     fprintf(stderr, "spectrum: [-f] [-r path] [-d debug] [-A disk] [-B disk]\n"
-            "          [-i idedisk] [-I dividerom] [-t tap] [-s sna] [-T tap_pulses]\n"
-            "          [-z tzxfile]\n");
+            "          [-i idedisk] [-I dividerom] [-t tap] [-s snapshot] [-T tap_pulses]\n"
+            "          [-z tzxfile] [-S savesnapshot]\n"
+            "          [-b list [-n seconds] [-j jobs] [-g golden] [-o report]]\n"
+            "          [-c capture.png|capture.rgb] [-w capture.wav]\n"
+            "          [-M mmcimage] [-H hostdir]\n");
     exit(EXIT_FAILURE);
 }
 
@@ -2272,15 +2697,26 @@ int main(int argc, char *argv[])
     char *rompath = (char*)"spectrum.rom";
     char *divpath = (char*)"divide.rom";
     char *idepath = NULL;
+    char *mmcpath = NULL;
+    char *hostpath = NULL;
     char *tapepath = NULL;
     char *patha = NULL;
     char *pathb = NULL;
     char *snapath = NULL;
+    char *savepath = NULL;
+    sna_context_t sna_ctx;
     //char *tap_pulses_path = NULL;
     char *tzx_path = NULL;
+    char *batchpath = NULL;
+    char *goldpath = NULL;
+    char *reportpath = NULL;
+    char *cappath = NULL;
+    char *wavpath = NULL;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    long secs;
 
     /* Añadimos 't:' (tap fast), 'T:' (tap pulses) y 'z:' (TZX) */
-    while ((opt = getopt(argc, argv, "d:f:r:m:i:I:A:B:s:t:T:z:")) != -1) {
+    while ((opt = getopt(argc, argv, "d:f:r:m:i:I:M:H:A:B:s:S:t:T:z:b:n:j:g:o:c:w:")) != -1) {
         switch (opt) {
         case 'r':
             rompath = optarg;
@@ -2309,6 +2745,12 @@ int main(int argc, char *argv[])
         case 'I':
             divpath = optarg;
             break;
+        case 'M':
+            mmcpath = optarg;
+            break;
+        case 'H':
+            hostpath = optarg;
+            break;
         case 'A':
             patha = optarg;
             break;
@@ -2318,6 +2760,35 @@ int main(int argc, char *argv[])
         case 's':
             snapath = optarg;
             break;
+        case 'S':
+            savepath = optarg;
+            break;
+        case 'b':
+            batchpath = optarg;
+            break;
+        case 'n':
+            secs = atol(optarg);
+            if (secs <= 0 || secs > UINT_MAX / 50) {
+                fprintf(stderr, "spectrum: -n needs a run time in seconds.\n");
+                exit(1);
+            }
+            batch_frames = secs * 50;
+            break;
+        case 'j':
+            jobs = atoi(optarg);
+            break;
+        case 'g':
+            goldpath = optarg;
+            break;
+        case 'o':
+            reportpath = optarg;
+            break;
+        case 'c':
+            cappath = optarg;
+            break;
+        case 'w':
+            wavpath = optarg;
+            break;
         default:
             usage();
         }
@@ -2325,6 +2796,25 @@ int main(int argc, char *argv[])
     if (optind < argc)
         usage();
 
+    if (batchpath && (cappath || wavpath)) {
+        fprintf(stderr, "spectrum: capture is not supported in batch mode.\n");
+        exit(1);
+    }
+    if (batchpath) {
+        batch_run(batchpath, jobs < 1 ? 1 : jobs, goldpath, reportpath);
+        /* Child: boot this one title through the normal paths */
+        fast = 1;
+        batch_audio = FNV_OFFSET;
+        tapepath = tzx_path = snapath = patha = NULL;
+        if (batch_ext(batch_title, ".tap") || batch_ext(batch_title, ".tzx"))
+            batch_tape = batch_title;
+        else if (batch_ext(batch_title, ".dsk"))
+            patha = (char *)batch_title;
+        else
+            snapath = (char *)batch_title;
+        batch_typing = snapath == NULL;
+    }
+
     if (mem < 16 || mem > 48) {
         fprintf(stderr, "spectrum: base memory %dK is out of range.\n", mem);
         exit(1);
@@ -2371,10 +2861,10 @@ int main(int argc, char *argv[])
 
         if (pathb) {
             drive_b = fd_newdsk();
-            fd_settype(drive_a, FD_35);
-            fd_setheads(drive_a, 2);
-            fd_setcyls(drive_a, 80);
-            fdd_setfilename(drive_a, pathb);
+            fd_settype(drive_b, FD_35);
+            fd_setheads(drive_b, 2);
+            fd_setcyls(drive_b, 80);
+            fdd_setfilename(drive_b, pathb);
         } else
             drive_b = fd_new();
 
@@ -2385,42 +2875,49 @@ int main(int argc, char *argv[])
         fdc_setdrive(fdc, 1, drive_b);
     }
 
-    ui_init();
-
-    window = SDL_CreateWindow("ZX Spectrum",
-                  SDL_WINDOWPOS_UNDEFINED,
-                  SDL_WINDOWPOS_UNDEFINED,
-                  WIDTH * SCALE,
-                  HEIGHT * SCALE, SDL_WINDOW_RESIZABLE);
-    if (window == NULL) {
-        fprintf(stderr,
-            "spectrum: unable to open window: %s\n",
-            SDL_GetError());
-        exit(1);
-    }
-    render = SDL_CreateRenderer(window, -1, 0);
-    if (render == NULL) {
-        fprintf(stderr,
-            "spectrum: unable to create renderer: %s\n",
-            SDL_GetError());
+    if (batch_title && patha && model != ZX_PLUS3) {
+        fprintf(stderr, "spectrum: disks need a +3 ROM.\n");
         exit(1);
     }
-    texture =
-        SDL_CreateTexture(render,
-                  SDL_PIXELFORMAT_ARGB8888,
-                  SDL_TEXTUREACCESS_STREAMING,
-                  WIDTH, HEIGHT);
-    if (texture == NULL) {
-        fprintf(stderr,
-            "spectrum: unable to create texture: %s\n",
-            SDL_GetError());
-        exit(1);
+
+    if (batch_title == NULL) {
+        ui_init();
+
+        window = SDL_CreateWindow("ZX Spectrum",
+                      SDL_WINDOWPOS_UNDEFINED,
+                      SDL_WINDOWPOS_UNDEFINED,
+                      WIDTH * SCALE,
+                      HEIGHT * SCALE, SDL_WINDOW_RESIZABLE);
+        if (window == NULL) {
+            fprintf(stderr,
+                "spectrum: unable to open window: %s\n",
+                SDL_GetError());
+            exit(1);
+        }
+        render = SDL_CreateRenderer(window, -1, 0);
+        if (render == NULL) {
+            fprintf(stderr,
+                "spectrum: unable to create renderer: %s\n",
+                SDL_GetError());
+            exit(1);
+        }
+        texture =
+            SDL_CreateTexture(render,
+                      SDL_PIXELFORMAT_ARGB8888,
+                      SDL_TEXTUREACCESS_STREAMING,
+                      WIDTH, HEIGHT);
+        if (texture == NULL) {
+            fprintf(stderr,
+                "spectrum: unable to create texture: %s\n",
+                SDL_GetError());
+            exit(1);
+        }
+        SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+        SDL_RenderClear(render);
+        SDL_RenderPresent(render);
+        SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+        SDL_RenderSetLogicalSize(render, WIDTH, HEIGHT);
     }
-    SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
-    SDL_RenderClear(render);
-    SDL_RenderPresent(render);
-    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
-    SDL_RenderSetLogicalSize(render, WIDTH, HEIGHT);
 
     matrix = keymatrix_create(8, 5, keyboard);
     keymatrix_trace(matrix, trace & TRACE_KEY);
@@ -2436,8 +2933,8 @@ int main(int argc, char *argv[])
     cpu_z80.memWrite = mem_write;
     cpu_z80.trace = z80_trace;
 
-    /* Audio beeper */
-    if (audio_init_sdl(44100) != 0) {
+    /* Audio beeper (batch mode only hashes the samples) */
+    if (batch_title == NULL && audio_init_sdl(44100) != 0 && !wavpath) {
         fprintf(stderr, "Aviso: audio deshabilitado (SDL_OpenAudioDevice falló).\n");
     } else {
         beeper_frame_origin = 0;
@@ -2453,6 +2950,17 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (cappath) {
+        cap = capture_create(cappath, WIDTH, HEIGHT);
+        if (cap == NULL)
+            exit(1);
+    }
+    if (wavpath) {
+        wav = wavfile_create(wavpath, audio_rate, 1);
+        if (wav == NULL)
+            exit(1);
+    }
+
     if (tapepath) {
 		if (!load_tap(tapepath)) {
 			fprintf(stderr, "Fallo al cargar TAP: %s\n", tapepath);
@@ -2470,20 +2978,31 @@ int main(int argc, char *argv[])
 		tape_filename = tzx_path;
 	}
 
-    if (snapath)
-    {
-        sna_context_t sna_ctx = {
-            .cpu         = &cpu_z80,
-            .ram         = ram,
-            .border_color = &border_color,
-            .mlatch      = &mlatch,
-            .mem_write   = mem_write,
-            .mem_read    = mem_read,
-            .recalc_mmu  = recalc_mmu,
-        };
-        load_sna(snapath, &sna_ctx);
-    }
+    memset(&sna_ctx, 0, sizeof(sna_ctx));
+    sna_ctx.cpu          = &cpu_z80;
+    sna_ctx.ram          = ram;
+    sna_ctx.border_color = &border_color;
+    sna_ctx.mlatch       = &mlatch;
+    sna_ctx.mem_write    = mem_write;
+    sna_ctx.mem_read     = mem_read;
+    sna_ctx.recalc_mmu   = recalc_mmu;
+    sna_ctx.p3latch      = &p3latch;
+    sna_ctx.ula          = &ula;
+    sna_ctx.ay           = ay;
+    if (model == ZX_PLUS3)
+        sna_ctx.model = SNA_MODEL_PLUS3;
+    else if (model == ZX_128K)
+        sna_ctx.model = SNA_MODEL_128K;
+    else
+        sna_ctx.model = SNA_MODEL_48K;
+
+    if (snapath && !load_snapshot(snapath, &sna_ctx) && batch_title)
+        exit(1);
 
+    if (idepath && mmcpath) {
+        fprintf(stderr, "spectrum: -i and -M are exclusive.\n");
+        exit(1);
+    }
     if (idepath) {
         ide = ide_allocate("divide0");
         fd = open(idepath, O_RDWR);
@@ -2497,6 +3016,20 @@ int main(int argc, char *argv[])
             fprintf(stderr, "ide: attach failed.\n");
             exit(1);
         }
+    }
+    if (mmcpath) {
+        sdcard = sd_create("sd0");
+        fd = open(mmcpath, O_RDWR);
+        if (fd == -1) {
+            perror(mmcpath);
+            exit(1);
+        }
+        sd_attach(sdcard, fd);
+        if (trace & TRACE_SD)
+            sd_trace(sdcard, 1);
+        divmmc = 1;
+    }
+    if (idepath || mmcpath) {
         fd = open(divpath, O_RDONLY);
         if (fd == -1) {
             perror(divpath);
@@ -2511,12 +3044,24 @@ int main(int argc, char *argv[])
             fprintf(stderr, "spectrum: divide.rom invalid.\n");
             exit(1);
         }
+        close(fd);
+        if (divmmc && divide != 1) {
+            fprintf(stderr, "spectrum: DivMMC needs an 8K ROM.\n");
+            exit(1);
+        }
+    }
+    if (hostpath) {
+        esx = esxhost_create(hostpath, esx_mem_read, esx_mem_write);
+        if (esx == NULL)
+            exit(1);
+        esxhost_trace(esx, trace & TRACE_ESX);
     }
 
     while (!emulator_done) {
         /* Hotkeys: F6 (reload TAP & autostart), F7 (list TAP),
                     F8 (play/pause pulses), F9 (rewind pulses) */
-        handle_hotkeys();
+        if (!batch_title)
+            handle_hotkeys();
 
         /*
          * Run one full PAL frame (312 lines) with model-correct t-states/line.
@@ -2530,7 +3075,10 @@ int main(int argc, char *argv[])
         run_scanlines(192, 1);
         run_scanlines(56, 0);
         spectrum_rasterize();
-        spectrum_render();
+        if (cap)
+            capture_frame(cap, texturebits, WIDTH);
+        if (!batch_title)
+            spectrum_render();
         Z80INT(&cpu_z80, 0xFF);
         poll_irq_event();
         frames++;
@@ -2539,8 +3087,16 @@ int main(int argc, char *argv[])
             nanosleep(&tc, NULL);
         if (fdc)
             fdc_tick(fdc);
+        if (batch_title)
+            batch_end_frame();
     }
 
+    if (savepath)
+        save_snapshot(savepath, &sna_ctx);
+    capture_free(cap);
+    esxhost_free(esx);
+    wavfile_free(wav);
+
     if (audio_dev) {
         SDL_CloseAudioDevice(audio_dev);
         audio_dev = 0;
@@ -133,6 +133,16 @@ void duart_signal_change(struct duart *d, uint8_t opr)
 
 /* TODO v2 board added an RTC */
 
+/* Everything below the I/O space is RAM so the CPU can fetch
+   instructions from it directly. On RCBus only the first 2MB is, the
+   rest up to 8MB mirrors it and goes through cpu_read_*() as before. */
+static void fetch_regions(void)
+{
+	if (trace & TRACE_MEM)
+		return;
+	m68k_set_fetch_region(0, 0, rcbus ? 0x200000 : sizeof(ram), ram);
+}
+
 static unsigned int do_io_readb(unsigned int address)
 {
 	if (rcbus && address >= 0xFF8000 && address <= 0xFF8FFF)
@@ -325,6 +335,7 @@ static void device_init(void)
 	ide_reset_begin(ide);
 	duart_reset(duart);
 	duart_set_input(duart, 1);
+	fetch_regions();
 }
 
 static struct termios saved_term, term;
@@ -1,10 +1,9 @@
 /*
  *	TMS9918A emulation.
  *
- *	This could benefit from some optimization especially on the sprite side
- *	of things. There are also a lot of other optimizations that could be
- *	done to only recompute changed scan lines, although that need some
- *	trickery with sprite compositing.
+ *	There are a lot of optimizations that could be done to only recompute
+ *	changed scan lines, although that need some trickery with sprite
+ *	compositing. Sprites are bucketed by line once a frame.
  *
  *	We maintain a frame buffer and register as the real hardware sees them.
  *	Our code then rasterizes the framebuffer each frame. We don't do any
@@ -31,7 +30,9 @@ struct tms9918a {
 	uint8_t framebuffer[16384];	/* The memory behind the VDP */
 	uint32_t rasterbuffer[256 * 256]; /* Our output texture allow partially signed Y */
 	uint32_t *colourmap;
-	uint8_t colbuf[256 + 64];	/* For off edge collisions */
+	uint8_t spbucket[192][5];	/* First five sprites on each line */
+	uint8_t spcount[192];
+	uint16_t magnify[256];		/* Pattern byte with each bit doubled */
 	unsigned int latch;		/* The toggling latch for low/hi */
 	unsigned int read;		/* Mode */
 	uint16_t addr;			/* Address */
@@ -42,51 +43,57 @@ struct tms9918a {
 
 /*
  *	Sprites
+ *
+ *	Once a frame the sprite attribute table is walked and each sprite
+ *	dropped into the bucket of every line it covers, in priority order.
+ *	Only the first five on a line matter: four are shown and the fifth
+ *	sets the overflow status. Lines with an empty bucket cost nothing.
+ *	Collisions are found by AND/OR of each sprite slice against a 256
+ *	bit mask of the opaque sprite pixels already on the line.
  */
 
 /*
- *	Draw a horizontal slice of a sprite into the render buffer. If it
- *	needs magnifying then do the magnification as we render. We use a
- *	simple line buffer to detect collisions
+ *	Draw a horizontal slice of a sprite into the render buffer. The
+ *	slice arrives with the leftmost pixel in the top bit and any
+ *	magnification already applied.
  */
-static void tms9918a_render_slice(struct tms9918a *vdp, int y, uint8_t *sprat, uint16_t bits, unsigned int width)
+static void tms9918a_render_slice(struct tms9918a *vdp, int y, uint8_t *sprat, uint32_t bits, uint32_t *linemask)
 {
 	int x = sprat[1];
-	uint8_t *colptr = vdp->colbuf + 32;
 	uint32_t foreground = vdp->colourmap[sprat[3] & 0x0F];
-	int mag = vdp->reg[1] & 0x01;
-	int step = 1;
-	int i;
-	int xmax;
+	uint32_t *out;
+	uint32_t hi, lo;
+	unsigned int w, s;
+
 	if (sprat[3] & 0x80)
 		x -= 32;
-	colptr += x;
-	
-	if (mag) width <<= 1;
-	xmax = x+width;
-
-	if (xmax >= 256) xmax = 256;
-	/* Walk across the sprite doing rendering and collisions.
-	 * - Collisions offscreen are ignored
-	 * - Only opaque pixels are considered.
-	 *   NOTE: This is in direct contrast to the TMS9918A Datasheet.
-	 */
-	for (i = x; i < xmax; i++) {
-		if (i >= 0 && i <= 255) {
-			if (bits & 0x8000U) {
-				vdp->rasterbuffer[256*y+i] = foreground;
-				if (*colptr) {
-					vdp->status |= 0x20;
-				} else {
-					*colptr = 1;
-				}
-			}
-		}
-		/* For magnified sprites write each pixel twice */
-		step ^= mag;
-		if (step == 1)
-			bits <<= 1;
-		colptr ++;
+	/* Collisions and pixels off the left are ignored */
+	if (x < 0) {
+		if (x <= -32)
+			return;
+		bits <<= -x;
+		x = 0;
+	}
+	/* Only opaque pixels are considered for collisions.
+	   NOTE: This is in direct contrast to the TMS9918A Datasheet. */
+	w = x >> 5;
+	s = x & 31;
+	hi = bits >> s;
+	lo = (s && w < 7) ? bits << (32 - s) : 0;
+	if ((linemask[w] & hi) || (w < 7 && (linemask[w + 1] & lo)))
+		vdp->status |= 0x20;
+	linemask[w] |= hi;
+	if (w < 7)
+		linemask[w + 1] |= lo;
+
+	/* Anything past the right hand edge has fallen off the end of hi/lo */
+	out = vdp->rasterbuffer + 256 * y + x;
+	while (bits && x < 256) {
+		if (bits & 0x80000000U)
+			*out = foreground;
+		bits <<= 1;
+		out++;
+		x++;
 	}
 }
 
@@ -94,11 +101,10 @@ static void tms9918a_render_slice(struct tms9918a *vdp, int y, uint8_t *sprat, u
  *	Calculate the slice of a sprite to render and feed it to the actual
  *	bit renderer.
  */
-static void tms9918a_render_sprite(struct tms9918a *vdp, int y, uint8_t *sprat, uint8_t *spdat)
+static void tms9918a_render_sprite(struct tms9918a *vdp, int y, uint8_t *sprat, uint8_t *spdat, uint32_t *linemask)
 {
 	int row = *sprat;
-	uint16_t bits;
-	unsigned int width = 8;
+	uint32_t bits;
 	unsigned int mag = vdp->reg[1] & 0x01;
 
 	/* Figure out the right data row */
@@ -108,74 +114,78 @@ static void tms9918a_render_sprite(struct tms9918a *vdp, int y, uint8_t *sprat,
 	row = y - row;
 	if (mag)
 		row >>= 1;
-	/* Get the data and expand it if needed */
-	if ((vdp->reg[1] & 0x02) == 0) {
-		spdat += row;
-		width = 8;
-		bits = *spdat << 8;
-	} else {
-		spdat += row;
-		bits = *spdat << 8;
-		bits |= spdat[16];
-		width = 16;
+	/* Get the data, magnify it if needed and align it to the top bit */
+	spdat += row;
+	if (mag)
+		bits = (uint32_t)vdp->magnify[*spdat] << 16;
+	else
+		bits = (uint32_t)*spdat << 24;
+	/* 16x16 sprites have the right hand half 16 bytes on */
+	if (vdp->reg[1] & 0x02) {
+		if (mag)
+			bits |= vdp->magnify[spdat[16]];
+		else
+			bits |= spdat[16] << 16;
 	}
-	tms9918a_render_slice(vdp, y, sprat, bits, width);
+	tms9918a_render_slice(vdp, y, sprat, bits, linemask);
 }
 
 /*
- *	Composite the sprites for a given scan line
+ *	Walk the sprite attribute table and fill the line buckets
  */
-static void tms9918a_sprite_line(struct tms9918a *vdp, int y)
+static void tms9918a_sprite_buckets(struct tms9918a *vdp)
 {
-	uint8_t *sphead[4];
-	uint8_t **spqueue = sphead;
 	uint8_t *sprat = vdp->framebuffer + ((vdp->reg[5] & 0x7F) << 7);
-	uint8_t *spdat = vdp->framebuffer + ((vdp->reg[6] & 0x07) << 11);
-	int i;
-	int16_t ypos;
-	int16_t pattrow;
-
-	unsigned int spheight = vdp->reg[1]& 0x02 ? 16 : 8;
-	unsigned int mag = vdp->reg[1] & 0x01;
-	unsigned int ns = 0;
-	unsigned int spshft = 3;
+	unsigned int spheight = vdp->reg[1] & 0x02 ? 16 : 8;
+	int ypos, y, yend;
+	unsigned int i;
 
-	/* Clear the collision buffer for the line */
-	memset(vdp->colbuf, 0, sizeof(vdp->colbuf));
+	if (vdp->reg[1] & 0x01)
+		spheight <<= 1;
 
-	/* Walk the sprite table and queue any sprite on this line */
-	for(i = 0; i < 32; i++) {
+	memset(vdp->spcount, 0, sizeof(vdp->spcount));
+	for (i = 0; i < 32; i++, sprat += 4) {
+		if (*sprat == 0xD0)
+			break;
 		ypos = *sprat;
 		if (ypos > 0xE0)
 			ypos -= 256;
 		ypos += 1;
-		pattrow = y - ypos;
-
-		if (mag) pattrow >>= 1;
-
-		if (*sprat == 0xD0)
-			break;
+		y = ypos < 0 ? 0 : ypos;
+		yend = ypos + spheight;
+		if (yend > 192)
+			yend = 192;
+		for (; y < yend; y++)
+			if (vdp->spcount[y] < 5)
+				vdp->spbucket[y][vdp->spcount[y]++] = i;
+	}
+}
 
-		if (pattrow < 0 || pattrow >= spheight) {
-			sprat += 4;
-			continue;
-		}
-		ns++;
-		/* Too many sprites: only 4 get handled */
-		/* Q: do the full 32 get collision detected ? */
-		if (ns > 4) {
-			if ((vdp->status & 0x40) == 0)
-				vdp->status |= 0x40 | i;	/* Too many sprites */
-			break;
-		}
-		*spqueue++ = sprat;
-		sprat += 4;
+/*
+ *	Composite the sprites for a given scan line
+ */
+static void tms9918a_sprite_line(struct tms9918a *vdp, int y)
+{
+	uint8_t *sptab = vdp->framebuffer + ((vdp->reg[5] & 0x7F) << 7);
+	uint8_t *spdat = vdp->framebuffer + ((vdp->reg[6] & 0x07) << 11);
+	uint8_t *bucket = vdp->spbucket[y];
+	unsigned int ns = vdp->spcount[y];
+	uint32_t linemask[8];
+	uint8_t *sprat;
+
+	/* Too many sprites: only 4 get handled */
+	/* Q: do the full 32 get collision detected ? */
+	if (ns > 4) {
+		if ((vdp->status & 0x40) == 0)
+			vdp->status |= 0x40 | bucket[4];	/* Too many sprites */
+		ns = 4;
 	}
+	memset(linemask, 0, sizeof(linemask));
 	/* We need to render the ones we got in reverse order to get right
 	   pixel priority */
-	while(spqueue > sphead) {
-		sprat = *--spqueue;
-		tms9918a_render_sprite(vdp, y, sprat, spdat + (sprat[2] << spshft));
+	while (ns--) {
+		sprat = sptab + 4 * bucket[ns];
+		tms9918a_render_sprite(vdp, y, sprat, spdat + (sprat[2] << 3), linemask);
 	}
 }
 
@@ -188,8 +198,10 @@ static void tms9918a_sprite_line(struct tms9918a *vdp, int y)
 static void tms9918a_raster_sprites(struct tms9918a *vdp)
 {
 	unsigned int i;
+	tms9918a_sprite_buckets(vdp);
 	for (i = 0; i < 192; i++)
-		tms9918a_sprite_line(vdp, i);
+		if (vdp->spcount[i])
+			tms9918a_sprite_line(vdp, i);
 }
 
 /*
@@ -611,10 +623,18 @@ void tms9918a_reset(struct tms9918a *vdp)
 struct tms9918a *tms9918a_create(void)
 {
 	struct tms9918a *vdp = malloc(sizeof(struct tms9918a));
+	unsigned int i, b;
+
 	if (vdp == NULL) {
 		fprintf(stderr, "Out of memory.\n");
 		exit(1);
 	}
+	for (i = 0; i < 256; i++) {
+		vdp->magnify[i] = 0;
+		for (b = 0; b < 8; b++)
+			if (i & (1 << b))
+				vdp->magnify[i] |= 3 << (2 * b);
+	}
 	tms9918a_reset(vdp);
 	return vdp;
 }
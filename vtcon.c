@@ -0,0 +1,320 @@
+/*
+ *	Terminal emulation for a serial port. This is the dumb teletype and
+ *	VT52 state machine running into an 80x24 character grid. The grid is
+ *	shown by whichever vtcon_ui backend is linked in, or by nothing at all
+ *	in which case it can still be dumped or matched against for scripted
+ *	testing.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <regex.h>
+
+#include "serialdevice.h"
+#include "vtcon.h"
+#include "vtcon_ui.h"
+
+static struct vtcon *vt_list;
+static struct vtcon **vt_tail = &vt_list;
+static regex_t vt_regex;
+static unsigned vt_waiting;
+static unsigned vt_hit;
+
+static void vtchanged(struct vtcon *v, unsigned y, unsigned x, unsigned len)
+{
+	v->changes++;
+	vtcon_ui_changed(v->ui, y, x, len);
+}
+
+static void vtput(struct vtcon *v, uint8_t c)
+{
+	v->video[80 * v->y + v->x] = c;
+	vtchanged(v, v->y, v->x, 1);
+}
+
+static void vtscroll(struct vtcon *v)
+{
+	memmove(v->video, v->video + 80, 2048 - 80);
+	memset(v->video + 80 * 23, ' ', 80);
+	vtcon_ui_scroll(v->ui, 1);
+	vtchanged(v, 23, 0, 80);
+}
+
+static void vtbackscroll(struct vtcon *v)
+{
+	memmove(v->video + 80, v->video, 2048 - 80);
+	memset(v->video, ' ', 80);
+	vtcon_ui_scroll(v->ui, 0);
+	vtchanged(v, 0, 0, 80);
+}
+
+static void vtnewline(struct vtcon *v)
+{
+	if (v->y == 23)
+		vtscroll(v);
+	else
+		v->y++;
+}
+
+static void vtcon_put_dumb(struct serial_device *dev, uint8_t c)
+{
+	struct vtcon *v = dev->private;
+	vtcon_ui_open(v->ui);
+	if (c == 13) {
+		v->x = 0;
+		return;
+	}
+	if (c == 10) {
+		vtnewline(v);
+		return;
+	}
+	if (c == 8) {
+		if (v->x)
+			v->x--;
+		return;
+	}
+	vtput(v, c);
+	v->x++;
+	if (v->x == 80) {
+		v->x = 0;
+		vtnewline(v);
+	}
+}
+
+static void vt52_clearacross(struct vtcon *v)
+{
+	memset(v->video + 80 * v->y + v->x, ' ', 80 - v->x);
+	vtchanged(v, v->y, v->x, 80 - v->x);
+}
+
+static void vt52_cleareop(struct vtcon *v)
+{
+	memset(v->video + 80 * v->y + v->x, ' ', 80 * (24 - v->y) - v->x);
+	vtchanged(v, v->y, v->x, 80 * (24 - v->y) - v->x);
+}
+
+static void vtcon_put_vt52(struct serial_device *dev, uint8_t c)
+{
+	struct vtcon *v = dev->private;
+	vtcon_ui_open(v->ui);
+	switch(v->state) {
+	case 0:	/* Ground state */
+		if (c > 31) {
+			vtput(v, c);
+			v->x++;
+			if (v->x == 80) {
+				v->x = 0;
+				vtnewline(v);
+			}
+			return;
+		}
+		/* Control codes */
+		switch(c) {
+		case 7:	/* beep (well more gronk) */
+			break;
+		case 8:
+			if (v->x)
+				v->x--;
+			else if (v->y)
+				v->y--;
+			break;
+		case 9:
+			do {
+				vtput(v, ' ');
+				v->x++;
+				if (v->x == 80) {
+					v->x = 0;
+					vtnewline(v);
+				}
+			} while(v->x & 7);
+			break;
+		case 10:
+			vtnewline(v);
+			break;
+		case 13:
+			v->x = 0;
+			break;
+		case 0x1B:
+			v->state = 1;
+			break;
+		}
+		break;
+	case 1:	/* Escape */
+		v->state = 0;
+		switch(c) {
+			case 'A':
+				if (v->y)
+					v->y--;
+				break;
+			case 'B':
+				if (v->y < 23)
+					v->y++;
+				break;
+			case 'C':
+				if (v->x < 79)
+					v->x++;
+				break;
+			case 'D':
+				if (v->x)
+					v->x--;
+				break;
+			case 'E':
+				memset(v->video, ' ', 2048);
+				vtchanged(v, 0, 0, 80 * 24);
+				break;
+			case 'H':
+				v->x = 0;
+				v->y = 0;
+				break;
+			case 'I':
+				if (v->y)
+					v->y--;
+				else
+					vtbackscroll(v);
+				break;
+			case 'J':
+				vt52_cleareop(v);
+				break;
+			case 'K':
+				vt52_clearacross(v);
+				break;
+			case 'Y':
+				v->state = 2;
+				break;
+		}
+		break;
+	case 2:	/* Escape Y */
+		v->s1 = c;
+		v->state++;
+		break;
+	case 3:	/* Escape Y ch */
+		if (v->s1 >= ' ' && v->s1 < ' ' + 24)
+			v->y = v->s1 - ' ';
+		if (c >= ' ' && c < ' ' + 80)
+			v->x = c - ' ';
+		v->state = 0;
+		break;
+	}
+}
+
+static unsigned vtcon_ready(struct serial_device *dev)
+{
+	struct vtcon *v = dev->private;
+	return vtcon_ui_ready(v->ui);
+}
+
+static uint8_t vtcon_get(struct serial_device *dev)
+{
+	struct vtcon *v = dev->private;
+	return vtcon_ui_get(v->ui);
+}
+
+/* Copy a screen line without the trailing spaces */
+static void vtline(struct vtcon *v, unsigned y, char *buf)
+{
+	const uint8_t *p = v->video + 80 * y;
+	unsigned n = 80;
+	while (n && p[n - 1] == ' ')
+		n--;
+	memcpy(buf, p, n);
+	buf[n] = 0;
+}
+
+void vt_dump(FILE *fp)
+{
+	struct vtcon *v;
+	char buf[81];
+	unsigned y;
+
+	for (v = vt_list; v; v = v->next) {
+		fprintf(fp, "--- %s ---\n", v->name);
+		for (y = 0; y < 24; y++) {
+			vtline(v, y, buf);
+			fprintf(fp, "%s\n", buf);
+		}
+	}
+	fflush(fp);
+}
+
+/* Look for a pattern (extended regular expression) on any line of any
+   terminal. Each line is matched without its trailing spaces */
+int vt_wait_for(const char *pattern)
+{
+	struct vtcon *v;
+
+	/* Everything needs looking at again with the new pattern */
+	for (v = vt_list; v; v = v->next)
+		v->checked = v->changes - 1;
+	if (vt_waiting)
+		regfree(&vt_regex);
+	vt_waiting = 0;
+	vt_hit = 0;
+	if (regcomp(&vt_regex, pattern, REG_EXTENDED | REG_NOSUB))
+		return -1;
+	vt_waiting = 1;
+	return 0;
+}
+
+/* Cheap enough to call from the main loop: a screen is only searched
+   again when it has changed since we last looked */
+unsigned vt_matched(void)
+{
+	struct vtcon *v;
+	char buf[81];
+	unsigned y;
+
+	if (!vt_waiting || vt_hit)
+		return vt_hit;
+	for (v = vt_list; v; v = v->next) {
+		if (v->checked == v->changes)
+			continue;
+		v->checked = v->changes;
+		for (y = 0; y < 24; y++) {
+			vtline(v, y, buf);
+			if (regexec(&vt_regex, buf, 0, NULL, 0) == 0) {
+				vt_hit = 1;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+struct serial_device *vt_create(const char *name, unsigned type)
+{
+	struct vtcon *dev = malloc(sizeof(struct vtcon));
+	if (dev == NULL) {
+		fprintf(stderr, "Out of memory.\n");
+		exit(1);
+	}
+	memset(dev, 0, sizeof(struct vtcon));
+	dev->dev.private = dev;
+	dev->dev.name = "Terminal";
+	dev->dev.get = vtcon_get;
+
+	switch(type) {
+	case CON_DUMB:
+		dev->dev.put = vtcon_put_dumb;
+		/* Like a teletype the paper starts on the bottom line and
+		   scrolls up. The dumb console has always done this; it used
+		   to happen when the SDL window was first wiped and now
+		   holds with or without a display. */
+		dev->y = 23;
+		break;
+	case CON_VT52:
+		dev->dev.put = vtcon_put_vt52;
+		break;
+	}
+	dev->dev.ready = vtcon_ready;
+	memset(dev->video, ' ', sizeof(dev->video));
+	dev->name = name;
+	dev->type = type;
+	/* Nothing has been matched against yet */
+	dev->changes = 1;
+	dev->ui = vtcon_ui_create(dev);
+	*vt_tail = dev;
+	vt_tail = &dev->next;
+	return &dev->dev;
+}
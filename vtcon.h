@@ -1,4 +1,7 @@
 extern struct serial_device *vt_create(const char *name, unsigned type);
+extern void vt_dump(FILE *fp);
+extern int vt_wait_for(const char *pattern);
+extern unsigned vt_matched(void);
 
 #define CON_DUMB	0
 #define CON_VT52	1
@@ -1,5 +1,6 @@
 /*
- *	Plug console interface into a terminal
+ *	Headless terminal: the screen is kept by vtcon.c purely so it can be
+ *	dumped or matched against, and there is no keyboard.
  */
 
 #include <stdint.h>
@@ -9,28 +10,31 @@
 
 #include "serialdevice.h"
 #include "vtcon.h"
+#include "vtcon_ui.h"
 
-static unsigned vtcon_ready(struct serial_device *dev)
+struct vtcon_ui *vtcon_ui_create(struct vtcon *v)
 {
-	return 2;
+	return NULL;
 }
 
-static void vtcon_put(struct serial_device *dev, uint8_t c)
+void vtcon_ui_open(struct vtcon_ui *ui)
 {
 }
 
-static uint8_t vtcon_get(struct serial_device *dev)
+void vtcon_ui_changed(struct vtcon_ui *ui, unsigned y, unsigned x, unsigned len)
+{
+}
+
+void vtcon_ui_scroll(struct vtcon_ui *ui, unsigned up)
 {
-	return 0xFF;
 }
 
-struct serial_device *vt_create(const char *name, unsigned type)
+unsigned vtcon_ui_ready(struct vtcon_ui *ui)
 {
-	struct serial_device *dev = malloc(sizeof(struct serial_device));
-	dev->private = dev;
-	dev->name = "Terminal";
-	dev->get = vtcon_get;
-	dev->put = vtcon_put;
-	dev->ready = vtcon_ready;
-	return dev;
+	return 2;
+}
+
+uint8_t vtcon_ui_get(struct vtcon_ui *ui)
+{
+	return 0xFF;
 }
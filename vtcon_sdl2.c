@@ -1,5 +1,5 @@
 /*
- *	Plug console interface into a terminal
+ *	SDL2 display for the terminal in vtcon.c
  */
 
 #include <stdint.h>
@@ -15,31 +15,54 @@
 #include "event.h"
 #include "asciikbd.h"
 #include "vtcon.h"
+#include "vtcon_ui.h"
 
 #define CWIDTH	8
 #define CHEIGHT 16
 
-struct vtcon {
-	struct serial_device dev;
+struct vtcon_ui {
+	struct vtcon *vt;
 	struct asciikbd *kbd;
-	unsigned type;
-	uint8_t video[2048];
-	unsigned state;
-	uint8_t s1, s2;
-	unsigned y, x;
 	SDL_Window *window;
 	SDL_Renderer *render;
 	SDL_Texture *texture;
 	uint32_t bitmap[80 * CWIDTH * 24 * CHEIGHT];
-	const char *name;
+	/* Cells whose bitmap no longer matches video[] */
+	uint8_t dirty[80 * 24];
+	/* Rows of the bitmap that need uploading (none if lo > hi) */
+	unsigned dirty_lo, dirty_hi;
+	/* Where the cursor was last drawn into the bitmap */
+	unsigned cy, cx;
+	SDL_TimerID timer;
+	SDL_atomic_t pending;
 };
 
-/* FIXME: We should have some kind of ui_event timer chain for this ! */
+/* Presentation is driven off an SDL timer that posts this event into the
+   normal ui_event stream, so we draw at most once per display refresh */
+static Uint32 vt_event = (Uint32)-1;
+
+static void vtdirty_rows(struct vtcon_ui *ui, unsigned top, unsigned bottom)
+{
+	if (top < ui->dirty_lo)
+		ui->dirty_lo = top;
+	if (bottom > ui->dirty_hi)
+		ui->dirty_hi = bottom;
+}
+
+static void vtdirty(struct vtcon_ui *ui, unsigned y, unsigned x, unsigned len)
+{
+	unsigned pos = 80 * y + x;
+	if (len == 0)
+		return;
+	memset(ui->dirty + pos, 1, len);
+	vtdirty_rows(ui, y, (pos + len - 1) / 80);
+}
 
-static void vtchar(struct vtcon *v, unsigned y, unsigned x, uint8_t c)
+static void vtchar(struct vtcon_ui *ui, unsigned y, unsigned x, uint8_t c)
 {
+	struct vtcon *v = ui->vt;
 	const uint8_t *fp = vtfont + 8 * c;	/* We make a 16 pixel char from 8 */
-	uint32_t *pixp = v->bitmap + x * CWIDTH + 80 * y * CHEIGHT * CWIDTH;
+	uint32_t *pixp = ui->bitmap + x * CWIDTH + 80 * y * CHEIGHT * CWIDTH;
 	unsigned rows, pixels;
 
 	for (rows = 0; rows < CHEIGHT / 2; rows ++) {
@@ -71,7 +94,7 @@ static void vtchar(struct vtcon *v, unsigned y, unsigned x, uint8_t c)
 	}
 }
 
-static void vtrender(struct vtcon *v)
+static void vtrender(struct vtcon_ui *ui)
 {
 	SDL_Rect rect;
 
@@ -79,128 +102,161 @@ static void vtrender(struct vtcon *v)
 	rect.w = 80 * CWIDTH;
 	rect.h = 24 * CHEIGHT;
 
-	SDL_UpdateTexture(v->texture, NULL, v->bitmap, 80 * CWIDTH * 4);
-	SDL_RenderClear(v->render);
-	SDL_RenderCopy(v->render, v->texture, NULL, &rect);
-	SDL_RenderPresent(v->render);
+	SDL_UpdateTexture(ui->texture, NULL, ui->bitmap, 80 * CWIDTH * 4);
+	SDL_RenderClear(ui->render);
+	SDL_RenderCopy(ui->render, ui->texture, NULL, &rect);
+	SDL_RenderPresent(ui->render);
 }
 
-static void vtraster(struct vtcon *v)
+/* Redraw the cells that changed since the last tick and upload only the
+   rows they cover. The dumb terminal draws straight into the bitmap so only
+   needs the upload */
+static void vtupdate(struct vtcon_ui *ui)
 {
-	const uint8_t *p = v->video;
+	struct vtcon *v = ui->vt;
+	SDL_Rect rect;
 	unsigned y, x;
-	for (y = 0; y < 24; y++)
-		for (x = 0; x < 80; x++)
-			vtchar(v, y, x, *p++);
+	uint8_t *d;
+
+	if (v->type == CON_VT52 && (ui->cy != v->y || ui->cx != v->x)) {
+		if (ui->cy < 24)
+			vtdirty(ui, ui->cy, ui->cx, 1);
+		vtdirty(ui, v->y, v->x, 1);
+		ui->cy = v->y;
+		ui->cx = v->x;
+	}
+	if (ui->dirty_lo > ui->dirty_hi)
+		return;
 
-	vtrender(v);
-}
+	for (y = ui->dirty_lo; y <= ui->dirty_hi; y++) {
+		d = ui->dirty + 80 * y;
+		for (x = 0; x < 80; x++) {
+			if (d[x]) {
+				if (v->type == CON_VT52)
+					vtchar(ui, y, x, v->video[80 * y + x]);
+				d[x] = 0;
+			}
+		}
+	}
 
-/* Wipe helper for dumb console */
-static void vtwipe(struct vtcon *v)
-{
-	uint32_t *p = v->bitmap;
-	unsigned n = sizeof(v->bitmap) / sizeof(uint32_t);
-	while(n--)
-		*p++ = 0xFFB0B0B0;
-	v->x = 0;
-	v->y = 23;
-	vtrender(v);
-}
+	rect.x = 0;
+	rect.y = ui->dirty_lo * CHEIGHT;
+	rect.w = 80 * CWIDTH;
+	rect.h = (ui->dirty_hi - ui->dirty_lo + 1) * CHEIGHT;
+	SDL_UpdateTexture(ui->texture, &rect, ui->bitmap + rect.y * 80 * CWIDTH,
+		80 * CWIDTH * 4);
 
-static void vtscroll(struct vtcon *v)
-{
-	memmove(v->video, v->video + 80, 2048 - 80);
-	memset(v->video + 80 * 23, ' ', 80);
-}
+	rect.y = 0;
+	rect.h = 24 * CHEIGHT;
+	SDL_RenderClear(ui->render);
+	SDL_RenderCopy(ui->render, ui->texture, NULL, &rect);
+	SDL_RenderPresent(ui->render);
 
-static void vtbackscroll(struct vtcon *v)
-{
-	memmove(v->video + 80, v->video, 2048 - 80);
-	memset(v->video, ' ', 80);
+	ui->dirty_lo = 24;
+	ui->dirty_hi = 0;
 }
 
-static unsigned vtcon_ready(struct serial_device *dev)
+/* Wipe helper for dumb console */
+static void vtwipe(struct vtcon_ui *ui)
 {
-	struct vtcon *v = dev->private;
-	if (v->kbd && asciikbd_ready(v->kbd))
-		return 3;
-	return 2;
+	uint32_t *p = ui->bitmap;
+	unsigned n = sizeof(ui->bitmap) / sizeof(uint32_t);
+	while(n--)
+		*p++ = 0xFFB0B0B0;
+	vtrender(ui);
 }
 
 static int vtcon_refresh(void *dev, void *evp)
 {
-	struct vtcon *v = dev;
+	struct vtcon_ui *ui = dev;
 	SDL_Event *ev = evp;
 
+	if (ev->type == vt_event && ev->user.data1 == ui) {
+		SDL_AtomicSet(&ui->pending, 0);
+		vtupdate(ui);
+		return 1;
+	}
 	if (ev->type == SDL_WINDOWEVENT) {
-		if (SDL_GetWindowID(v->window) == ev->window.windowID) {
+		if (SDL_GetWindowID(ui->window) == ev->window.windowID) {
 			switch(ev->window.event) {
 				case SDL_WINDOWEVENT_SHOWN:
 				case SDL_WINDOWEVENT_SIZE_CHANGED:
-					vtrender(v);
+					vtrender(ui);
 			}
 		}
 	}
 	return 0;
 }
 
-static void vtcon_init(struct vtcon *v)
+static Uint32 vtcon_tick(Uint32 interval, void *priv)
 {
-	v->kbd = asciikbd_create();
-	v->window = SDL_CreateWindow(v->name,
+	struct vtcon_ui *ui = priv;
+	SDL_Event ev;
+
+	/* Runs on the SDL timer thread: only keep one refresh queued */
+	if (SDL_AtomicCAS(&ui->pending, 0, 1)) {
+		memset(&ev, 0, sizeof(ev));
+		ev.type = vt_event;
+		ev.user.data1 = ui;
+		SDL_PushEvent(&ev);
+	}
+	return interval;
+}
+
+void vtcon_ui_open(struct vtcon_ui *ui)
+{
+	SDL_DisplayMode mode;
+	unsigned rate = 60;
+
+	if (ui->window)
+		return;
+
+	ui->kbd = asciikbd_create();
+	ui->window = SDL_CreateWindow(ui->vt->name,
 		SDL_WINDOWPOS_UNDEFINED,
 		SDL_WINDOWPOS_UNDEFINED,
 		80 * CWIDTH, 24 * CHEIGHT,
 		SDL_WINDOW_RESIZABLE);
-	if (v->window == NULL) {
+	if (ui->window == NULL) {
 		fprintf(stderr, "vt: unable to open window: %s\n", SDL_GetError());
 		exit(1);
 	}
-	v->render = SDL_CreateRenderer(v->window, -1, 0);
-	if (v->render == NULL) {
+	ui->render = SDL_CreateRenderer(ui->window, -1, 0);
+	if (ui->render == NULL) {
 		fprintf(stderr, "vt: unable to create renderer: %s\n", SDL_GetError());
 		exit(1);
 	}
-	v->texture = SDL_CreateTexture(v->render, SDL_PIXELFORMAT_ARGB8888,
+	ui->texture = SDL_CreateTexture(ui->render, SDL_PIXELFORMAT_ARGB8888,
 			SDL_TEXTUREACCESS_STREAMING,
 			80 * CWIDTH, 24 * CHEIGHT);
-	if (v->texture == NULL) {
+	if (ui->texture == NULL) {
 		fprintf(stderr, "vt: unable to create texture: %s\n", SDL_GetError());
 		exit(1);
 	}
-	SDL_SetRenderDrawColor(v->render, 0, 0, 0, 255);
-	SDL_RenderClear(v->render);
-	SDL_RenderPresent(v->render);
-	SDL_RenderSetLogicalSize(v->render, 80 * CWIDTH, 24 * CHEIGHT);
-	asciikbd_bind(v->kbd, SDL_GetWindowID(v->window));
-	add_ui_handler(vtcon_refresh, v);
-	if (v->type == CON_DUMB) {
-		vtwipe(v);
+	SDL_SetRenderDrawColor(ui->render, 0, 0, 0, 255);
+	SDL_RenderClear(ui->render);
+	SDL_RenderPresent(ui->render);
+	SDL_RenderSetLogicalSize(ui->render, 80 * CWIDTH, 24 * CHEIGHT);
+	asciikbd_bind(ui->kbd, SDL_GetWindowID(ui->window));
+	add_ui_handler(vtcon_refresh, ui);
+	if (ui->vt->type == CON_DUMB) {
+		vtwipe(ui);
 	}
-}
-
-static void vtput(struct vtcon *v, uint8_t c)
-{
-	v->video[80 * v->y + v->x] = c;
-}
 
-/* Yes we ought to have paper holes each side and scroll slowly off multiple
-   event timer ticks */
-static void vtscroll_dumb(struct vtcon *v)
-{
-	uint32_t *p;
-	unsigned n;
-
-	/* Update the actual text map */
-	vtscroll(v);
-	/* Scrol the rastered bitmap to get the right effect */
-	memmove(v->bitmap, v->bitmap + 80 * CWIDTH * CHEIGHT,
-		23 * 80 * CWIDTH * CHEIGHT * 4);
-	p = v->bitmap + 80 * CWIDTH * CHEIGHT * 23;
-	/* Blank paper */
-	for (n = 0; n < 80 * CWIDTH * CHEIGHT; n++)
-		*p++ = 0xB0B0B0;
+	if (vt_event == (Uint32)-1) {
+		vt_event = SDL_RegisterEvents(1);
+		if (vt_event == (Uint32)-1) {
+			fprintf(stderr, "vt: unable to register event.\n");
+			exit(1);
+		}
+	}
+	if (SDL_GetWindowDisplayMode(ui->window, &mode) == 0 && mode.refresh_rate > 0)
+		rate = mode.refresh_rate;
+	ui->timer = SDL_AddTimer(1000 / rate, vtcon_tick, ui);
+	if (ui->timer == 0) {
+		fprintf(stderr, "vt: unable to add timer: %s\n", SDL_GetError());
+		exit(1);
+	}
 }
 
 static void vtdumb_darken(uint32_t *p)
@@ -224,10 +280,10 @@ static void vtdumb_darkbit(uint32_t *p)
 	*p = n;
 }
 
-static void vtchar_dumb(struct vtcon *v, uint8_t c)
+static void vtchar_dumb(struct vtcon_ui *ui, unsigned y, unsigned x, uint8_t c)
 {
 	const uint8_t *fp = printfont + 16 * c;
-	uint32_t *pixp = v->bitmap + v->x * CWIDTH + 80 * v->y * CHEIGHT * CWIDTH;
+	uint32_t *pixp = ui->bitmap + x * CWIDTH + 80 * y * CHEIGHT * CWIDTH;
 	unsigned rows, pixels;
 
 	for (rows = 0; rows < CHEIGHT; rows ++) {
@@ -235,9 +291,9 @@ static void vtchar_dumb(struct vtcon *v, uint8_t c)
 		for (pixels = 0; pixels < CWIDTH; pixels++) {
 			if (bits & 0x80) {
 				vtdumb_darken(pixp);
-				if (v->x != 0)
+				if (x != 0)
 					vtdumb_darkbit(pixp - 1);
-				if (v->x != 79)
+				if (x != 79)
 					vtdumb_darkbit(pixp + 1);
 			}
 			pixp++;
@@ -247,208 +303,83 @@ static void vtchar_dumb(struct vtcon *v, uint8_t c)
 	}
 }
 
-static void vtcon_put_dumb(struct serial_device *dev, uint8_t c)
+void vtcon_ui_changed(struct vtcon_ui *ui, unsigned y, unsigned x, unsigned len)
 {
-	struct vtcon *v = dev->private;
-	if (v->window == NULL)
-		vtcon_init(v);
-	if (c == 13) {
-		v->x = 0;
-		return;
-	}
-	if (c == 10) {
-		v->y++;
-		if (v->y == 24) {
-			vtscroll_dumb(v);
-			v->y = 23;
-		}
-		vtrender(v);
-		return;
-	}
-	if (c == 8) {
-		if (v->x)
-			v->x--;
-		return;
-	}
+	struct vtcon *v = ui->vt;
+	unsigned pos = 80 * y + x;
+	unsigned n;
 
-	vtput(v, c);
-	vtchar_dumb(v, c);
-	v->x++;
-	if (v->x == 80) {
-		v->x = 0;
-		v->y++;
-		if (v->y == 24) {
-			vtscroll_dumb(v);
-			v->y = 23;
-		}
+	/* The printer puts ink straight onto the paper. Blank lines from
+	   scrolling are just fresh paper */
+	if (v->type == CON_DUMB && ui->window) {
+		for (n = 0; n < len; n++, pos++)
+			if (v->video[pos] != ' ')
+				vtchar_dumb(ui, pos / 80, pos % 80, v->video[pos]);
 	}
-	vtrender(v);
+	vtdirty(ui, y, x, len);
 }
 
-static void vt52_clearacross(struct vtcon *v)
+/* Scroll the pending dirty cells and the rastered bitmap with the text so
+   that only the new line has to be drawn */
+void vtcon_ui_scroll(struct vtcon_ui *ui, unsigned up)
 {
-	memset(v->video + 80 * v->y + v->x, ' ', 80 - v->x);
-}
+	uint32_t *p;
+	unsigned n;
 
-static void vt52_cleareop(struct vtcon *v)
-{
-	memset(v->video + 80 * v->y + v->x, ' ', 80 - v->x);
-	if (v->y < 23)
-		memset(v->video + 80 * v->y + 1, ' ', 80 * (23 - v->y));
+	if (up) {
+		memmove(ui->dirty, ui->dirty + 80, 80 * 23);
+		memmove(ui->bitmap, ui->bitmap + 80 * CWIDTH * CHEIGHT,
+			23 * 80 * CWIDTH * CHEIGHT * 4);
+		p = ui->bitmap + 80 * CWIDTH * CHEIGHT * 23;
+		if (ui->cy < 24)
+			ui->cy = ui->cy ? ui->cy - 1 : 24;
+	} else {
+		memmove(ui->dirty + 80, ui->dirty, 80 * 23);
+		memmove(ui->bitmap + 80 * CWIDTH * CHEIGHT, ui->bitmap,
+			23 * 80 * CWIDTH * CHEIGHT * 4);
+		p = ui->bitmap;
+		if (ui->cy < 24)
+			ui->cy = ui->cy < 23 ? ui->cy + 1 : 24;
+	}
+	/* Yes we ought to have paper holes each side and scroll slowly off
+	   multiple event timer ticks */
+	if (ui->vt->type == CON_DUMB) {
+		for (n = 0; n < 80 * CWIDTH * CHEIGHT; n++)
+			*p++ = 0xFFB0B0B0;
+	}
+	vtdirty_rows(ui, 0, 23);
 }
 
-static void vtcon_put_vt52(struct serial_device *dev, uint8_t c)
+unsigned vtcon_ui_ready(struct vtcon_ui *ui)
 {
-	struct vtcon *v = dev->private;
-	if (v->window == NULL)
-		vtcon_init(v);
-	switch(v->state) {
-	case 0:	/* Ground state */
-		if (c > 31) {
-			vtput(v, c);
-			v->x++;
-			if (v->x == 80) {
-				v->x = 0;
-				if (v->y == 23)
-					vtscroll(v);
-				else
-					v->y++;
-			}
-			vtraster(v);
-			return;
-		}
-		/* Control codes */
-		switch(c) {
-		case 7:	/* beep (well more gronk) */
-			break;
-		case 8:
-			if (v->x)
-				v->x--;
-			else if (v->y)
-				v->y--;
-			break;
-		case 9:
-			do {
-				vtput(v, c);
-				v->x++;
-				if (v->x == 80) {
-					v->x = 0;
-					if (v->y == 23)
-						vtscroll(v);
-					else
-						v->y++;
-				}
-			} while(v->x & 7);
-			break;
-		case 10:
-			if (v->y == 23)
-				vtscroll(v);
-			else
-				v->y++;
-			break;
-		case 13:
-			v->x = 0;
-			break;
-		case 0x1B:
-			v->state = 1;
-			break;
-		}
-		vtraster(v);
-		break;
-	case 1:	/* Escape */
-		switch(c) {
-			case 'A':
-				if (v->y)
-					v->y--;
-				break;
-			case 'B':
-				if (v->y < 23)
-					v->y++;
-				break;
-			case 'C':
-				if (v->x < 79)
-					v->x++;
-				break;
-			case 'D':
-				if (v->x)
-					v->x--;
-				break;
-			case 'E':
-				memset(v->video, ' ', 2048);
-				break;
-			case 'H':
-				v->x = 0;
-				v->y = 0;
-				break;
-			case 'I':
-				if (v->y)
-					v->y--;
-				else {
-					vtbackscroll(v);
-					memset(v->video, ' ', 80);
-				}
-				break;
-			case 'J':
-				vt52_cleareop(v);
-				break;
-			case 'K':
-				vt52_clearacross(v);
-				break;
-			case 'Y':
-				v->state = 2;
-				break;
-			default:
-				v->state = 0;
-				return;
-		}
-		vtraster(v);
-		break;
-	case 2:	/* Escape Y */
-		v->s1 = c;
-		v->state++;
-		break;
-	case 3:	/* Escape Y ch */
-		if (v->s1 >= ' ' && v->s1 < ' ' + 24)
-			v->y = v->s1 - ' ';
-		if (c >= ' ' && c < ' ' + 80)
-			v->x = c - ' ';
-		vtraster(v);
-		break;
-	}
+	if (ui->kbd && asciikbd_ready(ui->kbd))
+		return 3;
+	return 2;
 }
 
-static uint8_t vtcon_get(struct serial_device *dev)
+uint8_t vtcon_ui_get(struct vtcon_ui *ui)
 {
-	struct vtcon *v = dev->private;
 	uint8_t r = 0xFF;
-	if (v->kbd) {
-		r = asciikbd_read(v->kbd);
-		asciikbd_ack(v->kbd);
+	if (ui->kbd) {
+		r = asciikbd_read(ui->kbd);
+		asciikbd_ack(ui->kbd);
 	}
 	return r;
 }
 
-struct serial_device *vt_create(const char *name, unsigned type)
+struct vtcon_ui *vtcon_ui_create(struct vtcon *v)
 {
-	struct vtcon *dev = malloc(sizeof(struct vtcon));
-	dev->dev.private = dev;
-	dev->dev.name = "Terminal";
-	dev->dev.get = vtcon_get;
-
-	switch(type) {
-	case CON_DUMB:
-		dev->dev.put = vtcon_put_dumb;
-		break;
-	case CON_VT52:
-		dev->dev.put = vtcon_put_vt52;
-		break;
+	struct vtcon_ui *ui = malloc(sizeof(struct vtcon_ui));
+	if (ui == NULL) {
+		fprintf(stderr, "Out of memory.\n");
+		exit(1);
 	}
-	dev->dev.ready = vtcon_ready;
-	dev->x = 0;
-	dev->y = 0;
-	memset(dev->video, ' ', sizeof(dev->video));
-	dev->window = NULL;
-	dev->name = name;
-	dev->type = type;
-	return &dev->dev;
+	memset(ui, 0, sizeof(struct vtcon_ui));
+	ui->vt = v;
+	ui->dirty_lo = 24;
+	ui->dirty_hi = 0;
+	vtdirty(ui, 0, 0, 80 * 24);
+	ui->cy = 24;
+	SDL_AtomicSet(&ui->pending, 0);
+	return ui;
 }
@@ -0,0 +1,32 @@
+/*
+ *	Interface between the terminal state machine in vtcon.c and the
+ *	display (or lack of one) that shows it.
+ */
+
+struct vtcon_ui;
+
+struct vtcon {
+	struct serial_device dev;
+	struct vtcon_ui *ui;
+	unsigned type;
+	uint8_t video[2048];
+	unsigned state;
+	uint8_t s1;
+	unsigned y, x;
+	const char *name;
+	/* Bumped on every screen change, so matching is only redone
+	   when there is something new to look at */
+	unsigned changes;
+	unsigned checked;
+	struct vtcon *next;
+};
+
+extern struct vtcon_ui *vtcon_ui_create(struct vtcon *v);
+/* Called before each byte is displayed, opens the display the first time */
+extern void vtcon_ui_open(struct vtcon_ui *ui);
+/* Cells from y,x onwards (wrapping lines) have been written */
+extern void vtcon_ui_changed(struct vtcon_ui *ui, unsigned y, unsigned x, unsigned len);
+/* The whole screen moved up (up = 1) or down (up = 0) a line */
+extern void vtcon_ui_scroll(struct vtcon_ui *ui, unsigned up);
+extern unsigned vtcon_ui_ready(struct vtcon_ui *ui);
+extern uint8_t vtcon_ui_get(struct vtcon_ui *ui);
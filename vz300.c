@@ -207,6 +207,9 @@ void mem_write(int unused, uint16_t addr, uint8_t val)
 	cpu_z80.tstates++;
 
 	if (addr >= 0x6800 && addr <= 0x6FFF) {
+		/* Mode and CSS: let the video catch up first */
+		if ((latch ^ val) & 0x18)
+			m6847_write(video, video_line, cpu_z80.tstates);
 		latch = val;
 		return;
 	}
@@ -214,6 +217,8 @@ void mem_write(int unused, uint16_t addr, uint8_t val)
 	if (p) {
 		if (trace & TRACE_MEM)
 			fprintf(stderr, "%04X <- %02X\n", addr, val);
+		if (addr >= 0x7000 && addr < 0x7800 && *p != val)
+			m6847_write(video, video_line, cpu_z80.tstates);
 		*p = val;
 	} else {
 		if (trace & TRACE_MEM)
@@ -346,6 +351,7 @@ void io_write(int unused, uint16_t addr, uint8_t val)
 	}
 	/* Australian style high resolution */
 	if (dev == 32 && hires == 1) {
+		m6847_write(video, video_line, cpu_z80.tstates);
 		vdcbank = val & 3;
 		gmbits = 0;
 		if (val & 4)
@@ -616,18 +622,16 @@ int main(int argc, char *argv[])
 	   matched with that. The scheme here works fine except when the host
 	   is loaded though */
 
-	/* For the moment these are NTSC timings. Need to add PAL machines. We
-	   don't do line by line rastering at this point. We do need to do sparkle
-	   computation eventually */
+	/* For the moment these are NTSC timings. Need to add PAL machines. The
+	   video is drawn lazily up to the beam whenever the screen or mode is
+	   changed, and the rest at the end of the frame */
 	while (!emulator_done) {
 		int i;
 		/* Roughly right - need to tweak this to get 50Hz and the
 		   right speed plus 1 wait state */
 		for (i = 0; i < 262; i++) {
-			if (i == 0) {
-				m6847_rasterize(video);
+			if (i == 0)
 				Z80INT(&cpu_z80, 0xFF);
-			}
 			video_line = i;
 			/* Keep track of the odd cycles from instructions going
 			   over the 227 */
@@ -636,6 +640,7 @@ int main(int argc, char *argv[])
 		}
 		/* We are just about to go back into blank which means we've
 		   sparklified the raster image nicely ready to draw */
+		m6847_frame(video);
 		/* We want to run UI events before we rasterize */
 		if (ui_event())
 			Z80NMI(&cpu_z80);
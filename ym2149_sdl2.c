@@ -56,15 +56,10 @@ struct ym2149 *ym2149_create(uint16_t clk)
 
 void play_buffer(void *userdata, unsigned char *stream, int len)
 {
-    static size_t total_sample_count = 0;
     Sint16 *audio_buffer = (Sint16*)stream;
     int bytes_per_sample = CHANNELS * sizeof(Sint16);
     int samples_to_write = len / bytes_per_sample;
-    for (int i=0; i<samples_to_write; i++)
-    {
-        *audio_buffer++ = PSG_calc(psg);
-        total_sample_count ++;
-    }
+    PSG_calc_block(psg, audio_buffer, samples_to_write);
 }
 
 void ym2149_write(struct ym2149 *sn, uint8_t reg, uint8_t val)
@@ -13,6 +13,7 @@
 #include <time.h>
 #include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
 #include "libz180/z180.h"
 #include "serialdevice.h"
 #include "ttycon.h"
@@ -74,39 +75,41 @@ static void sec_iow(int unit, uint16_t addr, uint8_t data)
 	}
 }
 
-/* Coprocessor memory model */
+/* Coprocessor memory model. The low half is the shared RAM window */
 static uint8_t *mdecode(struct z180copro *c, uint32_t addr, uint8_t wr)
 {
-	if (addr < 0x80000)
-		return c->shared + (addr & 0x3FF);
 	return c->ram + (addr & 0x7FFFF);
 }
 
 uint8_t z180_phys_read(int unit, uint32_t addr)
 {
 	struct z180copro *c = get_copro(unit);
-	uint8_t *p = mdecode(c, addr, 0);
+	uint8_t r;
+	if (addr < 0x80000)
+		r = c->shared[addr & 0x3FF];
+	else
+		r = *mdecode(c, addr, 0);
 	if (c->trace & TRACE_MEM)
-		fprintf(stderr, "R[%X] %06X = %02X\n", unit, addr, *p);
+		fprintf(stderr, "R[%X] %06X = %02X\n", unit, addr, r);
 	if (addr == 0x3FF)
 		c->state &= ~COPRO_IRQ_IN;
-	return *p;
+	return r;
 }
 
 void z180_phys_write(int unit, uint32_t addr, uint8_t val)
 {
 	struct z180copro *c = get_copro(unit);
-	uint8_t *p = mdecode(c, addr, 1);
-	if (p == NULL) {
-		fprintf(stderr, "C[%X] ROM write attempted %06X\n", unit,
-			addr);
-		return;
-	}
 	if (c->trace & TRACE_MEM)
 		fprintf(stderr, "W[%X] %06X <- %02X\n", unit, addr, val);
-	if (addr == 0x3FE)
-		c->state |= COPRO_IRQ_OUT;
-	*p = val;
+	if (addr < 0x80000) {
+		/* Data before the interrupt so the host never sees the
+		   interrupt ahead of the byte */
+		c->shared[addr & 0x3FF] = val;
+		if (addr == 0x3FE)
+			c->state |= COPRO_IRQ_OUT;
+		return;
+	}
+	*mdecode(c, addr, 1) = val;
 }
 
 /*
@@ -173,28 +176,110 @@ void z180copro_reset(struct z180copro *c)
 	c->cpu.ioParam = c->unit;
 	c->state = COPRO_RESET;
 	c->tstates = 37;
+	c->left = 0;
 	c->irq_pending = 0;
 }
 
 /*
- *	Briefly run the co-processor.
+ *	Run the co-processor for up to n T-states, return what is left
+ *	(zero or negative as instructions overrun)
  */
-void z180copro_run(struct z180copro *c)
+static int z180copro_execute(struct z180copro *c, int n)
 {
-	static int n = 0;
 	unsigned used;
 	/* CPU is held in reset */
 	if (c->state & COPRO_RESET)
-		return;
+		return 0;
 	if (c->state & COPRO_IRQ_IN)
 		Z180INT(&c->cpu, 0xFF);	/* Vector really not defined */
-	n += c->tstates;
 	while(n >= 0) {
 		used = z180_dma(c->io);
 		if (used == 0)
 			used = Z180Execute(&c->cpu);
 		n -= used;
 	}
+	return n;
+}
+
+/*
+ *	Threaded mode. The host grants T-states each time it would have run
+ *	the card and the thread spends them in quanta. The host never waits;
+ *	if the card falls too far behind the excess is dropped, as if the
+ *	card were clocked slower.
+ */
+
+#define COPRO_QUANTUM	2000
+#define COPRO_MAX_CREDIT	100000
+
+static void *z180copro_thread(void *arg)
+{
+	struct z180copro *c = arg;
+	int credit, left;
+
+	while (!c->stop) {
+		credit = c->credit;
+		if (credit < COPRO_QUANTUM) {
+			pthread_mutex_lock(&c->lock);
+			while (c->credit < COPRO_QUANTUM && !c->stop)
+				pthread_cond_wait(&c->wake, &c->lock);
+			pthread_mutex_unlock(&c->lock);
+			continue;
+		}
+		credit = COPRO_QUANTUM;
+		left = z180copro_execute(c, credit);
+		/* Overrun is charged against the next quantum */
+		c->credit -= credit - left;
+	}
+	return NULL;
+}
+
+void z180copro_set_threaded(struct z180copro *c, int on)
+{
+	if (on == c->threaded)
+		return;
+	if (on) {
+		c->stop = 0;
+		c->credit = 0;
+		pthread_mutex_init(&c->lock, NULL);
+		pthread_cond_init(&c->wake, NULL);
+		if (pthread_create(&c->thread, NULL, z180copro_thread, c)) {
+			fprintf(stderr, "C[%X] unable to create thread.\n",
+				c->unit);
+			exit(1);
+		}
+	} else {
+		pthread_mutex_lock(&c->lock);
+		c->stop = 1;
+		pthread_cond_signal(&c->wake);
+		pthread_mutex_unlock(&c->lock);
+		pthread_join(c->thread, NULL);
+	}
+	c->threaded = on;
+}
+
+/*
+ *	Briefly run the co-processor, or in threaded mode let it run
+ */
+void z180copro_run(struct z180copro *c)
+{
+	int old;
+
+	/* CPU is held in reset */
+	if (c->state & COPRO_RESET)
+		return;
+	if (!c->threaded) {
+		c->left = z180copro_execute(c, c->left + c->tstates);
+		return;
+	}
+	if (c->credit >= COPRO_MAX_CREDIT)
+		return;
+	old = atomic_fetch_add(&c->credit, c->tstates);
+	/* Wake it once there is a quantum to run */
+	if (old < COPRO_QUANTUM && old + c->tstates >= COPRO_QUANTUM) {
+		pthread_mutex_lock(&c->lock);
+		pthread_cond_signal(&c->wake);
+		pthread_mutex_unlock(&c->lock);
+	}
 }
 
 /*
@@ -262,6 +347,7 @@ struct z180copro *z180copro_create(void)
 
 void z180copro_free(struct z180copro *c)
 {
+	z180copro_set_threaded(c, 0);
 	/* FIXME: we don't reuse slots */
 	copro[c->unit] = NULL;
 	free(c);
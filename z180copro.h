@@ -1,17 +1,30 @@
+#include <pthread.h>
+#include <stdatomic.h>
+
 struct z180copro {
 	Z180Context cpu;
 	struct z180_io *io;
 	struct sdcard *sdcard;
 	int unit;
-	uint8_t shared[1024];
+	/* The shared RAM and state are all the two sides have in common so
+	   are atomic, which lets the card run on its own thread */
+	_Atomic uint8_t shared[1024];
 	uint8_t ram[512 * 1024];
-	uint16_t state;
+	_Atomic uint16_t state;
 #define COPRO_RESET	1
 #define COPRO_IRQ_IN	2
 #define COPRO_IRQ_OUT	4
 	int tstates;
+	int left;		/* Overrun carried between runs */
 	int irq_pending;
 	int trace;
+	/* Threaded mode */
+	int threaded;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	atomic_int credit;	/* T-states granted by the host, not yet run */
+	atomic_int stop;
 };
 
 #define MAX_COPRO	4
@@ -26,3 +39,4 @@ extern struct z180copro *z180copro_create(void);
 extern void z180copro_free(struct z180copro *c);
 extern void z180copro_trace(struct z180copro *c, int onoff);
 extern void z180copro_attach_sd(struct z180copro *c, int fd);
+extern void z180copro_set_threaded(struct z180copro *c, int on);
@@ -59,6 +59,17 @@ Example:
 /* The Z280 registers. HALT is set to 1 when the CPU is halted              */
 /****************************************************************************/
 
+/* Software TLB entry, see z280ops.h */
+struct z280_tlb
+{
+	offs_t  phy;                            /* physical base of the 4K page */
+	UINT8   *host;                          /* direct host memory or NULL */
+	UINT8   flags;                          /* Z280_TLB_R/W */
+};
+
+#define Z280_TLB_R  0x01                    /* entry valid for reads */
+#define Z280_TLB_W  0x02                    /* entry valid for writes */
+
 struct z280_state
 {
 	union PAIR    PREPC,PC,SSP,USP,AF,BC,DE,HL,IX,IY;
@@ -72,6 +83,7 @@ struct z280_state
 
 	UINT8   mmur[4];                        /* MMU registers */
 	UINT16  pdr[32];						/* Page descriptor registers; user, system */
+	struct z280_tlb tlb[2][2][16];          /* TLB; system/user, data/program, 4K page */
 
 	UINT8   ctcr[3];			            /* counter timer registers */
 	UINT8   ctcsr[3];
@@ -667,6 +679,7 @@ void z280_writeio_byte(struct z280_state *cpustate, offs_t port, UINT8 data)
 	else if(cpustate->cr[Z280_IOP] == Z280_MMUIOP && (port & Z280_MMUMASK) == Z280_MMUBASE) {
 		offs_t mmuport = port & (Z280_MMURSIZE-1);
 		int i;
+		z280_mmu(cpustate);
 		switch (mmuport) {
 			case Z280_MMUMCR:
 				MMUMCR(cpustate) = ((UINT16)data<<8) | (MMUMCR(cpustate)&0xff);
@@ -987,6 +1000,7 @@ void z280_writeio_word(struct z280_state *cpustate, offs_t port, UINT16 data)
 	}
 	else if(cpustate->cr[Z280_IOP] == Z280_MMUIOP && (port & Z280_MMUMASK) == Z280_MMUBASE) {
 		offs_t mmuport = port & (Z280_MMURSIZE-1);
+		z280_mmu(cpustate);
 		switch (mmuport) {
 			case Z280_MMUMCR:
 				MMUMCR(cpustate) = data;
@@ -91,10 +91,11 @@ if ((cs)->cr[Z280_TCR]&Z280_TCR_S &&                          \
 
 /***************************************************************
  * MMU calculate the memory management lookup table
+ * The software TLB is refilled on demand so just flush it
  ***************************************************************/
 INLINE void z280_mmu(struct z280_state *cpustate)
 {
-
+	memset(cpustate->tlb, 0, sizeof(cpustate->tlb));
 }
 
 // translate separate program/data
@@ -280,13 +281,64 @@ INLINE offs_t MMU_REMAP_ADDR_DBG(struct z280_state *cpustate, offs_t addr, int p
 	return res;
 }
 
+/***************************************************************
+ * Software TLB
+ * One entry per 4K of logical space for each mode and for
+ * program/data. An entry is filled by a full MMU_REMAP_ADDR so
+ * faults and the M bit behave as before; write permission is only
+ * cached once a write has gone through (and set M).
+ ***************************************************************/
+INLINE void z280_tlb_fill(struct z280_state *cpustate, struct z280_tlb *t, offs_t addr, int program, int write)
+{
+	offs_t phy = MMU_REMAP_ADDR(cpustate,addr,program,write) & ~0xfff;
+	UINT16 te = is_user(cpustate) ? Z280_MMUMCR_UTE : Z280_MMUMCR_STE;
+
+	t->phy = phy;
+	t->host = NULL;
+	if (cpustate->ram->direct)
+		t->host = cpustate->ram->direct + (phy & cpustate->ram->direct_mask);
+	t->flags = Z280_TLB_R;
+	if (write || !(MMUMCR(cpustate) & te))
+		t->flags |= Z280_TLB_W;
+}
+
+INLINE struct z280_tlb *z280_tlb_get(struct z280_state *cpustate, offs_t addr, int program, int write)
+{
+	struct z280_tlb *t = &cpustate->tlb[is_user(cpustate) ? 1 : 0][program][(addr >> 12) & 0xf];
+	if (!(t->flags & (write ? Z280_TLB_W : Z280_TLB_R)))
+		z280_tlb_fill(cpustate, t, addr, program, write);
+	return t;
+}
+
+INLINE UINT8 z280_tlb_read(struct z280_state *cpustate, struct z280_tlb *t, offs_t addr)
+{
+	if (t->host)
+		return t->host[addr & 0xfff];
+	return cpustate->ram->read_byte(t->phy | (addr & 0xfff));
+}
+
+INLINE UINT8 z280_tlb_read_raw(struct z280_state *cpustate, struct z280_tlb *t, offs_t addr)
+{
+	if (t->host)
+		return t->host[addr & 0xfff];
+	return cpustate->ram->read_raw_byte(t->phy | (addr & 0xfff));
+}
+
+INLINE void z280_tlb_write(struct z280_state *cpustate, struct z280_tlb *t, offs_t addr, UINT8 value)
+{
+	if (t->host)
+		t->host[addr & 0xfff] = value;
+	else
+		cpustate->ram->write_byte(t->phy | (addr & 0xfff), value);
+}
+
 /***************************************************************
  * Read a byte from given memory location
  ***************************************************************/
 INLINE UINT8 RM(struct z280_state *cpustate, offs_t addr)
 {
-	offs_t phy = MMU_REMAP_ADDR(cpustate,addr,0,0);
-	return cpustate->ram->read_byte(phy);
+	struct z280_tlb *t = z280_tlb_get(cpustate,addr,0,0);
+	return z280_tlb_read(cpustate,t,addr);
 }
 
 /***************************************************************
@@ -294,8 +346,8 @@ INLINE UINT8 RM(struct z280_state *cpustate, offs_t addr)
  ***************************************************************/
 INLINE void WM(struct z280_state *cpustate, offs_t addr, UINT8 value)
 {
-	offs_t phy = MMU_REMAP_ADDR(cpustate,addr,0,1);
-	cpustate->ram->write_byte(phy,value);
+	struct z280_tlb *t = z280_tlb_get(cpustate,addr,0,1);
+	z280_tlb_write(cpustate,t,addr,value);
 }
 
 /***************************************************************
@@ -303,16 +355,19 @@ INLINE void WM(struct z280_state *cpustate, offs_t addr, UINT8 value)
  ***************************************************************/
 INLINE void RM16( struct z280_state *cpustate, offs_t addr, union PAIR *r )
 {
-	offs_t phy = MMU_REMAP_ADDR(cpustate,addr,0,0);
+	struct z280_tlb *t = z280_tlb_get(cpustate,addr,0,0);
 	if (cpustate->device->m_bus16 && !(addr & 1))
 	{
-		r->w.l = cpustate->ram->read_word(phy);
+		if (t->host)
+			r->w.l = t->host[addr & 0xfff] | (t->host[(addr & 0xfff) + 1] << 8);
+		else
+			r->w.l = cpustate->ram->read_word(t->phy | (addr & 0xfff));
 	}
 	else
 	{
-		offs_t phy1 = MMU_REMAP_ADDR(cpustate,addr+1,0,0); // p.13-6, enforce ACCV on page boundary
-		r->b.l = cpustate->ram->read_byte(phy);
-		r->b.h = cpustate->ram->read_byte(phy1);
+		struct z280_tlb *t1 = z280_tlb_get(cpustate,addr+1,0,0); // p.13-6, enforce ACCV on page boundary
+		r->b.l = z280_tlb_read(cpustate,t,addr);
+		r->b.h = z280_tlb_read(cpustate,t1,addr+1);
 	}
 }
 
@@ -321,16 +376,22 @@ INLINE void RM16( struct z280_state *cpustate, offs_t addr, union PAIR *r )
  ***************************************************************/
 INLINE void WM16( struct z280_state *cpustate, offs_t addr, union PAIR *r )
 {
-	offs_t phy = MMU_REMAP_ADDR(cpustate,addr,0,1);
+	struct z280_tlb *t = z280_tlb_get(cpustate,addr,0,1);
 	if (cpustate->device->m_bus16 && !(addr & 1))
 	{
-		cpustate->ram->write_word(phy,r->w.l);
+		if (t->host)
+		{
+			t->host[addr & 0xfff] = r->b.l;
+			t->host[(addr & 0xfff) + 1] = r->b.h;
+		}
+		else
+			cpustate->ram->write_word(t->phy | (addr & 0xfff),r->w.l);
 	}
 	else
 	{
-		offs_t phy1 = MMU_REMAP_ADDR(cpustate,addr+1,0,1); // enforce ACCV on page boundary
-		cpustate->ram->write_byte(phy,r->b.l);
-		cpustate->ram->write_byte(phy1,r->b.h);
+		struct z280_tlb *t1 = z280_tlb_get(cpustate,addr+1,0,1); // enforce ACCV on page boundary
+		z280_tlb_write(cpustate,t,addr,r->b.l);
+		z280_tlb_write(cpustate,t1,addr+1,r->b.h);
 	}
 }
 
@@ -358,9 +419,9 @@ INLINE UINT8 ROP(struct z280_state *cpustate)
 {
 	// TODO word fetch if bus16
 	offs_t addr = cpustate->_PCD;
-	offs_t phy = MMU_REMAP_ADDR(cpustate,addr,1,0);
+	struct z280_tlb *t = z280_tlb_get(cpustate,addr,1,0);
 	cpustate->_PC++;
-	return cpustate->ram->read_raw_byte(phy);
+	return z280_tlb_read_raw(cpustate,t,addr);
 }
 
 /****************************************************************
@@ -373,25 +434,27 @@ INLINE UINT8 ARG(struct z280_state *cpustate)
 {
 	// TODO word fetch if bus16
 	offs_t addr = cpustate->_PCD;
-	offs_t phy = MMU_REMAP_ADDR(cpustate,addr,1,0);
+	struct z280_tlb *t = z280_tlb_get(cpustate,addr,1,0);
 	cpustate->_PC++;
-	return cpustate->ram->read_raw_byte(phy);
+	return z280_tlb_read_raw(cpustate,t,addr);
 }
 
 INLINE UINT32 ARG16(struct z280_state *cpustate)
 {
 	// TODO word fetch if bus16
 	offs_t addr = cpustate->_PCD;
-	offs_t phy = MMU_REMAP_ADDR(cpustate,addr,1,0);
+	struct z280_tlb *t = z280_tlb_get(cpustate,addr,1,0);
 	cpustate->_PC += 2;
 	if (cpustate->device->m_bus16 && !(addr & 1))
 	{
-		return cpustate->ram->read_raw_word(phy);
+		if (t->host)
+			return t->host[addr & 0xfff] | ((UINT32)t->host[(addr & 0xfff) + 1] << 8);
+		return cpustate->ram->read_raw_word(t->phy | (addr & 0xfff));
 	}
 	else
 	{
-		offs_t phy1 = MMU_REMAP_ADDR(cpustate,addr+1,1,0);
-		return cpustate->ram->read_raw_byte(phy)|((UINT32)cpustate->ram->read_raw_byte(phy1)<<8);
+		struct z280_tlb *t1 = z280_tlb_get(cpustate,addr+1,1,0);
+		return z280_tlb_read_raw(cpustate,t,addr)|((UINT32)z280_tlb_read_raw(cpustate,t1,addr+1)<<8);
 	}
 }
 
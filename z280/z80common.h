@@ -162,6 +162,11 @@ struct address_space
 	// accessor methods for reading raw data (opcodes)
 	UINT8 (*read_raw_byte)(offs_t byteaddress/*, offs_t directxor = 0*/);
 	UINT16 (*read_raw_word)(offs_t byteaddress/*, offs_t directxor = 0*/);
+
+	// optional plain RAM: if set the CPU reads and writes direct[address & direct_mask]
+	// instead of calling the methods above. direct_mask + 1 must be a multiple of 4K
+	UINT8       *direct;
+	offs_t      direct_mask;
 };
 
 #endif
@@ -386,6 +386,13 @@ int main(int argc, char *argv[])
 		tcsetattr(0, TCSADRAIN, &term);
 	}
 
+	/* RAM has no side effects unless we are tracing it (or modelling
+	   the bootstrap FIFO) so let the CPU access it directly */
+	if (!(trace & TRACE_MEM) && fifo_off) {
+		memspace.direct = ram;
+		memspace.direct_mask = sizeof(ram) - 1;
+	}
+
 	cpu = cpu_create_z280("Z280", Z280_TYPE_Z280, XTALCLK / 2, &memspace, &iospace, irq0ackcallback, NULL /*daisychain */ ,
 			      init_bti, 1 /*Z-BUS */ ,
 			      0, XTALCLK / 16, 0, z280_uart_rx, z280_uart_tx);